@@ -1,13 +1,43 @@
 #pragma once
 
+#include <chrono>
 #include <memory>
 #include <LLGL/LLGL.h>
 #include "Asset.hpp"
 #include "Stream/DataReadStream.hpp"
 #include "DAsset/Asset.hpp"
+#include "Dyngine/Rendering/Texture/TextureStreamer.hpp"
 
 namespace AssetLoader {
 
-    Asset *LoadAsset(const std::shared_ptr<LLGL::RenderSystem> &renderSystem, const std::unique_ptr<Stream::DataReadStream> &assetDataStream);
+    /**
+     * Wall times of the stages of loading an asset and the number of GPU resources it created
+     */
+    struct LoadStatistics {
+        // Reading the metadata of the asset
+        std::chrono::nanoseconds parse{};
+        // Loading the buffer payloads, in parallel
+        std::chrono::nanoseconds payloads{};
+        // Decoding the always resident mip levels and preparing the mesh parts, in parallel
+        std::chrono::nanoseconds decode{};
+        // Creating the GPU resources on the calling thread
+        std::chrono::nanoseconds create{};
+
+        size_t nMeshes = 0;
+        // Shared by all meshes with the same DAsset material
+        size_t nMaterials = 0;
+        // Shared by all materials referencing the same DAsset texture
+        size_t nTextures = 0, nSamplers = 0;
+    };
+
+    /**
+     * Loads an asset, its textures are added to the texture streamer.
+     * The asset's buffers are slices of its bytes, which stay alive while textures are streamed from them.
+     * Each stage waits for the previous one, the work within a stage is spread over all cores.
+     * Textures, samplers and materials are created once per DAsset id and shared.
+     * @param statistics receives the wall time of each stage and the number of created resources
+     */
+    Asset *LoadAsset(const std::shared_ptr<LLGL::RenderSystem> &renderSystem, TextureStreamer &textureStreamer,
+                     const DAsset::ByteSpan &assetBytes, LoadStatistics &statistics);
 
 }
\ No newline at end of file
@@ -23,4 +23,6 @@ public:
     );
 
     void render(LLGL::CommandBuffer &commandBuffer);
+
+    void requestTextureMips(TextureStreamer &textureStreamer, float viewportHeight);
 };
\ No newline at end of file
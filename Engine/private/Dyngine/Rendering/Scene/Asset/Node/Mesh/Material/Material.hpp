@@ -2,6 +2,7 @@
 
 #include <glm/glm.hpp>
 #include <LLGL/LLGL.h>
+#include "Dyngine/Rendering/Texture/TextureStreamer.hpp"
 
 struct MaterialShaderState {
     uint32_t texturePresentStates;
@@ -32,30 +33,30 @@ public:
      */
     LLGL::Buffer *texturePresentFlagsBuffer;
 
-    /// Textures
+    /// Textures, their mip levels are streamed
 
     // nullable
-    LLGL::Texture *albedoTexture;
+    std::shared_ptr<StreamedTexture> albedoTexture;
 
     // nullable
-    LLGL::Texture *normalTexture;
+    std::shared_ptr<StreamedTexture> normalTexture;
 
     /**
      * Roughness Metalness Ambient Occlusion
      */
     // nullable
-    LLGL::Texture *rmaTexture;
+    std::shared_ptr<StreamedTexture> rmaTexture;
 
-    /// Samplers
+    /// Samplers, shared by the materials using the same texture
 
     // nullable
-    LLGL::Sampler *albedoSampler;
+    std::shared_ptr<LLGL::Sampler> albedoSampler;
 
     // nullable
-    LLGL::Sampler *normalSampler;
+    std::shared_ptr<LLGL::Sampler> normalSampler;
 
     // nullable
-    LLGL::Sampler *rmaSampler;
+    std::shared_ptr<LLGL::Sampler> rmaSampler;
 
     Material(const std::shared_ptr<LLGL::RenderSystem> &renderSystem);
 
@@ -2,6 +2,7 @@
 
 #include <LLGL/LLGL.h>
 #include <optional>
+#include <glm/glm.hpp>
 #include "Dyngine/Rendering/Scene/Asset/Node/Mesh/Material/Material.hpp"
 
 enum MeshRenderMode {
@@ -28,6 +29,9 @@ public:
     LLGL::BufferArray *bufferArray;
     std::vector<LLGL::VertexFormat> vertexFormats;
     std::shared_ptr<Material> material;
+    // Bounding sphere of the vertex positions in model space, used to estimate the mesh's size on screen
+    glm::vec3 boundsCenter{};
+    float boundsRadius = 0;
 
     Mesh(MeshRenderMode meshRenderMode, std::shared_ptr<LLGL::RenderSystem> renderSystem, std::optional<uint32_t> numVertices, std::optional<uint32_t> numIndices,
          LLGL::Buffer *indexBuffer, const std::vector<LLGL::Buffer *> &buffers, LLGL::BufferArray *bufferArray,
@@ -5,6 +5,8 @@
 #include "Dyngine/Rendering/Scene/Camera/Camera.hpp"
 #include "Dyngine/Rendering/Shader/ShaderCache.hpp"
 #include "Dyngine/Rendering/Scene/Asset/AssetLoader.hpp"
+#include "Dyngine/Rendering/Texture/TextureStreamer.hpp"
+#include <array>
 
 class MeshRenderer {
 
@@ -12,10 +14,15 @@ private:
     std::shared_ptr<LLGL::RenderSystem> renderSystem;
     std::shared_ptr<ShaderCache> shaderCache;
     ShaderUsageHandle shaderUsageHandle;
+    LLGL::PipelineLayout *pipelineLayout;
     LLGL::ResourceHeap *resourceHeap;
     LLGL::PipelineState *pipeline;
+    LLGL::Buffer *cameraShaderStateBuffer;
+    LLGL::Buffer *lightsShaderStateBuffer;
     const Node &parentNode;
     std::shared_ptr<Mesh> mesh;
+    // Generations of the albedo, normal and rma texture the resource heap was created with
+    std::array<uint64_t, 3> resourceHeapTextureGenerations{};
 
 public:
     MeshRenderer(const std::shared_ptr<LLGL::RenderSystem> &renderSystem,
@@ -40,4 +47,16 @@ public:
 
     void render(LLGL::CommandBuffer &commandBuffer);
 
+    /**
+     * Requests the mip levels of the mesh's textures needed for the mesh's estimated size on screen.
+     */
+    void requestTextureMips(TextureStreamer &textureStreamer, const CameraShaderState &cameraShaderState,
+                            float viewportHeight);
+
+private:
+    /**
+     * Creates a resource heap with the current textures of the mesh's material.
+     */
+    LLGL::ResourceHeap *createResourceHeap();
+
 };
\ No newline at end of file
@@ -19,6 +19,8 @@ public:
 
     void render(LLGL::CommandBuffer &commandBuffer);
 
+    void requestTextureMips(TextureStreamer &textureStreamer, float viewportHeight);
+
     static NodeRenderer *fromNode(const std::shared_ptr<LLGL::RenderSystem> &renderSystem,
                                   LLGL::RenderTarget *renderTarget,
                                   const std::shared_ptr<ShaderCache> &shaderCache,
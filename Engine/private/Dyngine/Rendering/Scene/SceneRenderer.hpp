@@ -5,6 +5,7 @@
 #include "Dyngine/Rendering/Shader/ShaderCache.hpp"
 #include "Dyngine/Rendering/Scene/Camera/Camera.hpp"
 #include "Dyngine/Rendering/Scene/Scene.hpp"
+#include "Dyngine/Rendering/Texture/TextureStreamer.hpp"
 #include <LLGL/LLGL.h>
 
 class SceneRenderer {
@@ -17,16 +18,24 @@ private:
     LLGL::RenderTarget *renderTarget;
     std::shared_ptr<ShaderCache> shaderCache;
     std::unique_ptr<Scene> scene;
+    std::shared_ptr<TextureStreamer> textureStreamer;
 
     LightsShaderState lightsShaderState{};
     LLGL::Buffer *lightsShaderStateBuffer;
 
 public:
     SceneRenderer(const std::shared_ptr<LLGL::RenderSystem> &renderSystem, LLGL::RenderTarget *renderTarget,
-                  const std::shared_ptr<ShaderCache> &shaderCache, std::unique_ptr<Scene> scene);
+                  const std::shared_ptr<ShaderCache> &shaderCache, std::unique_ptr<Scene> scene,
+                  const std::shared_ptr<TextureStreamer> &textureStreamer);
 
     void render(LLGL::CommandBuffer &commandBuffer);
 
+    /**
+     * Requests the texture mip levels the scene needs from the current camera position and streams them in.
+     * @return whether textures changed, the scene has to be recorded again then
+     */
+    bool updateTextureStreaming(float viewportHeight);
+
 private:
     void addNewAssetRenders();
 
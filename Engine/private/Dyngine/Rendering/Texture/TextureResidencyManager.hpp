@@ -0,0 +1,131 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <vector>
+
+/**
+ * Uploads and releases the mip levels of streamed textures on the GPU.
+ */
+class ITextureStreamingBackend {
+
+public:
+    virtual ~ITextureStreamingBackend() = default;
+
+    /**
+     * Called before the resident mip levels of textures added earlier change, the levels they lose are no longer
+     * used by the GPU afterwards.
+     */
+    virtual void beginResidencyChanges() = 0;
+
+    /**
+     * Makes mip levels firstLevel to the last level of a texture resident and releases the levels above firstLevel.
+     * The released levels are freed before the new levels are uploaded.
+     */
+    virtual void setResidentMipLevels(uint64_t textureId, uint32_t firstLevel) = 0;
+
+};
+
+struct TextureStreamingSettings {
+    // Bytes of the resident mip levels of all textures, high mips are evicted to stay below it
+    uint64_t memoryBudget = 512ull * 1024 * 1024;
+    // Bytes uploaded per frame, at least one level is streamed in if any is needed.
+    // A texture is re-created with all its resident levels when it changes, so all of them count.
+    uint64_t uploadBudgetPerFrame = 16ull * 1024 * 1024;
+    // Mip levels with at most this many pixels on their longer side are uploaded when a texture is added
+    // and never evicted
+    uint32_t alwaysResidentSize = 64;
+};
+
+/**
+ * Decides which mip levels of the streamed textures are resident on the GPU.
+ * Textures start with their small, always resident mip levels. Every frame, the renderer requests the mip level
+ * each visible texture needs for its size on screen, update() then streams in the missing levels within the
+ * upload budget. When the memory budget would be exceeded, the high mips of the least recently used textures
+ * are evicted first.
+ */
+class TextureResidencyManager {
+
+private:
+    struct ResidentTexture {
+        // Bytes of each mip level on the GPU, the full size level first
+        std::vector<uint64_t> levelSizes;
+        // Lowest resident mip level index, the levels from it to the last level are resident
+        uint32_t firstResidentLevel;
+        // The levels from this one on are always resident
+        uint32_t baseLevel;
+        // Lowest mip level requested in the current frame, the number of levels if none was requested
+        uint32_t requestedLevel;
+        uint64_t lastUsedFrame;
+    };
+
+    ITextureStreamingBackend &backend;
+    TextureStreamingSettings settings;
+    std::map<uint64_t, ResidentTexture> textures{};
+    uint64_t residentBytes = 0;
+    uint64_t frame = 0;
+
+public:
+    explicit TextureResidencyManager(ITextureStreamingBackend &backend, const TextureStreamingSettings &settings = {});
+
+    /**
+     * Adds a texture and makes its always resident mip levels resident.
+     * @param textureId chosen by the caller, passed to the backend
+     * @param levelSizes the bytes of each mip level on the GPU, the full size level first
+     * @param blockSize the side of the pixel blocks the texture is stored in. The texture is re-created with its first
+     * resident level as the full size level, so only levels whose sides are multiples of it become the first level.
+     */
+    void addTexture(uint64_t textureId, uint32_t width, uint32_t height, const std::vector<uint64_t> &levelSizes,
+                    uint32_t blockSize = 1);
+
+    /**
+     * Forgets a texture, its mip levels no longer count against the memory budget.
+     * The caller releases the texture itself.
+     */
+    void removeTexture(uint64_t textureId);
+
+    /**
+     * Requests that the given mip level of a texture, and all smaller levels, are resident because the texture
+     * is drawn in the current frame.
+     */
+    void requestMipLevel(uint64_t textureId, uint32_t level);
+
+    /**
+     * Streams in and evicts mip levels according to the requests of the current frame, then starts the next frame.
+     * @return whether the resident mip levels of any texture changed
+     */
+    bool update();
+
+    [[nodiscard]] uint32_t getFirstResidentLevel(uint64_t textureId) const;
+
+    [[nodiscard]] uint64_t getResidentBytes() const;
+
+    [[nodiscard]] const TextureStreamingSettings &getSettings() const;
+
+    /**
+     * @return the first of the always resident mip levels of a texture, the levels addTexture makes resident
+     */
+    [[nodiscard]] uint32_t getBaseLevel(uint32_t width, uint32_t height, uint32_t nLevels,
+                                        uint32_t blockSize = 1) const;
+
+    /**
+     * @param screenSize the estimated size in pixels a texture covers on screen along its longer side
+     * @return the smallest mip level that still has at least one texel per pixel
+     */
+    static uint32_t GetWantedMipLevel(uint32_t width, uint32_t height, uint32_t nLevels, float screenSize);
+
+private:
+    ResidentTexture &getTexture(uint64_t textureId);
+
+    const ResidentTexture &getTexture(uint64_t textureId) const;
+
+    static uint64_t GetResidentBytes(const ResidentTexture &texture, uint32_t firstLevel);
+
+    /**
+     * Evicts the high mips of other textures until bytes more fit into the memory budget.
+     * Textures unused in the current frame lose their levels first, least recently used first,
+     * then textures used in the current frame lose the levels above the one they requested.
+     * @return whether enough memory was freed
+     */
+    bool evict(uint64_t bytes, uint64_t protectedTextureId, std::map<uint64_t, uint32_t> &changedLevels);
+};
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <map>
+#include <memory>
+#include <vector>
+#include <LLGL/LLGL.h>
+#include "DAsset/Asset.hpp"
+#include "Dyngine/Rendering/Texture/TextureResidencyManager.hpp"
+#include "Dyngine/Rendering/Texture/TextureUpload.hpp"
+
+class TextureStreamer;
+
+/**
+ * A texture whose mip levels are streamed in and evicted by a TextureStreamer.
+ * The texture is re-created whenever its resident mip levels change, renderers compare the generation to notice it.
+ */
+class StreamedTexture {
+    friend class TextureStreamer;
+
+private:
+    std::shared_ptr<LLGL::RenderSystem> renderSystem;
+    std::shared_ptr<DAsset::Texture> assetTexture;
+    uint64_t streamingId;
+    LLGL::Texture *texture = nullptr;
+    uint32_t firstResidentLevel = 0;
+    uint64_t generation = 0;
+    // Decoded ahead of adding the texture, used for its always resident levels instead of decoding them again
+    std::shared_ptr<const TextureUpload::DecodedTexture> decodedBaseLevels;
+
+public:
+    StreamedTexture(const std::shared_ptr<LLGL::RenderSystem> &renderSystem,
+                    const std::shared_ptr<DAsset::Texture> &assetTexture, uint64_t streamingId);
+
+    virtual ~StreamedTexture();
+
+    /**
+     * @return the texture containing the resident mip levels, its first level is the first resident level
+     */
+    [[nodiscard]] LLGL::Texture *getTexture() const;
+
+    /**
+     * @return a counter incremented every time the texture is re-created
+     */
+    [[nodiscard]] uint64_t getGeneration() const;
+
+    [[nodiscard]] uint32_t getFirstResidentLevel() const;
+
+    [[nodiscard]] const DAsset::Texture &getAssetTexture() const;
+};
+
+/**
+ * Uploads the mip levels of textures the TextureResidencyManager decides to make resident.
+ * LLGL textures can not be partially resident, so a texture is re-created with the resident mip levels
+ * whenever they change.
+ */
+class TextureStreamer : private ITextureStreamingBackend {
+
+private:
+    std::shared_ptr<LLGL::RenderSystem> renderSystem;
+    TextureResidencyManager residencyManager;
+    std::map<uint64_t, std::weak_ptr<StreamedTexture>> textures{};
+    uint64_t nextStreamingId = 0;
+
+public:
+    explicit TextureStreamer(const std::shared_ptr<LLGL::RenderSystem> &renderSystem,
+                             const TextureStreamingSettings &settings = {});
+
+    /**
+     * Adds a texture with only its always resident mip levels uploaded.
+     * The texture is streamed until the last reference to it is dropped.
+     * @param decodedBaseLevels the always resident levels decoded ahead, from the residency manager's base level on,
+     * or nullptr to decode them now
+     */
+    std::shared_ptr<StreamedTexture> addTexture(const std::shared_ptr<DAsset::Texture> &assetTexture,
+                                                const std::shared_ptr<const TextureUpload::DecodedTexture> &
+                                                decodedBaseLevels = nullptr);
+
+    /**
+     * Requests the mip level a texture needs in the current frame.
+     * @param screenSize the estimated size in pixels the texture covers on screen along its longer side
+     */
+    void requestScreenSize(const StreamedTexture &texture, float screenSize);
+
+    /**
+     * Streams in and evicts mip levels according to the requests of the current frame.
+     * @return whether any texture was re-created
+     */
+    bool update();
+
+    [[nodiscard]] const TextureResidencyManager &getResidencyManager() const;
+
+private:
+    void beginResidencyChanges() override;
+
+    void setResidentMipLevels(uint64_t textureId, uint32_t firstLevel) override;
+
+};
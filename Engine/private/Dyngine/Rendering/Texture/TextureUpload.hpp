@@ -0,0 +1,53 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <LLGL/LLGL.h>
+#include "DAsset/Asset.hpp"
+
+namespace TextureUpload {
+
+    /**
+     * The mip levels of a DAsset texture from firstLevel on, ready to be uploaded.
+     * PNG levels are decoded to RGBA pixels, block compressed levels point into the asset's buffers.
+     */
+    struct DecodedTexture {
+        uint32_t firstLevel = 0;
+        // The image of each mip level from firstLevel on
+        std::vector<LLGL::SrcImageDescriptor> levelImages{};
+        // The pixels of decoded PNG levels
+        std::vector<std::unique_ptr<uint8_t, void (*)(void *)>> pixels{};
+    };
+
+    /**
+     * Decodes the mip levels of a texture from firstLevel on. Needs no render system, so it may run on any thread.
+     */
+    DecodedTexture DecodeTexture(const DAsset::Texture &texture, uint32_t firstLevel);
+
+    /**
+     * Creates a texture from decoded mip levels, its size is the size of their first level.
+     * PNG textures without stored mips get their mips generated.
+     */
+    LLGL::Texture *UploadTexture(const std::shared_ptr<LLGL::RenderSystem> &renderSystem,
+                                 const DAsset::Texture &texture, const DecodedTexture &decodedTexture);
+
+    /**
+     * Creates a texture from the mip levels stored in a DAsset texture, starting at firstLevel.
+     * The texture's size is the size of firstLevel. Block compressed textures are uploaded as they are,
+     * PNG textures are decoded. PNG textures without stored mips get their mips generated.
+     */
+    LLGL::Texture *CreateTexture(const std::shared_ptr<LLGL::RenderSystem> &renderSystem,
+                                 const DAsset::Texture &texture, uint32_t firstLevel);
+
+    /**
+     * @return the bytes a mip level of a texture occupies on the GPU
+     */
+    uint64_t GetMipLevelMemorySize(const DAsset::Texture &texture, uint32_t level);
+
+    /**
+     * @return the side of the pixel blocks a texture is stored in, 1 for textures which are not block compressed.
+     * Textures created from a mip level need sides that are multiples of it, which some backends enforce.
+     */
+    uint32_t GetBlockSize(const DAsset::Texture &texture);
+
+}
@@ -72,11 +72,12 @@ void main()
 
     vec3 samplerNormal;
     if ((texturePresentStates & (1 << 1)) != 0) {
-        samplerNormal = texture(normalSampler, vTexCoord).xyz;
+        // BC5 normal maps only store x and y, z of the unit length tangent space normal is always positive
+        vec2 normalXY = texture(normalSampler, vTexCoord).xy * 2.0 - 1.0;
+        samplerNormal = vec3(normalXY, sqrt(max(1.0 - dot(normalXY, normalXY), 0.0)));
     } else {
-        samplerNormal = vec3(0.0);
+        samplerNormal = normalize(vec3(-1.0));
     }
-    samplerNormal = normalize(samplerNormal * 2.0 - 1.0);
 
     vec3 rma;
     if ((texturePresentStates & (1 << 2)) != 0){
@@ -2,6 +2,7 @@
 #include <LLGL/Strings.h>
 #include <LLGL/Utility.h>
 #include <Dpac/Dpac.hpp>
+#include <Stream/StreamStatistics.hpp>
 #include "Dyngine/Dyngine.hpp"
 #include "Dyngine/Input/Input.hpp"
 #include "Dyngine/EngineState.hpp"
@@ -13,6 +14,7 @@
 #include "Dyngine/Rendering/Scene/Asset/AssetRenderer.hpp"
 #include "Dyngine/Rendering/Scene/Scene.hpp"
 #include "Dyngine/Rendering/Scene/SceneRenderer.hpp"
+#include "Dyngine/Rendering/Texture/TextureStreamer.hpp"
 #include "Dyngine/EngineRenderContextState.hpp"
 #include "ErrorHandling/IllegalArgumentException.hpp"
 
@@ -53,15 +55,33 @@ namespace Dyngine {
         scene->addLight(Light(LightType::POINT, {0, 1, 0}, glm::vec3{1, 0, 0}, 1.0f));
         scene->addLight(Light(LightType::POINT, {1, 0, 0}, glm::vec3{1, 1, 1}, 1.0f));
 
+        auto textureStreamer = std::make_shared<TextureStreamer>(renderSystem);
+
         {
+            // The decompressed entry is kept as the asset's buffers, without copying it
+            auto assetBytes = std::move(engineResources.readEntries({"/BuddyDroid_01DMG_rig.dasset"}).at(0));
+            AssetLoader::LoadStatistics loadStatistics{};
             auto asset = std::unique_ptr<Asset>(
-                    AssetLoader::LoadAsset(renderSystem,
-                                           engineResources.getEntryStream("/BuddyDroid_01DMG_rig.dasset")));
+                    AssetLoader::LoadAsset(renderSystem, *textureStreamer, DAsset::ByteSpan(std::move(assetBytes)),
+                                           loadStatistics));
             scene->addAsset(asset);
+            auto toMilliseconds = [](std::chrono::nanoseconds duration) {
+                return std::chrono::duration<double, std::milli>(duration).count();
+            };
+            std::cout << "Asset loaded: parse " << toMilliseconds(loadStatistics.parse) << " ms, payloads "
+                      << toMilliseconds(loadStatistics.payloads) << " ms, decode "
+                      << toMilliseconds(loadStatistics.decode) << " ms, create "
+                      << toMilliseconds(loadStatistics.create) << " ms" << std::endl;
+            std::cout << "Asset resources: " << loadStatistics.nMeshes << " meshes, "
+                      << loadStatistics.nMaterials << " materials, " << loadStatistics.nTextures << " textures, "
+                      << loadStatistics.nSamplers << " samplers, "
+                      << textureStreamer->getResidencyManager().getResidentBytes() << " resident texture bytes"
+                      << std::endl;
         }
 
         engineState->sceneRenderer = std::make_unique<SceneRenderer>(renderSystem, renderContextState->renderTarget,
-                                                                     std::move(shaderCache), std::move(scene));
+                                                                     std::move(shaderCache), std::move(scene),
+                                                                     textureStreamer);
 
         // Print renderer information
         auto &renderInfo = renderSystem->GetRendererInfo();
@@ -75,6 +95,11 @@ namespace Dyngine {
         }
         std::cout << std::endl;
 
+#ifdef DYNGINE_STREAM_STATISTICS
+        // Reading the engine resources and the scene is done at this point
+        Stream::StreamStatisticsRegistry::Dump(std::cout);
+#endif
+
         auto input = std::make_unique<Input>(engineState->inputProvider);
         engineState->cameraController = std::make_unique<FlyingPerspectiveCameraController>(*engineState->camera,
                                                                                             input);
@@ -102,8 +127,12 @@ namespace Dyngine {
         auto hasChanged = engineState->camera->update();
         auto &commandBuffer = renderContextState->commandBuffer;
 
+        // Stream texture mips for the new camera position, re-created textures need the commands to be recorded again
+        auto texturesChanged = engineState->sceneRenderer->updateTextureStreaming(
+                static_cast<float>(resolution.height));
+
         // Record commands
-        if (hasChanged) {
+        if (hasChanged || texturesChanged) {
             commandBuffer->Begin();
             {
                 commandBuffer->BeginRenderPass(*renderTarget);
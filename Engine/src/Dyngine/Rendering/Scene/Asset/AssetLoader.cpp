@@ -3,11 +3,16 @@
 #include "DAsset/Asset.hpp"
 #include "ErrorHandling/IllegalArgumentException.hpp"
 #include "ErrorHandling/IllegalStateException.hpp"
+#include "Utils/ParallelJobs.hpp"
 
 #include "glm/gtx/quaternion.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
 #include <optional>
-#include <queue>
-#include "stb_image.h"
+#include <unordered_map>
+#include <unordered_set>
 
 LLGL::Format GetBufferFormat(DAsset::DataType dataType, DAsset::ComponentType componentType) {
     switch (componentType) {
@@ -142,69 +147,76 @@ uint32_t GetLocationIndex(DAsset::AttributeType type) {
     }
 }
 
-LLGL::Texture *LoadOptionalTexture(const std::shared_ptr<LLGL::RenderSystem> &renderSystem,
-                                   const std::optional<std::shared_ptr<DAsset::Texture>> &optionalTexture) {
+/**
+ * GPU resources of an asset by DAsset id, each is created once and shared by everything referencing it
+ */
+struct AssetResources {
+    // Key: texture id, value: its always resident mip levels, decoded ahead
+    std::unordered_map<uint64_t, std::shared_ptr<const TextureUpload::DecodedTexture>> decodedTextures{};
+    // Key: texture id
+    std::unordered_map<uint64_t, std::shared_ptr<StreamedTexture>> textures{};
+    // Key: texture id, the sampler of the texture
+    std::unordered_map<uint64_t, std::shared_ptr<LLGL::Sampler>> samplers{};
+    // Key: material id
+    std::unordered_map<uint64_t, std::shared_ptr<Material>> materials{};
+};
+
+std::shared_ptr<StreamedTexture> LoadOptionalTexture(TextureStreamer &textureStreamer, AssetResources &resources,
+                                                     const std::optional<std::shared_ptr<DAsset::Texture>> &optionalTexture) {
     if (!optionalTexture.has_value()) {
         return nullptr;
     }
-    auto texture = optionalTexture.value();
-    auto textureBufferView = texture->bufferView;
-    auto textureBuffer = textureBufferView.buffer;
-    auto textureBufferData = textureBuffer->data;
-    int32_t width{}, height{}, channels{};
-    auto imageData = stbi_load_from_memory(&textureBufferData[textureBufferView.byteOffset],
-                                           textureBufferView.byteLength, &width, &height, &channels, 4);
-    auto imageDataSize = width * height * 4 * sizeof(uint8_t);
-    if (!imageData) {
-        RAISE_EXCEPTION(errorhandling::IllegalArgumentException,
-                        "Cannot load texture from buffer view: " +
-                        std::string(stbi_failure_reason())
-        );
-    }
-    if (texture->width != width || texture->height != height) {
-        RAISE_EXCEPTION(errorhandling::IllegalArgumentException,
-                        "Cannot load texture from buffer view:"
-                        "Texture dimensions described in texture data do not match meta data"
-                        "MetadataDimensions: (width: " + std::to_string(texture->width) + ", height:" +
-                        std::to_string(texture->height) + ")"
-                                                          "TextureDataDimensions: (width:" + std::to_string(width) +
-                        ", height:" + std::to_string(height) + ")"
-        );
+    auto &assetTexture = optionalTexture.value();
+    auto &texture = resources.textures[assetTexture->textureId];
+    if (texture == nullptr) {
+        auto decodedTexture = resources.decodedTextures.find(assetTexture->textureId);
+        // Only the always resident mip levels are uploaded, the others are streamed in when the texture is drawn
+        texture = textureStreamer.addTexture(assetTexture, decodedTexture != resources.decodedTextures.end()
+                                                           ? decodedTexture->second : nullptr);
     }
-    if (texture->channels != channels) {
-        RAISE_EXCEPTION(errorhandling::IllegalArgumentException,
-                        "Cannot load texture from buffer view:"
-                        "Texture channels described in texture data do not match meta data"
-                        "MetadataChannels: " + std::to_string(texture->channels) +
-                        "TextureDataChannels: " + std::to_string(channels)
-        );
+    return texture;
+}
+
+struct MeshBounds {
+    glm::vec3 center;
+    float radius;
+};
+
+/**
+ * Computes a bounding sphere around the center of the positions' bounding box
+ */
+std::optional<MeshBounds> ComputeMeshBounds(const DAsset::BufferView &positionBufferView) {
+    if (positionBufferView.dataType != DAsset::DataType::FLOAT ||
+        positionBufferView.componentType != DAsset::ComponentType::VEC3) {
+        return std::nullopt;
     }
-    if (width <= 0 || height <= 0) {
-        RAISE_EXCEPTION(errorhandling::IllegalArgumentException,
-                        "Cannot load texture from buffer view: "
-                        "Metadata texture dimensions are invalid"
-        );
+    uint64_t stride = positionBufferView.byteStride != 0 ? positionBufferView.byteStride : sizeof(glm::vec3);
+    uint64_t nPositions = positionBufferView.byteLength / stride;
+    if (nPositions == 0) {
+        return std::nullopt;
     }
-
-    LLGL::SrcImageDescriptor imageDescriptor{
-            LLGL::ImageFormat::RGBA,
-            LLGL::DataType::UInt8,
-            imageData,
-            imageDataSize
-    };
-    LLGL::TextureDescriptor textureDescriptor{
-            .type = LLGL::TextureType::Texture2D,
-            .miscFlags = LLGL::MiscFlags::GenerateMips,
-            .format = LLGL::Format::RGBA8UNorm,
-            .extent = {static_cast<uint32_t>(width), static_cast<uint32_t>(height), 1},
-            .mipLevels = 0
+    auto positionAt = [&](uint64_t index) {
+        glm::vec3 position;
+        std::memcpy(&position, &positionBufferView.buffer->data[positionBufferView.byteOffset + index * stride],
+                    sizeof(glm::vec3));
+        return position;
     };
-    LLGL::Texture *llglTexture = renderSystem->CreateTexture(textureDescriptor, &imageDescriptor);
-    delete[] imageData;
-
-    return llglTexture;
+    glm::vec3 min = positionAt(0), max = min;
+    for (uint64_t index = 1; index < nPositions; index++) {
+        auto position = positionAt(index);
+        min = glm::min(min, position);
+        max = glm::max(max, position);
+    }
+    glm::vec3 center = (min + max) * 0.5f;
+    float radiusSquared = 0;
+    for (uint64_t index = 0; index < nPositions; index++) {
+        auto offset = positionAt(index) - center;
+        radiusSquared = std::max(radiusSquared, glm::dot(offset, offset));
+    }
+    return MeshBounds{center, std::sqrt(radiusSquared)};
 }
 
+
 LLGL::SamplerAddressMode GetLLGLAddressMode(DAsset::SamplerAddressMode addressMode) {
     switch (addressMode) {
         case DAsset::SamplerAddressMode::REPEAT:
@@ -239,12 +251,17 @@ LLGL::SamplerFilter GetLLGLFilter(DAsset::SamplerFilter filter) {
     }
 }
 
-LLGL::Sampler *CreateOptionalSampler(const std::shared_ptr<LLGL::RenderSystem> &renderSystem,
-                                     const std::optional<std::shared_ptr<DAsset::Texture>> &optionalTexture) {
+std::shared_ptr<LLGL::Sampler> CreateOptionalSampler(const std::shared_ptr<LLGL::RenderSystem> &renderSystem,
+                                                     AssetResources &resources,
+                                                     const std::optional<std::shared_ptr<DAsset::Texture>> &optionalTexture) {
     if (!optionalTexture.has_value()) {
         return nullptr;
     }
     auto texture = optionalTexture.value();
+    auto &sampler = resources.samplers[texture->textureId];
+    if (sampler != nullptr) {
+        return sampler;
+    }
     auto llglAddressModeU = GetLLGLAddressMode(texture->addressModeU);
     auto llglAddressModeV = GetLLGLAddressMode(texture->addressModeV);
     auto llglAddressModeW = GetLLGLAddressMode(texture->addressModeW);
@@ -262,202 +279,279 @@ LLGL::Sampler *CreateOptionalSampler(const std::shared_ptr<LLGL::RenderSystem> &
             .maxAnisotropy = 16
     };
 
-    return renderSystem->CreateSampler(samplerDescriptor);
+    // Released once the last material using it is destroyed
+    sampler = std::shared_ptr<LLGL::Sampler>(renderSystem->CreateSampler(samplerDescriptor),
+                                             [renderSystem](LLGL::Sampler *sampler) {
+                                                 renderSystem->Release(*sampler);
+                                             });
+    return sampler;
 }
 
-std::vector<std::unique_ptr<Mesh>>
-GetMeshes(const std::shared_ptr<LLGL::RenderSystem> &renderSystem, const DAsset::BufferCollection &bufferCollection,
-          const DAsset::Mesh &mesh) {
-    std::vector<std::unique_ptr<Mesh>> meshes{};
-    for (const auto &meshPart: mesh.meshParts) {
-        // index buffer
-        std::optional<uint32_t> nVertices = std::nullopt, nIndices = std::nullopt;
-        LLGL::Buffer *indexBuffer = nullptr;
-        {
-            auto indexBufferViewOpt = meshPart.indexBufferView;
-            if (indexBufferViewOpt.has_value()) {
-                auto indexBufferView = indexBufferViewOpt.value();
-                auto bufferPtr = indexBufferView.buffer;
-                nIndices = static_cast<uint32_t>(indexBufferView.byteLength /
-                                                 DAsset::GetSize(indexBufferView.dataType,
-                                                                 indexBufferView.componentType
-                                                 )
-                );
-                if (indexBufferView.componentType != DAsset::ComponentType::SCALAR) {
-                    RAISE_EXCEPTION(errorhandling::IllegalArgumentException,
-                                    "Index buffer component type must be scalar");
-                }
-                // Create buffer
-                {
-                    LLGL::BufferDescriptor bufferDesc{
-                            .size = indexBufferView.byteLength,
-                            .stride = static_cast<uint32_t>(indexBufferView.byteStride),
-                            .format = GetBufferFormat(indexBufferView.dataType,
-                                                      indexBufferView.componentType),
-                            .bindFlags = LLGL::BindFlags::IndexBuffer,
-                    };
-                    auto data = &bufferPtr->data[indexBufferView.byteOffset];
-                    indexBuffer = renderSystem->CreateBuffer(bufferDesc, data);
-                }
-            }
-        }
-        // buffer array
-        LLGL::BufferArray *bufferArray;
-        std::vector<LLGL::Buffer *> buffers{};
-        std::vector<LLGL::VertexFormat> vertexFormats{};
-        {
-            for (const auto &entry: meshPart.attributeBufferViews) {
-                auto attributeType = entry.first;
-                auto bufferView = entry.second;
-                uint8_t *data = &bufferView.buffer->data[bufferView.byteOffset];
+/**
+ * What a mesh part needs besides its GPU resources, prepared on any thread
+ */
+struct PreparedMeshPart {
+    const DAsset::MeshPart *meshPart = nullptr;
+    std::optional<uint32_t> nVertices = std::nullopt, nIndices = std::nullopt;
+    // One per attribute buffer view, in the order of the mesh part's attributes
+    std::vector<LLGL::VertexFormat> vertexFormats{};
+    std::optional<MeshBounds> bounds = std::nullopt;
+};
 
-                if (attributeType == DAsset::AttributeType::POSITION) {
-                    nVertices = static_cast<uint32_t>(bufferView.byteLength /
-                                                      DAsset::GetSize(bufferView.dataType,
-                                                                      bufferView.componentType
-                                                      )
-                    );
-                }
+PreparedMeshPart PrepareMeshPart(const DAsset::MeshPart &meshPart) {
+    PreparedMeshPart preparedMeshPart{.meshPart = &meshPart};
+    if (meshPart.indexBufferView.has_value()) {
+        auto &indexBufferView = meshPart.indexBufferView.value();
+        if (indexBufferView.componentType != DAsset::ComponentType::SCALAR) {
+            RAISE_EXCEPTION(errorhandling::IllegalArgumentException,
+                            "Index buffer component type must be scalar");
+        }
+        preparedMeshPart.nIndices = static_cast<uint32_t>(indexBufferView.byteLength /
+                                                          DAsset::GetSize(indexBufferView.dataType,
+                                                                          indexBufferView.componentType
+                                                          )
+        );
+    }
+    for (const auto &[attributeType, bufferView]: meshPart.attributeBufferViews) {
+        if (attributeType == DAsset::AttributeType::POSITION) {
+            preparedMeshPart.nVertices = static_cast<uint32_t>(bufferView.byteLength /
+                                                               DAsset::GetSize(bufferView.dataType,
+                                                                               bufferView.componentType
+                                                               )
+            );
+        }
 
-                LLGL::VertexFormat vertexFormat{};
-                // Create vertex format
-                {
-                    auto attributeTypeName = DAsset::GetAttributeTypeName(attributeType);
-                    // to lower case
-                    for (auto &c: attributeTypeName) {
-                        c = std::tolower(c);
-                    }
-                    auto requiredComponentType = DAsset::GetRequiredComponentTypeForAttribute(attributeType);
-                    auto actualComponentType = bufferView.componentType;
-                    if (actualComponentType != requiredComponentType) {
-                        throw std::runtime_error("Component type of attribute " + attributeTypeName +
-                                                 " (" + DAsset::GetComponentTypeName(actualComponentType) +
-                                                 ") does not match required component type (" +
-                                                 DAsset::GetComponentTypeName(requiredComponentType) + ")"
-                        );
-                    }
-                    vertexFormat.AppendAttribute(
-                            {
-                                    attributeTypeName.c_str(),
-                                    GetBufferFormat(
-                                            bufferView.dataType,
-                                            requiredComponentType
-                                    ),
-                                    GetLocationIndex(attributeType)
-                            }
-                    );
-                    vertexFormat.SetSlot(vertexFormats.size());
-                    vertexFormats.push_back(vertexFormat);
-                }
-                // Create vertex attribute buffer
-                LLGL::Buffer *buffer;
+        LLGL::VertexFormat vertexFormat{};
+        auto attributeTypeName = DAsset::GetAttributeTypeName(attributeType);
+        // to lower case
+        for (auto &c: attributeTypeName) {
+            c = std::tolower(c);
+        }
+        auto requiredComponentType = DAsset::GetRequiredComponentTypeForAttribute(attributeType);
+        auto actualComponentType = bufferView.componentType;
+        if (actualComponentType != requiredComponentType) {
+            throw std::runtime_error("Component type of attribute " + attributeTypeName +
+                                     " (" + DAsset::GetComponentTypeName(actualComponentType) +
+                                     ") does not match required component type (" +
+                                     DAsset::GetComponentTypeName(requiredComponentType) + ")"
+            );
+        }
+        vertexFormat.AppendAttribute(
                 {
-                    LLGL::BufferDescriptor bufferDesc{
-                            .size = bufferView.byteLength,
-                            .stride = static_cast<uint32_t>(bufferView.byteStride),
-                            .format = GetBufferFormat(
-                                    bufferView.dataType,
-                                    bufferView.componentType
-                            ),
-                            .bindFlags = LLGL::BindFlags::VertexBuffer,
-                            .vertexAttribs = vertexFormat.attributes
-                    };
-                    buffer = renderSystem->CreateBuffer(bufferDesc, data);
-                    buffers.push_back(buffer);
+                        attributeTypeName.c_str(),
+                        GetBufferFormat(
+                                bufferView.dataType,
+                                requiredComponentType
+                        ),
+                        GetLocationIndex(attributeType)
                 }
-            }
-            if (buffers.empty()) {
-                RAISE_EXCEPTION(errorhandling::IllegalStateException, "No vertex attributes found in mesh part");
-            }
-            bufferArray = renderSystem->CreateBufferArray(buffers.size(), buffers.data());
-        }
-
-        // Material
-        std::shared_ptr<Material> material = std::make_shared<Material>(renderSystem);
-        {
-            auto dAssetMaterial = meshPart.material;
-            material->name = dAssetMaterial->name;
-            material->albedoFactor = dAssetMaterial->albedoFactor;
-            material->roughnessFactor = dAssetMaterial->roughnessFactor;
-            material->metalnessFactor = dAssetMaterial->metalnessFactor;
-            material->ambientOcclusionFactor = dAssetMaterial->ambientOcclusionFactor;
-            material->normalScale = dAssetMaterial->normalScale;
+        );
+        vertexFormat.SetSlot(preparedMeshPart.vertexFormats.size());
+        preparedMeshPart.vertexFormats.push_back(vertexFormat);
+    }
+    if (preparedMeshPart.vertexFormats.empty()) {
+        RAISE_EXCEPTION(errorhandling::IllegalStateException, "No vertex attributes found in mesh part");
+    }
+    auto positionBufferView = meshPart.attributeBufferViews.find(DAsset::AttributeType::POSITION);
+    if (positionBufferView != meshPart.attributeBufferViews.end()) {
+        preparedMeshPart.bounds = ComputeMeshBounds(positionBufferView->second);
+    }
+    return preparedMeshPart;
+}
 
-            // Textures and samplers are created depending on whether the material has the given texture (ptr != nullptr)
-            // Respective samplers must be non-null when respective textures are non-null
-            material->albedoTexture = LoadOptionalTexture(renderSystem, dAssetMaterial->albedoTexture);
-            material->normalTexture = LoadOptionalTexture(renderSystem, dAssetMaterial->normalTexture);
-            material->rmaTexture = LoadOptionalTexture(renderSystem,
-                                                       dAssetMaterial->metallicRoughnessAmbientOcclusionTexture);
+std::shared_ptr<Material> GetMaterial(const std::shared_ptr<LLGL::RenderSystem> &renderSystem,
+                                      TextureStreamer &textureStreamer, AssetResources &resources,
+                                      const std::shared_ptr<DAsset::Material> &dAssetMaterial) {
+    auto &material = resources.materials[dAssetMaterial->materialId];
+    if (material != nullptr) {
+        return material;
+    }
+    material = std::make_shared<Material>(renderSystem);
+    material->name = dAssetMaterial->name;
+    material->albedoFactor = dAssetMaterial->albedoFactor;
+    material->roughnessFactor = dAssetMaterial->roughnessFactor;
+    material->metalnessFactor = dAssetMaterial->metalnessFactor;
+    material->ambientOcclusionFactor = dAssetMaterial->ambientOcclusionFactor;
+    material->normalScale = dAssetMaterial->normalScale;
 
-            material->albedoSampler = CreateOptionalSampler(renderSystem, dAssetMaterial->albedoTexture);
-            material->normalSampler = CreateOptionalSampler(renderSystem, dAssetMaterial->normalTexture);
-            material->rmaSampler = CreateOptionalSampler(renderSystem,
-                                                         dAssetMaterial->metallicRoughnessAmbientOcclusionTexture);
-            // Create texture present flag buffer
-            {
-                uint32_t flags = 0;
-                if (material->albedoTexture != nullptr) {
-                    flags |= (1 << 0);
-                }
-                if (material->normalTexture != nullptr) {
-                    flags |= (1 << 1);
-                }
-                if (material->rmaTexture != nullptr) {
-                    flags |= (1 << 2);
-                }
-                LLGL::BufferDescriptor bufferDescriptor = {
-                        .size = sizeof(MaterialShaderState)
-                };
-                MaterialShaderState materialShaderState = {
-                        .texturePresentStates = flags,
-                        .albedoFactor = material->albedoFactor,
-                        .roughnessFactor = material->roughnessFactor,
-                        .metalnessFactor = material->metalnessFactor,
-                        .ambientOcclusionFactor = material->ambientOcclusionFactor,
-                        .normalScale = material->normalScale
-                };
-                material->texturePresentFlagsBuffer = renderSystem->CreateBuffer(bufferDescriptor, &materialShaderState);
-            }
+    // Textures and samplers are created depending on whether the material has the given texture (ptr != nullptr)
+    // Respective samplers must be non-null when respective textures are non-null
+    material->albedoTexture = LoadOptionalTexture(textureStreamer, resources, dAssetMaterial->albedoTexture);
+    material->normalTexture = LoadOptionalTexture(textureStreamer, resources, dAssetMaterial->normalTexture);
+    material->rmaTexture = LoadOptionalTexture(textureStreamer, resources,
+                                               dAssetMaterial->metallicRoughnessAmbientOcclusionTexture);
 
+    material->albedoSampler = CreateOptionalSampler(renderSystem, resources, dAssetMaterial->albedoTexture);
+    material->normalSampler = CreateOptionalSampler(renderSystem, resources, dAssetMaterial->normalTexture);
+    material->rmaSampler = CreateOptionalSampler(renderSystem, resources,
+                                                 dAssetMaterial->metallicRoughnessAmbientOcclusionTexture);
+    // Create texture present flag buffer
+    {
+        uint32_t flags = 0;
+        if (material->albedoTexture != nullptr) {
+            flags |= (1 << 0);
+        }
+        if (material->normalTexture != nullptr) {
+            flags |= (1 << 1);
         }
-        meshes.push_back(
-                std::make_unique<Mesh>(GetMeshRenderMode(meshPart.renderMode),
+        if (material->rmaTexture != nullptr) {
+            flags |= (1 << 2);
+        }
+        LLGL::BufferDescriptor bufferDescriptor = {
+                .size = sizeof(MaterialShaderState)
+        };
+        MaterialShaderState materialShaderState = {
+                .texturePresentStates = flags,
+                .albedoFactor = material->albedoFactor,
+                .roughnessFactor = material->roughnessFactor,
+                .metalnessFactor = material->metalnessFactor,
+                .ambientOcclusionFactor = material->ambientOcclusionFactor,
+                .normalScale = material->normalScale
+        };
+        material->texturePresentFlagsBuffer = renderSystem->CreateBuffer(bufferDescriptor, &materialShaderState);
+    }
+    return material;
+}
+
+std::unique_ptr<Mesh> CreateMesh(const std::shared_ptr<LLGL::RenderSystem> &renderSystem,
+                                 TextureStreamer &textureStreamer, AssetResources &resources,
+                                 const PreparedMeshPart &preparedMeshPart) {
+    auto &meshPart = *preparedMeshPart.meshPart;
+    // index buffer
+    LLGL::Buffer *indexBuffer = nullptr;
+    if (meshPart.indexBufferView.has_value()) {
+        auto &indexBufferView = meshPart.indexBufferView.value();
+        LLGL::BufferDescriptor bufferDesc{
+                .size = indexBufferView.byteLength,
+                .stride = static_cast<uint32_t>(indexBufferView.byteStride),
+                .format = GetBufferFormat(indexBufferView.dataType,
+                                          indexBufferView.componentType),
+                .bindFlags = LLGL::BindFlags::IndexBuffer,
+        };
+        auto data = &indexBufferView.buffer->data[indexBufferView.byteOffset];
+        indexBuffer = renderSystem->CreateBuffer(bufferDesc, data);
+    }
+    // buffer array
+    std::vector<LLGL::Buffer *> buffers{};
+    for (const auto &[attributeType, bufferView]: meshPart.attributeBufferViews) {
+        auto &vertexFormat = preparedMeshPart.vertexFormats[buffers.size()];
+        const uint8_t *data = &bufferView.buffer->data[bufferView.byteOffset];
+        LLGL::BufferDescriptor bufferDesc{
+                .size = bufferView.byteLength,
+                .stride = static_cast<uint32_t>(bufferView.byteStride),
+                .format = GetBufferFormat(
+                        bufferView.dataType,
+                        bufferView.componentType
+                ),
+                .bindFlags = LLGL::BindFlags::VertexBuffer,
+                .vertexAttribs = vertexFormat.attributes
+        };
+        buffers.push_back(renderSystem->CreateBuffer(bufferDesc, data));
+    }
+    LLGL::BufferArray *bufferArray = renderSystem->CreateBufferArray(buffers.size(), buffers.data());
+
+    auto material = GetMaterial(renderSystem, textureStreamer, resources, meshPart.material);
+    auto mesh = std::make_unique<Mesh>(GetMeshRenderMode(meshPart.renderMode),
                                        renderSystem,
-                                       nVertices, nIndices,
+                                       preparedMeshPart.nVertices, preparedMeshPart.nIndices,
                                        indexBuffer, buffers, bufferArray,
-                                       vertexFormats,
+                                       preparedMeshPart.vertexFormats,
                                        material
-                )
-        );
+    );
+    if (preparedMeshPart.bounds.has_value()) {
+        mesh->boundsCenter = preparedMeshPart.bounds->center;
+        mesh->boundsRadius = preparedMeshPart.bounds->radius;
     }
-    return meshes;
+    return mesh;
 }
 
 
 Asset *AssetLoader::LoadAsset(const std::shared_ptr<LLGL::RenderSystem> &renderSystem,
-                              const std::unique_ptr<Stream::DataReadStream> &assetDataStream) {
-    auto dAsset = DAsset::ReadAsset(assetDataStream);
+                              TextureStreamer &textureStreamer,
+                              const DAsset::ByteSpan &assetBytes, LoadStatistics &statistics) {
+    auto stageStart = std::chrono::steady_clock::now();
+    auto finishStage = [&stageStart](std::chrono::nanoseconds &stageTime) {
+        auto now = std::chrono::steady_clock::now();
+        stageTime = std::chrono::duration_cast<std::chrono::nanoseconds>(now - stageStart);
+        stageStart = now;
+    };
+
+    // Parse the metadata, without the buffer payloads
+    auto dAsset = DAsset::ReadAssetLazily(assetBytes);
+    // Nodes in breadth first order, the order they are added to the asset
+    std::vector<const DAsset::Node *> dAssetNodes{&dAsset.rootNode};
+    std::vector<const DAsset::MeshPart *> meshParts{};
+    // Textures referenced by the materials, each decoded once
+    std::vector<std::shared_ptr<DAsset::Texture>> textures{};
+    std::unordered_set<uint64_t> addedTextureIds{};
+    for (size_t nodeIndex = 0; nodeIndex < dAssetNodes.size(); nodeIndex++) {
+        auto &node = *dAssetNodes[nodeIndex];
+        for (const auto &meshPart: node.mesh.meshParts) {
+            meshParts.push_back(&meshPart);
+            for (const auto &optionalTexture: {meshPart.material->albedoTexture, meshPart.material->normalTexture,
+                                               meshPart.material->metallicRoughnessAmbientOcclusionTexture}) {
+                if (optionalTexture.has_value() && addedTextureIds.insert(optionalTexture.value()->textureId).second) {
+                    textures.push_back(optionalTexture.value());
+                }
+            }
+        }
+        for (const auto &child: node.children) {
+            dAssetNodes.push_back(&child);
+        }
+    }
+    finishStage(statistics.parse);
+
+    auto &buffers = dAsset.bufferCollection.buffers;
+    ParallelJobs::Run(buffers.size(), [&](size_t bufferIndex) {
+        buffers[bufferIndex]->load();
+    });
+    finishStage(statistics.payloads);
+
+    // Textures depend on nothing but their loaded buffers, so they are decoded together with the mesh parts.
+    // They come first, as they take longest.
+    std::vector<std::shared_ptr<const TextureUpload::DecodedTexture>> decodedTextureList(textures.size());
+    std::vector<PreparedMeshPart> preparedMeshParts(meshParts.size());
+    const auto &residencyManager = textureStreamer.getResidencyManager();
+    ParallelJobs::Run(textures.size() + meshParts.size(), [&](size_t job) {
+        if (job < textures.size()) {
+            auto &texture = *textures[job];
+            auto baseLevel = residencyManager.getBaseLevel(static_cast<uint32_t>(texture.width),
+                                                           static_cast<uint32_t>(texture.height),
+                                                           texture.getMipLevelCount(),
+                                                           TextureUpload::GetBlockSize(texture));
+            decodedTextureList[job] = std::make_shared<const TextureUpload::DecodedTexture>(
+                    TextureUpload::DecodeTexture(texture, baseLevel));
+        } else {
+            preparedMeshParts[job - textures.size()] = PrepareMeshPart(*meshParts[job - textures.size()]);
+        }
+    });
+    AssetResources resources{};
+    for (size_t textureIndex = 0; textureIndex < textures.size(); textureIndex++) {
+        resources.decodedTextures.emplace(textures[textureIndex]->textureId, decodedTextureList[textureIndex]);
+    }
+    finishStage(statistics.decode);
+
+    // GPU resources are created on the calling thread, the thread of the render system
     Asset *asset = new Asset{};
-    std::queue<DAsset::Node> nodes;
-    nodes.push(dAsset.rootNode);
-    while (!nodes.empty()) {
-        auto node = nodes.front();
-        nodes.pop();
-        auto meshes = GetMeshes(renderSystem, dAsset.bufferCollection, node.mesh);
+    size_t meshPartIndex = 0;
+    for (const auto *node: dAssetNodes) {
         glm::mat4 modelMatrix = glm::identity<glm::mat4>();
-        modelMatrix = glm::translate(modelMatrix, node.translation);
-        modelMatrix *= glm::mat4_cast(node.rotation);
-        modelMatrix = glm::scale(modelMatrix, node.scale);
+        modelMatrix = glm::translate(modelMatrix, node->translation);
+        modelMatrix *= glm::mat4_cast(node->rotation);
+        modelMatrix = glm::scale(modelMatrix, node->scale);
 
         std::unique_ptr<Node> nodePtr = std::make_unique<Node>(modelMatrix, *asset);
-        for (auto &mesh: meshes) {
+        for (size_t i = 0; i < node->mesh.meshParts.size(); i++) {
+            auto mesh = CreateMesh(renderSystem, textureStreamer, resources,
+                                   preparedMeshParts[meshPartIndex++]);
             nodePtr->addMesh(mesh);
         }
         asset->nodes.push_back(std::move(nodePtr));
-        for (const auto &item: node.children) {
-            nodes.push(item);
-        }
     }
+    finishStage(statistics.create);
+    statistics.nMeshes = meshParts.size();
+    statistics.nMaterials = resources.materials.size();
+    statistics.nTextures = resources.textures.size();
+    statistics.nSamplers = resources.samplers.size();
     return asset;
 }
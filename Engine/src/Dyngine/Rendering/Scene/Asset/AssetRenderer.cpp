@@ -23,3 +23,9 @@ void AssetRenderer::render(LLGL::CommandBuffer &commandBuffer) {
         renderer->render(commandBuffer);
     }
 }
+
+void AssetRenderer::requestTextureMips(TextureStreamer &textureStreamer, float viewportHeight) {
+    for (auto &renderer: nodeRenderers) {
+        renderer->requestTextureMips(textureStreamer, viewportHeight);
+    }
+}
@@ -5,11 +5,4 @@ Material::Material(const std::shared_ptr<LLGL::RenderSystem> &renderSystem) : re
 
 Material::~Material() {
     renderSystem->Release(*texturePresentFlagsBuffer);
-    renderSystem->Release(*albedoTexture);
-    renderSystem->Release(*normalTexture);
-    renderSystem->Release(*rmaTexture);
-
-    renderSystem->Release(*albedoSampler);
-    renderSystem->Release(*normalSampler);
-    renderSystem->Release(*rmaSampler);
 }
\ No newline at end of file
@@ -4,6 +4,8 @@
 #include "ErrorHandling/IllegalArgumentException.hpp"
 #include "LLGL/Utility.h"
 #include "glm/glm.hpp"
+#include <algorithm>
+#include <limits>
 
 LLGL::PrimitiveTopology GetPrimitiveTopology(MeshRenderMode mode) {
     switch (mode) {
@@ -40,7 +42,7 @@ void AddTextureBinding(LLGL::PipelineLayoutDescriptor &layoutDesc, uint32_t slot
 }
 
 void AddTextureResourceIfExists(LLGL::ResourceHeapDescriptor &resourceHeapDescriptor, LLGL::Sampler *sampler,
-                                LLGL::Texture *texture) {
+                                const std::shared_ptr<StreamedTexture> &texture) {
     if (sampler == nullptr) {
         return;
     }
@@ -50,7 +52,19 @@ void AddTextureResourceIfExists(LLGL::ResourceHeapDescriptor &resourceHeapDescri
         );
     }
     resourceHeapDescriptor.resourceViews.push_back(sampler);
-    resourceHeapDescriptor.resourceViews.push_back(texture);
+    resourceHeapDescriptor.resourceViews.push_back(texture->getTexture());
+}
+
+uint64_t GetTextureGeneration(const std::shared_ptr<StreamedTexture> &texture) {
+    return texture != nullptr ? texture->getGeneration() : 0;
+}
+
+std::array<uint64_t, 3> GetTextureGenerations(const Material &material) {
+    return {
+            GetTextureGeneration(material.albedoTexture),
+            GetTextureGeneration(material.normalTexture),
+            GetTextureGeneration(material.rmaTexture)
+    };
 }
 
 MeshRenderer::MeshRenderer(const std::shared_ptr<LLGL::RenderSystem> &renderSystem,
@@ -64,6 +78,8 @@ MeshRenderer::MeshRenderer(const std::shared_ptr<LLGL::RenderSystem> &renderSyst
         : renderSystem(renderSystem),
           shaderCache(shaderCache),
           shaderUsageHandle(shaderUsageHandle),
+          cameraShaderStateBuffer(cameraShaderStateBuffer),
+          lightsShaderStateBuffer(lightsShaderStateBuffer),
           parentNode(parentNode),
           mesh(mesh) {
 
@@ -104,8 +120,8 @@ MeshRenderer::MeshRenderer(const std::shared_ptr<LLGL::RenderSystem> &renderSyst
                                     LLGL::StageFlags::FragmentStage, 4u}
     );
 
-    // Setup pipeline layout
-    LLGL::PipelineLayout *pipelineLayout = renderSystem->CreatePipelineLayout(layoutDesc);
+    // Setup pipeline layout, kept to re-create the resource heap when streamed textures change
+    pipelineLayout = renderSystem->CreatePipelineLayout(layoutDesc);
 
     // Create pipeline
     {
@@ -128,7 +144,12 @@ MeshRenderer::MeshRenderer(const std::shared_ptr<LLGL::RenderSystem> &renderSyst
         pipeline = renderSystem->CreatePipelineState(pipelineDescriptor);
     }
 
-    // Create resource heap
+    resourceHeap = createResourceHeap();
+}
+
+LLGL::ResourceHeap *MeshRenderer::createResourceHeap() {
+    resourceHeapTextureGenerations = GetTextureGenerations(*mesh->material);
+
     LLGL::ResourceHeapDescriptor resourceHeapDesc{
             .pipelineLayout = pipelineLayout
     };
@@ -144,18 +165,17 @@ MeshRenderer::MeshRenderer(const std::shared_ptr<LLGL::RenderSystem> &renderSyst
         resourceHeapDesc.resourceViews.push_back(material->texturePresentFlagsBuffer);
 
         // 2. Albedo map
-        AddTextureResourceIfExists(resourceHeapDesc, material->albedoSampler, material->albedoTexture);
+        AddTextureResourceIfExists(resourceHeapDesc, material->albedoSampler.get(), material->albedoTexture);
         // 3. Normal map
-        AddTextureResourceIfExists(resourceHeapDesc, material->normalSampler, material->normalTexture);
+        AddTextureResourceIfExists(resourceHeapDesc, material->normalSampler.get(), material->normalTexture);
         // 4. RMA map
-        AddTextureResourceIfExists(resourceHeapDesc, material->rmaSampler, material->rmaTexture);
+        AddTextureResourceIfExists(resourceHeapDesc, material->rmaSampler.get(), material->rmaTexture);
     }
 
     // 4. Add lights shader state buffer
     resourceHeapDesc.resourceViews.push_back(lightsShaderStateBuffer);
 
-    resourceHeap = renderSystem->CreateResourceHeap(resourceHeapDesc);
-    renderSystem->Release(*pipelineLayout);
+    return renderSystem->CreateResourceHeap(resourceHeapDesc);
 }
 
 MeshRenderer *MeshRenderer::fromMesh(const std::shared_ptr<LLGL::RenderSystem> &renderSystem,
@@ -189,6 +209,12 @@ MeshRenderer *MeshRenderer::fromMesh(const std::shared_ptr<LLGL::RenderSystem> &
 }
 
 void MeshRenderer::render(LLGL::CommandBuffer &commandBuffer) {
+    // The resource heap references the textures, streamed textures are re-created when their mip levels change
+    if (GetTextureGenerations(*mesh->material) != resourceHeapTextureGenerations) {
+        renderSystem->Release(*resourceHeap);
+        resourceHeap = createResourceHeap();
+    }
+
     commandBuffer.SetPipelineState(*pipeline);
     commandBuffer.SetResourceHeap(*resourceHeap);
 
@@ -202,7 +228,35 @@ void MeshRenderer::render(LLGL::CommandBuffer &commandBuffer) {
     }
 }
 
+void MeshRenderer::requestTextureMips(TextureStreamer &textureStreamer, const CameraShaderState &cameraShaderState,
+                                      float viewportHeight) {
+    auto &material = *mesh->material;
+    if (material.albedoTexture == nullptr && material.normalTexture == nullptr && material.rmaTexture == nullptr) {
+        return;
+    }
+    // The textures are assumed to cover the mesh once, so they cover the mesh's bounding sphere on screen
+    auto modelMatrix = parentNode.getCurrentModelMatrix();
+    glm::vec3 worldCenter = modelMatrix * glm::vec4(mesh->boundsCenter, 1.0f);
+    float scale = std::max({glm::length(glm::vec3(modelMatrix[0])),
+                            glm::length(glm::vec3(modelMatrix[1])),
+                            glm::length(glm::vec3(modelMatrix[2]))});
+    float worldRadius = mesh->boundsRadius * scale;
+    float distance = glm::distance(cameraShaderState.position, worldCenter);
+    float screenSize = std::numeric_limits<float>::infinity();
+    if (distance > worldRadius) {
+        // Projected diameter: projectionMatrix[1][1] maps a height of 2 at distance 1 to the viewport height
+        screenSize = worldRadius * cameraShaderState.projectionMatrix[1][1] * viewportHeight / distance;
+    }
+
+    for (auto texture: {material.albedoTexture, material.normalTexture, material.rmaTexture}) {
+        if (texture != nullptr) {
+            textureStreamer.requestScreenSize(*texture, screenSize);
+        }
+    }
+}
+
 MeshRenderer::~MeshRenderer() {
     renderSystem->Release(*resourceHeap);
     renderSystem->Release(*pipeline);
+    renderSystem->Release(*pipelineLayout);
 }
\ No newline at end of file
@@ -41,6 +41,12 @@ void NodeRenderer::render(LLGL::CommandBuffer &commandBuffer) {
     }
 }
 
+void NodeRenderer::requestTextureMips(TextureStreamer &textureStreamer, float viewportHeight) {
+    for (auto &mesh: meshRenderers) {
+        mesh->requestTextureMips(textureStreamer, camera.getCameraShaderState(), viewportHeight);
+    }
+}
+
 void NodeRenderer::updateCameraShaderStateBuffer(LLGL::CommandBuffer &commandBuffer) {
     commandBuffer.UpdateBuffer(*cameraShaderStateBuffer, 0, &camera.getCameraShaderState(), sizeof(CameraShaderState));
 }
@@ -1,8 +1,10 @@
 #include "Dyngine/Rendering/Scene/SceneRenderer.hpp"
 
 SceneRenderer::SceneRenderer(const std::shared_ptr<LLGL::RenderSystem> &renderSystem,
-                             LLGL::RenderTarget *renderTarget, const std::shared_ptr<ShaderCache> &shaderCache, std::unique_ptr<Scene> scene)
-        : renderSystem(renderSystem), renderTarget(renderTarget), shaderCache(shaderCache), scene(std::move(scene)) {
+                             LLGL::RenderTarget *renderTarget, const std::shared_ptr<ShaderCache> &shaderCache, std::unique_ptr<Scene> scene,
+                             const std::shared_ptr<TextureStreamer> &textureStreamer)
+        : renderSystem(renderSystem), renderTarget(renderTarget), shaderCache(shaderCache), scene(std::move(scene)),
+          textureStreamer(textureStreamer) {
     LLGL::BufferDescriptor bufferDescriptor = {
             .size = sizeof(LightsShaderState),
             .bindFlags = LLGL::BindFlags::ConstantBuffer
@@ -19,6 +21,14 @@ void SceneRenderer::render(LLGL::CommandBuffer &commandBuffer) {
     }
 }
 
+bool SceneRenderer::updateTextureStreaming(float viewportHeight) {
+    addNewAssetRenders();
+    for (auto &renderer: renderers) {
+        renderer->requestTextureMips(*textureStreamer, viewportHeight);
+    }
+    return textureStreamer->update();
+}
+
 void SceneRenderer::updateLightData(LLGL::CommandBuffer &commandBuffer) {
     if (!scene->haveLightsChanged()) {
         return;
@@ -0,0 +1,220 @@
+#include "Dyngine/Rendering/Texture/TextureResidencyManager.hpp"
+#include "ErrorHandling/IllegalArgumentException.hpp"
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+TextureResidencyManager::TextureResidencyManager(ITextureStreamingBackend &backend,
+                                                 const TextureStreamingSettings &settings)
+        : backend(backend), settings(settings) {
+}
+
+void TextureResidencyManager::addTexture(uint64_t textureId, uint32_t width, uint32_t height,
+                                         const std::vector<uint64_t> &levelSizes, uint32_t blockSize) {
+    if (levelSizes.empty()) {
+        RAISE_EXCEPTION(errorhandling::IllegalArgumentException, "Texture has no mip levels");
+    }
+    if (textures.contains(textureId)) {
+        RAISE_EXCEPTION(errorhandling::IllegalArgumentException,
+                        "Texture " + std::to_string(textureId) + " is already streamed");
+    }
+    auto nLevels = static_cast<uint32_t>(levelSizes.size());
+    // Levels are only evicted down to the base level, so every first resident level is a valid full size level
+    uint32_t baseLevel = getBaseLevel(width, height, nLevels, blockSize);
+    auto &texture = textures.emplace(textureId, ResidentTexture{
+            .levelSizes = levelSizes,
+            .firstResidentLevel = baseLevel,
+            .baseLevel = baseLevel,
+            .requestedLevel = nLevels,
+            .lastUsedFrame = frame
+    }).first->second;
+    residentBytes += GetResidentBytes(texture, baseLevel);
+    backend.setResidentMipLevels(textureId, baseLevel);
+}
+
+void TextureResidencyManager::removeTexture(uint64_t textureId) {
+    auto &texture = getTexture(textureId);
+    residentBytes -= GetResidentBytes(texture, texture.firstResidentLevel);
+    textures.erase(textureId);
+}
+
+void TextureResidencyManager::requestMipLevel(uint64_t textureId, uint32_t level) {
+    auto &texture = getTexture(textureId);
+    auto lastLevel = static_cast<uint32_t>(texture.levelSizes.size()) - 1;
+    texture.requestedLevel = std::min(texture.requestedLevel, std::min(level, lastLevel));
+    texture.lastUsedFrame = frame;
+}
+
+bool TextureResidencyManager::update() {
+    // First resident level of every texture whose levels changed, before the update
+    std::map<uint64_t, uint32_t> changedLevels{};
+
+    // Textures missing the most levels are streamed in first
+    std::vector<uint64_t> missingLevels{};
+    for (auto &[textureId, texture]: textures) {
+        if (texture.requestedLevel < texture.firstResidentLevel) {
+            missingLevels.push_back(textureId);
+        }
+    }
+    std::stable_sort(missingLevels.begin(), missingLevels.end(), [this](uint64_t a, uint64_t b) {
+        auto &textureA = textures.at(a), &textureB = textures.at(b);
+        return textureA.firstResidentLevel - textureA.requestedLevel >
+               textureB.firstResidentLevel - textureB.requestedLevel;
+    });
+
+    uint64_t uploadedBytes = 0;
+    for (auto textureId: missingLevels) {
+        auto &texture = textures.at(textureId);
+        // Levels are streamed in from small to large, so a texture gets sharper step by step
+        while (texture.firstResidentLevel > texture.requestedLevel) {
+            uint64_t levelSize = texture.levelSizes[texture.firstResidentLevel - 1];
+            // The texture is re-created with all its resident levels, the first new level uploads them all
+            uint64_t uploadSize = changedLevels.contains(textureId)
+                                  ? levelSize : GetResidentBytes(texture, texture.firstResidentLevel - 1);
+            if (uploadedBytes > 0 && uploadedBytes + uploadSize > settings.uploadBudgetPerFrame) {
+                break;
+            }
+            if (residentBytes + levelSize > settings.memoryBudget &&
+                !evict(residentBytes + levelSize - settings.memoryBudget, textureId, changedLevels)) {
+                break;
+            }
+            changedLevels.emplace(textureId, texture.firstResidentLevel);
+            texture.firstResidentLevel--;
+            residentBytes += levelSize;
+            uploadedBytes += uploadSize;
+        }
+    }
+
+    // Evictions are passed to the backend first, and the backend frees the levels a texture loses before uploading
+    // its new levels, so the resident levels never exceed the budget on the GPU
+    if (!changedLevels.empty()) {
+        backend.beginResidencyChanges();
+    }
+    bool changed = false;
+    for (auto &[textureId, previousFirstLevel]: changedLevels) {
+        auto firstLevel = textures.at(textureId).firstResidentLevel;
+        if (firstLevel > previousFirstLevel) {
+            backend.setResidentMipLevels(textureId, firstLevel);
+            changed = true;
+        }
+    }
+    for (auto &[textureId, previousFirstLevel]: changedLevels) {
+        auto firstLevel = textures.at(textureId).firstResidentLevel;
+        if (firstLevel < previousFirstLevel) {
+            backend.setResidentMipLevels(textureId, firstLevel);
+            changed = true;
+        }
+    }
+
+    for (auto &[textureId, texture]: textures) {
+        texture.requestedLevel = static_cast<uint32_t>(texture.levelSizes.size());
+    }
+    frame++;
+    return changed;
+}
+
+bool TextureResidencyManager::evict(uint64_t bytes, uint64_t protectedTextureId,
+                                    std::map<uint64_t, uint32_t> &changedLevels) {
+    uint64_t freedBytes = 0;
+    auto evictLevels = [&](uint64_t textureId, ResidentTexture &texture, uint32_t keepLevel) {
+        while (freedBytes < bytes && texture.firstResidentLevel < keepLevel) {
+            changedLevels.emplace(textureId, texture.firstResidentLevel);
+            uint64_t levelSize = texture.levelSizes[texture.firstResidentLevel];
+            texture.firstResidentLevel++;
+            residentBytes -= levelSize;
+            freedBytes += levelSize;
+        }
+    };
+
+    // Textures not drawn in this frame, least recently used first
+    std::vector<uint64_t> unusedTextures{};
+    for (auto &[textureId, texture]: textures) {
+        if (textureId != protectedTextureId && texture.lastUsedFrame != frame &&
+            texture.firstResidentLevel < texture.baseLevel) {
+            unusedTextures.push_back(textureId);
+        }
+    }
+    std::stable_sort(unusedTextures.begin(), unusedTextures.end(), [this](uint64_t a, uint64_t b) {
+        return textures.at(a).lastUsedFrame < textures.at(b).lastUsedFrame;
+    });
+    for (auto textureId: unusedTextures) {
+        auto &texture = textures.at(textureId);
+        evictLevels(textureId, texture, texture.baseLevel);
+    }
+
+    // Levels of textures drawn in this frame that are sharper than needed
+    for (auto &[textureId, texture]: textures) {
+        if (textureId != protectedTextureId && texture.lastUsedFrame == frame) {
+            evictLevels(textureId, texture, std::min(texture.requestedLevel, texture.baseLevel));
+        }
+    }
+    return freedBytes >= bytes;
+}
+
+uint64_t TextureResidencyManager::GetResidentBytes(const ResidentTexture &texture, uint32_t firstLevel) {
+    uint64_t bytes = 0;
+    for (uint32_t level = firstLevel; level < texture.levelSizes.size(); level++) {
+        bytes += texture.levelSizes[level];
+    }
+    return bytes;
+}
+
+uint32_t TextureResidencyManager::getFirstResidentLevel(uint64_t textureId) const {
+    return getTexture(textureId).firstResidentLevel;
+}
+
+uint64_t TextureResidencyManager::getResidentBytes() const {
+    return residentBytes;
+}
+
+const TextureStreamingSettings &TextureResidencyManager::getSettings() const {
+    return settings;
+}
+
+uint32_t TextureResidencyManager::getBaseLevel(uint32_t width, uint32_t height, uint32_t nLevels,
+                                               uint32_t blockSize) const {
+    // Every level from 0 to the base level can become the first resident level, so all of them must be aligned
+    auto isBlockAligned = [&](uint32_t level) {
+        return std::max(width >> level, 1u) % blockSize == 0 && std::max(height >> level, 1u) % blockSize == 0;
+    };
+    uint32_t baseLevel = 0;
+    while (baseLevel + 1 < nLevels && (std::max(width, height) >> baseLevel) > settings.alwaysResidentSize &&
+           isBlockAligned(baseLevel + 1)) {
+        baseLevel++;
+    }
+    return baseLevel;
+}
+
+uint32_t TextureResidencyManager::GetWantedMipLevel(uint32_t width, uint32_t height, uint32_t nLevels,
+                                                    float screenSize) {
+    if (nLevels == 0) {
+        RAISE_EXCEPTION(errorhandling::IllegalArgumentException, "Texture has no mip levels");
+    }
+    auto longerSide = static_cast<float>(std::max(width, height));
+    if (screenSize >= longerSide) {
+        return 0;
+    }
+    if (screenSize <= 1) {
+        return nLevels - 1;
+    }
+    auto level = static_cast<uint32_t>(std::floor(std::log2(longerSide / screenSize)));
+    return std::min(level, nLevels - 1);
+}
+
+TextureResidencyManager::ResidentTexture &TextureResidencyManager::getTexture(uint64_t textureId) {
+    auto it = textures.find(textureId);
+    if (it == textures.end()) {
+        RAISE_EXCEPTION(errorhandling::IllegalArgumentException,
+                        "Texture " + std::to_string(textureId) + " is not streamed");
+    }
+    return it->second;
+}
+
+const TextureResidencyManager::ResidentTexture &TextureResidencyManager::getTexture(uint64_t textureId) const {
+    auto it = textures.find(textureId);
+    if (it == textures.end()) {
+        RAISE_EXCEPTION(errorhandling::IllegalArgumentException,
+                        "Texture " + std::to_string(textureId) + " is not streamed");
+    }
+    return it->second;
+}
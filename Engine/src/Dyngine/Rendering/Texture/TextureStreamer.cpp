@@ -0,0 +1,104 @@
+#include "Dyngine/Rendering/Texture/TextureStreamer.hpp"
+#include "Dyngine/Rendering/Texture/TextureUpload.hpp"
+
+StreamedTexture::StreamedTexture(const std::shared_ptr<LLGL::RenderSystem> &renderSystem,
+                                 const std::shared_ptr<DAsset::Texture> &assetTexture, uint64_t streamingId)
+        : renderSystem(renderSystem), assetTexture(assetTexture), streamingId(streamingId) {
+}
+
+StreamedTexture::~StreamedTexture() {
+    if (texture != nullptr) {
+        renderSystem->Release(*texture);
+    }
+}
+
+LLGL::Texture *StreamedTexture::getTexture() const {
+    return texture;
+}
+
+uint64_t StreamedTexture::getGeneration() const {
+    return generation;
+}
+
+uint32_t StreamedTexture::getFirstResidentLevel() const {
+    return firstResidentLevel;
+}
+
+const DAsset::Texture &StreamedTexture::getAssetTexture() const {
+    return *assetTexture;
+}
+
+TextureStreamer::TextureStreamer(const std::shared_ptr<LLGL::RenderSystem> &renderSystem,
+                                 const TextureStreamingSettings &settings)
+        : renderSystem(renderSystem), residencyManager(*this, settings) {
+}
+
+std::shared_ptr<StreamedTexture>
+TextureStreamer::addTexture(const std::shared_ptr<DAsset::Texture> &assetTexture,
+                            const std::shared_ptr<const TextureUpload::DecodedTexture> &decodedBaseLevels) {
+    auto streamingId = nextStreamingId++;
+    auto texture = std::make_shared<StreamedTexture>(renderSystem, assetTexture, streamingId);
+    texture->decodedBaseLevels = decodedBaseLevels;
+    std::vector<uint64_t> levelSizes{};
+    for (uint32_t level = 0; level < assetTexture->getMipLevelCount(); level++) {
+        levelSizes.push_back(TextureUpload::GetMipLevelMemorySize(*assetTexture, level));
+    }
+    // Registered first, adding the texture to the residency manager uploads its always resident levels
+    textures.emplace(streamingId, texture);
+    residencyManager.addTexture(streamingId, assetTexture->width, assetTexture->height, levelSizes,
+                                TextureUpload::GetBlockSize(*assetTexture));
+    return texture;
+}
+
+void TextureStreamer::requestScreenSize(const StreamedTexture &texture, float screenSize) {
+    auto &assetTexture = *texture.assetTexture;
+    residencyManager.requestMipLevel(texture.streamingId, TextureResidencyManager::GetWantedMipLevel(
+            assetTexture.width, assetTexture.height, assetTexture.getMipLevelCount(), screenSize));
+}
+
+bool TextureStreamer::update() {
+    // Textures no longer referenced have released themselves
+    for (auto it = textures.begin(); it != textures.end();) {
+        if (it->second.expired()) {
+            residencyManager.removeTexture(it->first);
+            it = textures.erase(it);
+        } else {
+            it++;
+        }
+    }
+
+    return residencyManager.update();
+}
+
+const TextureResidencyManager &TextureStreamer::getResidencyManager() const {
+    return residencyManager;
+}
+
+void TextureStreamer::beginResidencyChanges() {
+    // Frames in flight may still sample the textures that are re-created
+    renderSystem->GetCommandQueue()->WaitIdle();
+}
+
+void TextureStreamer::setResidentMipLevels(uint64_t textureId, uint32_t firstLevel) {
+    auto texture = textures.at(textureId).lock();
+    if (texture == nullptr) {
+        return;
+    }
+    // Released before the new texture is created, so both never take up GPU memory at the same time
+    if (texture->texture != nullptr) {
+        renderSystem->Release(*texture->texture);
+        texture->texture = nullptr;
+    }
+    LLGL::Texture *newTexture;
+    auto &decodedBaseLevels = texture->decodedBaseLevels;
+    if (decodedBaseLevels != nullptr && decodedBaseLevels->firstLevel == firstLevel) {
+        newTexture = TextureUpload::UploadTexture(renderSystem, *texture->assetTexture, *decodedBaseLevels);
+    } else {
+        newTexture = TextureUpload::CreateTexture(renderSystem, *texture->assetTexture, firstLevel);
+    }
+    // The decoded levels are only needed when the texture is added
+    decodedBaseLevels = nullptr;
+    texture->texture = newTexture;
+    texture->firstResidentLevel = firstLevel;
+    texture->generation++;
+}
@@ -0,0 +1,178 @@
+#include "Dyngine/Rendering/Texture/TextureUpload.hpp"
+#include "ErrorHandling/IllegalArgumentException.hpp"
+#include "stb_image.h"
+
+LLGL::Format GetCompressedTextureFormat(DAsset::TextureFormat format) {
+    switch (format) {
+        case DAsset::TextureFormat::BC4:
+            return LLGL::Format::BC4UNorm;
+        case DAsset::TextureFormat::BC5:
+            return LLGL::Format::BC5UNorm;
+        case DAsset::TextureFormat::BC7:
+            return LLGL::Format::BC7UNorm;
+        default:
+            RAISE_EXCEPTION(errorhandling::IllegalArgumentException,
+                            "Texture format is not block compressed: " + DAsset::GetTextureFormatName(format));
+    }
+}
+
+uint64_t GetCompressedLevelSize(const DAsset::Texture &texture, uint32_t level) {
+    uint64_t blockSize = texture.format == DAsset::TextureFormat::BC4 ? 8 : 16;
+    return static_cast<uint64_t>((texture.getMipLevelWidth(level) + 3) / 4) *
+           ((texture.getMipLevelHeight(level) + 3) / 4) * blockSize;
+}
+
+/**
+ * Uploads one mip level of a texture created with the DAsset texture's levels from firstLevel on.
+ * The first level is uploaded when the texture is created.
+ */
+void WriteMipLevel(const std::shared_ptr<LLGL::RenderSystem> &renderSystem, LLGL::Texture &llglTexture,
+                   const DAsset::Texture &texture, uint32_t firstLevel, uint32_t level,
+                   const LLGL::SrcImageDescriptor &imageDescriptor) {
+    LLGL::TextureRegion region{};
+    region.subresource.baseMipLevel = level - firstLevel;
+    region.subresource.numMipLevels = 1;
+    region.subresource.baseArrayLayer = 0;
+    region.subresource.numArrayLayers = 1;
+    region.offset = {0, 0, 0};
+    region.extent = {static_cast<uint32_t>(texture.getMipLevelWidth(level)),
+                     static_cast<uint32_t>(texture.getMipLevelHeight(level)), 1};
+    renderSystem->WriteTexture(llglTexture, region, imageDescriptor);
+}
+
+/**
+ * @return the blocks of one mip level of a block compressed texture
+ */
+LLGL::SrcImageDescriptor GetCompressedLevelImage(const DAsset::Texture &texture, uint32_t level) {
+    auto &levelBufferView = texture.getMipLevelBufferView(level);
+    uint64_t imageDataSize = GetCompressedLevelSize(texture, level);
+    if (levelBufferView.byteLength < imageDataSize ||
+        levelBufferView.byteOffset + imageDataSize > levelBufferView.buffer->data.size()) {
+        RAISE_EXCEPTION(errorhandling::IllegalArgumentException,
+                        "Cannot load texture from buffer view: "
+                        "Buffer view is smaller than the " + DAsset::GetTextureFormatName(texture.format) +
+                        " blocks of mip level " + std::to_string(level)
+        );
+    }
+    return LLGL::SrcImageDescriptor{
+            LLGL::ImageFormat::Compressed,
+            LLGL::DataType::UInt8,
+            &levelBufferView.buffer->data[levelBufferView.byteOffset],
+            imageDataSize
+    };
+}
+
+/**
+ * Decodes one PNG mip level of a texture to RGBA pixels
+ * @return the pixels, to be freed with stbi_image_free
+ */
+stbi_uc *DecodePNGLevel(const DAsset::Texture &texture, uint32_t level) {
+    auto &levelBufferView = texture.getMipLevelBufferView(level);
+    auto &levelBufferData = levelBufferView.buffer->data;
+    int32_t width{}, height{}, channels{};
+    auto imageData = stbi_load_from_memory(&levelBufferData[levelBufferView.byteOffset],
+                                           levelBufferView.byteLength, &width, &height, &channels, 4);
+    if (!imageData) {
+        RAISE_EXCEPTION(errorhandling::IllegalArgumentException,
+                        "Cannot load texture from buffer view: " +
+                        std::string(stbi_failure_reason())
+        );
+    }
+    if (texture.getMipLevelWidth(level) != width || texture.getMipLevelHeight(level) != height) {
+        stbi_image_free(imageData);
+        RAISE_EXCEPTION(errorhandling::IllegalArgumentException,
+                        "Cannot load texture from buffer view:"
+                        "Texture dimensions described in texture data do not match meta data"
+                        "MetadataDimensions: (width: " + std::to_string(texture.getMipLevelWidth(level)) +
+                        ", height:" + std::to_string(texture.getMipLevelHeight(level)) + ")"
+                        "TextureDataDimensions: (width:" + std::to_string(width) +
+                        ", height:" + std::to_string(height) + ")"
+        );
+    }
+    if (texture.channels != channels) {
+        stbi_image_free(imageData);
+        RAISE_EXCEPTION(errorhandling::IllegalArgumentException,
+                        "Cannot load texture from buffer view:"
+                        "Texture channels described in texture data do not match meta data"
+                        "MetadataChannels: " + std::to_string(texture.channels) +
+                        "TextureDataChannels: " + std::to_string(channels)
+        );
+    }
+    return imageData;
+}
+
+LLGL::SrcImageDescriptor GetDecodedLevelImage(const DAsset::Texture &texture, uint32_t level, stbi_uc *imageData) {
+    return LLGL::SrcImageDescriptor{
+            LLGL::ImageFormat::RGBA,
+            LLGL::DataType::UInt8,
+            imageData,
+            static_cast<size_t>(texture.getMipLevelWidth(level)) * texture.getMipLevelHeight(level) * 4 *
+            sizeof(uint8_t)
+    };
+}
+
+TextureUpload::DecodedTexture TextureUpload::DecodeTexture(const DAsset::Texture &texture, uint32_t firstLevel) {
+    if (texture.width <= 0 || texture.height <= 0) {
+        RAISE_EXCEPTION(errorhandling::IllegalArgumentException,
+                        "Cannot load texture from buffer view: "
+                        "Metadata texture dimensions are invalid"
+        );
+    }
+    if (firstLevel >= texture.getMipLevelCount()) {
+        RAISE_EXCEPTION(errorhandling::IllegalArgumentException,
+                        "Texture has no mip level " + std::to_string(firstLevel));
+    }
+    DecodedTexture decodedTexture{.firstLevel = firstLevel};
+    for (uint32_t level = firstLevel; level < texture.getMipLevelCount(); level++) {
+        // Block compressed textures are uploaded as they are, without decoding them on the CPU
+        if (texture.format != DAsset::TextureFormat::PNG) {
+            decodedTexture.levelImages.push_back(GetCompressedLevelImage(texture, level));
+            continue;
+        }
+        decodedTexture.pixels.emplace_back(DecodePNGLevel(texture, level), stbi_image_free);
+        decodedTexture.levelImages.push_back(GetDecodedLevelImage(texture, level,
+                                                                  decodedTexture.pixels.back().get()));
+    }
+    return decodedTexture;
+}
+
+LLGL::Texture *TextureUpload::UploadTexture(const std::shared_ptr<LLGL::RenderSystem> &renderSystem,
+                                            const DAsset::Texture &texture, const DecodedTexture &decodedTexture) {
+    uint32_t firstLevel = decodedTexture.firstLevel;
+    bool compressed = texture.format != DAsset::TextureFormat::PNG;
+    // Assets written before mip levels were stored only contain the full size image, its mips are generated.
+    // Drivers can not generate mips of block compressed textures, only the mips stored in the asset are used.
+    bool generateMips = !compressed && texture.getMipLevelCount() == 1;
+    LLGL::TextureDescriptor textureDescriptor{
+            .type = LLGL::TextureType::Texture2D,
+            .miscFlags = generateMips ? LLGL::MiscFlags::GenerateMips : 0u,
+            .format = compressed ? GetCompressedTextureFormat(texture.format) : LLGL::Format::RGBA8UNorm,
+            .extent = {static_cast<uint32_t>(texture.getMipLevelWidth(firstLevel)),
+                       static_cast<uint32_t>(texture.getMipLevelHeight(firstLevel)), 1},
+            .mipLevels = generateMips ? 0 : texture.getMipLevelCount() - firstLevel
+    };
+    LLGL::Texture *llglTexture = renderSystem->CreateTexture(textureDescriptor, &decodedTexture.levelImages[0]);
+    for (uint32_t level = firstLevel + 1; level < texture.getMipLevelCount(); level++) {
+        WriteMipLevel(renderSystem, *llglTexture, texture, firstLevel, level,
+                      decodedTexture.levelImages[level - firstLevel]);
+    }
+    return llglTexture;
+}
+
+LLGL::Texture *TextureUpload::CreateTexture(const std::shared_ptr<LLGL::RenderSystem> &renderSystem,
+                                            const DAsset::Texture &texture, uint32_t firstLevel) {
+    return UploadTexture(renderSystem, texture, DecodeTexture(texture, firstLevel));
+}
+
+uint32_t TextureUpload::GetBlockSize(const DAsset::Texture &texture) {
+    return texture.format == DAsset::TextureFormat::PNG ? 1 : 4;
+}
+
+uint64_t TextureUpload::GetMipLevelMemorySize(const DAsset::Texture &texture, uint32_t level) {
+    if (texture.format != DAsset::TextureFormat::PNG) {
+        return GetCompressedLevelSize(texture, level);
+    }
+    uint64_t size = static_cast<uint64_t>(texture.getMipLevelWidth(level)) * texture.getMipLevelHeight(level) * 4;
+    // Generated mips take another third
+    return texture.getMipLevelCount() == 1 ? size * 4 / 3 : size;
+}
@@ -0,0 +1,252 @@
+#include <gtest/gtest.h>
+#include "Dyngine/Rendering/Texture/TextureResidencyManager.hpp"
+#include "ErrorHandling/IllegalArgumentException.hpp"
+
+// Records the resident mip levels instead of uploading them
+class FakeStreamingBackend : public ITextureStreamingBackend {
+
+public:
+    std::map<uint64_t, uint32_t> firstResidentLevels{};
+    std::vector<std::pair<uint64_t, uint32_t>> calls{};
+    // Number of calls recorded when each batch of changes began
+    std::vector<size_t> changeBatches{};
+
+    void beginResidencyChanges() override {
+        changeBatches.push_back(calls.size());
+    }
+
+    void setResidentMipLevels(uint64_t textureId, uint32_t firstLevel) override {
+        firstResidentLevels[textureId] = firstLevel;
+        calls.emplace_back(textureId, firstLevel);
+    }
+
+};
+
+// Level sizes of an uncompressed RGBA texture with sides of 2^(nLevels - 1) pixels
+static std::vector<uint64_t> MakeLevelSizes(uint32_t nLevels) {
+    std::vector<uint64_t> levelSizes{};
+    for (uint32_t level = 0; level < nLevels; level++) {
+        uint64_t side = 1ull << (nLevels - 1 - level);
+        levelSizes.push_back(side * side * 4);
+    }
+    return levelSizes;
+}
+
+static TextureStreamingSettings MakeSettings(uint64_t memoryBudget, uint64_t uploadBudgetPerFrame) {
+    return {
+            .memoryBudget = memoryBudget,
+            .uploadBudgetPerFrame = uploadBudgetPerFrame,
+            .alwaysResidentSize = 64
+    };
+}
+
+TEST(TextureResidencyManager, OnlyLowMipsAreUploadedFirst) {
+    FakeStreamingBackend backend;
+    TextureResidencyManager manager(backend);
+    // 1024x1024, levels 4 (64x64) to 10 (1x1) are always resident
+    manager.addTexture(7, 1024, 1024, MakeLevelSizes(11));
+    EXPECT_EQ(4u, backend.firstResidentLevels.at(7));
+    EXPECT_EQ(4u, manager.getFirstResidentLevel(7));
+    uint64_t expectedBytes = 0;
+    for (uint32_t level = 4; level < 11; level++) {
+        expectedBytes += MakeLevelSizes(11)[level];
+    }
+    EXPECT_EQ(expectedBytes, manager.getResidentBytes());
+
+    // Textures smaller than the always resident size are resident completely
+    manager.addTexture(8, 32, 16, MakeLevelSizes(6));
+    EXPECT_EQ(0u, backend.firstResidentLevels.at(8));
+    EXPECT_THROW(manager.addTexture(8, 32, 16, MakeLevelSizes(6)), errorhandling::IllegalArgumentException);
+
+    // The same levels are known before adding a texture
+    EXPECT_EQ(4u, manager.getBaseLevel(1024, 1024, 11));
+    EXPECT_EQ(0u, manager.getBaseLevel(32, 16, 6));
+    // Textures without stored mips
+    EXPECT_EQ(0u, manager.getBaseLevel(1024, 1024, 1));
+}
+
+TEST(TextureResidencyManager, RequestedLevelsAreStreamedIn) {
+    FakeStreamingBackend backend;
+    TextureResidencyManager manager(backend);
+    manager.addTexture(1, 1024, 1024, MakeLevelSizes(11));
+    backend.calls.clear();
+
+    // Without requests nothing changes
+    EXPECT_FALSE(manager.update());
+    EXPECT_TRUE(backend.calls.empty());
+    EXPECT_TRUE(backend.changeBatches.empty());
+
+    manager.requestMipLevel(1, 2);
+    EXPECT_TRUE(manager.update());
+    ASSERT_EQ(1u, backend.calls.size());
+    EXPECT_EQ(2u, backend.calls[0].second);
+    EXPECT_EQ(2u, manager.getFirstResidentLevel(1));
+
+    // Resident levels stay when the texture is no longer requested and the budget is not exceeded
+    EXPECT_FALSE(manager.update());
+    EXPECT_EQ(2u, manager.getFirstResidentLevel(1));
+}
+
+TEST(TextureResidencyManager, UploadsAreLimitedPerFrame) {
+    FakeStreamingBackend backend;
+    // Level 2 of a 1024x1024 texture is 256 KiB, level 1 1 MiB and level 0 4 MiB
+    TextureResidencyManager manager(backend, MakeSettings(64ull * 1024 * 1024, 1024 * 1024));
+    manager.addTexture(1, 1024, 1024, MakeLevelSizes(11));
+
+    std::vector<uint32_t> firstLevels{};
+    for (int frame = 0; frame < 6; frame++) {
+        manager.requestMipLevel(1, 0);
+        manager.update();
+        firstLevels.push_back(manager.getFirstResidentLevel(1));
+    }
+    // Levels 3 and 2 fit into the first frame, each larger level takes its own frame,
+    // even when it alone exceeds the upload budget
+    EXPECT_EQ((std::vector<uint32_t>{2, 1, 0, 0, 0, 0}), firstLevels);
+}
+
+TEST(TextureResidencyManager, ReCreatedLevelsCountAgainstTheUploadBudget) {
+    FakeStreamingBackend backend;
+    auto levelSizes = MakeLevelSizes(11);
+    // Enough for levels 3 and 2 alone, but not for re-creating the texture with its always resident levels too
+    TextureResidencyManager manager(backend, MakeSettings(64ull * 1024 * 1024, levelSizes[3] + levelSizes[2]));
+    manager.addTexture(1, 1024, 1024, levelSizes);
+
+    manager.requestMipLevel(1, 2);
+    manager.update();
+    EXPECT_EQ(3u, manager.getFirstResidentLevel(1));
+    manager.requestMipLevel(1, 2);
+    manager.update();
+    EXPECT_EQ(2u, manager.getFirstResidentLevel(1));
+}
+
+TEST(TextureResidencyManager, BlockCompressedTexturesStartAtAlignedLevels) {
+    FakeStreamingBackend backend;
+    // Fits the whole 1024x1024 texture added below, but not the full size level of the other texture too
+    TextureResidencyManager manager(backend, MakeSettings(6ull * 1024 * 1024, 64ull * 1024 * 1024));
+    // 1000x1000, levels 1 (500x500) and 0 are the only ones with sides that are multiples of 4
+    std::vector<uint64_t> levelSizes{};
+    for (uint32_t level = 0; level < 10; level++) {
+        uint64_t blocks = (std::max(1000u >> level, 1u) + 3) / 4;
+        levelSizes.push_back(blocks * blocks * 16);
+    }
+    EXPECT_EQ(4u, manager.getBaseLevel(1000, 1000, 10));
+    EXPECT_EQ(1u, manager.getBaseLevel(1000, 1000, 10, 4));
+    // 1024x1024 is aligned down to 4x4 at level 8
+    EXPECT_EQ(4u, manager.getBaseLevel(1024, 1024, 11, 4));
+
+    manager.addTexture(1, 1000, 1000, levelSizes, 4);
+    EXPECT_EQ(1u, backend.firstResidentLevels.at(1));
+    EXPECT_EQ(1u, manager.getFirstResidentLevel(1));
+
+    // Streamed in and evicted again, down to the base level only
+    manager.requestMipLevel(1, 0);
+    manager.update();
+    EXPECT_EQ(0u, manager.getFirstResidentLevel(1));
+    manager.addTexture(2, 1024, 1024, MakeLevelSizes(11));
+    for (int frame = 0; frame < 3; frame++) {
+        manager.requestMipLevel(2, 0);
+        manager.update();
+    }
+    EXPECT_EQ(1u, manager.getFirstResidentLevel(1));
+    for (auto &[textureId, firstLevel]: backend.calls) {
+        if (textureId == 1) {
+            EXPECT_LE(firstLevel, 1u);
+        }
+    }
+}
+
+TEST(TextureResidencyManager, LeastRecentlyUsedTexturesAreEvictedFirst) {
+    FakeStreamingBackend backend;
+    auto levelSizes = MakeLevelSizes(9);
+    // 256x256 textures, levels 2 to 8 are always resident
+    uint64_t baseBytes = 0;
+    for (uint32_t level = 2; level < 9; level++) {
+        baseBytes += levelSizes[level];
+    }
+    // Room for the base levels of 3 textures and level 1 of two of them
+    uint64_t budget = 3 * baseBytes + 2 * levelSizes[1];
+    TextureResidencyManager manager(backend, MakeSettings(budget, budget));
+    for (uint64_t textureId = 0; textureId < 3; textureId++) {
+        manager.addTexture(textureId, 256, 256, levelSizes);
+    }
+
+    manager.requestMipLevel(0, 1);
+    manager.update();
+    manager.requestMipLevel(1, 1);
+    manager.update();
+    EXPECT_EQ(1u, manager.getFirstResidentLevel(0));
+    EXPECT_EQ(1u, manager.getFirstResidentLevel(1));
+
+    // Texture 0 was used longest ago and makes room for texture 2
+    backend.calls.clear();
+    backend.changeBatches.clear();
+    manager.requestMipLevel(2, 1);
+    EXPECT_TRUE(manager.update());
+    EXPECT_EQ(2u, manager.getFirstResidentLevel(0));
+    EXPECT_EQ(1u, manager.getFirstResidentLevel(1));
+    EXPECT_EQ(1u, manager.getFirstResidentLevel(2));
+    EXPECT_LE(manager.getResidentBytes(), budget);
+    // The eviction is passed to the backend before the upload, both after the batch of changes began
+    EXPECT_EQ(std::vector<size_t>{0}, backend.changeBatches);
+    ASSERT_EQ(2u, backend.calls.size());
+    EXPECT_EQ(std::make_pair(uint64_t(0), 2u), backend.calls[0]);
+    EXPECT_EQ(std::make_pair(uint64_t(2), 1u), backend.calls[1]);
+}
+
+TEST(TextureResidencyManager, TexturesInUseAreNotEvicted) {
+    FakeStreamingBackend backend;
+    auto levelSizes = MakeLevelSizes(9);
+    uint64_t baseBytes = 0;
+    for (uint32_t level = 2; level < 9; level++) {
+        baseBytes += levelSizes[level];
+    }
+    uint64_t budget = 2 * baseBytes + levelSizes[1];
+    TextureResidencyManager manager(backend, MakeSettings(budget, budget));
+    manager.addTexture(0, 256, 256, levelSizes);
+    manager.addTexture(1, 256, 256, levelSizes);
+
+    manager.requestMipLevel(0, 1);
+    manager.update();
+    // Both textures are drawn, so texture 1 has to wait until texture 0 is no longer needed
+    for (int frame = 0; frame < 3; frame++) {
+        manager.requestMipLevel(0, 1);
+        manager.requestMipLevel(1, 1);
+        manager.update();
+        EXPECT_EQ(1u, manager.getFirstResidentLevel(0));
+        EXPECT_EQ(2u, manager.getFirstResidentLevel(1));
+    }
+    // Levels sharper than a drawn texture needs are evicted though
+    manager.requestMipLevel(0, 2);
+    manager.requestMipLevel(1, 1);
+    manager.update();
+    EXPECT_EQ(2u, manager.getFirstResidentLevel(0));
+    EXPECT_EQ(1u, manager.getFirstResidentLevel(1));
+    EXPECT_LE(manager.getResidentBytes(), budget);
+}
+
+TEST(TextureResidencyManager, RemovedTexturesFreeTheirBudget) {
+    FakeStreamingBackend backend;
+    TextureResidencyManager manager(backend);
+    manager.addTexture(1, 1024, 1024, MakeLevelSizes(11));
+    manager.addTexture(2, 1024, 1024, MakeLevelSizes(11));
+    manager.requestMipLevel(1, 0);
+    manager.update();
+    uint64_t bytes = manager.getResidentBytes();
+    manager.removeTexture(1);
+    EXPECT_LT(manager.getResidentBytes(), bytes - MakeLevelSizes(11)[0]);
+    EXPECT_THROW(manager.requestMipLevel(1, 0), errorhandling::IllegalArgumentException);
+}
+
+TEST(TextureResidencyManager, WantedMipLevel) {
+    // Drawn at full size or larger
+    EXPECT_EQ(0u, TextureResidencyManager::GetWantedMipLevel(1024, 512, 11, 1024));
+    EXPECT_EQ(0u, TextureResidencyManager::GetWantedMipLevel(1024, 512, 11, 3000));
+    // Level 1 has 512 texels, still one per pixel
+    EXPECT_EQ(1u, TextureResidencyManager::GetWantedMipLevel(1024, 512, 11, 400));
+    EXPECT_EQ(2u, TextureResidencyManager::GetWantedMipLevel(1024, 512, 11, 256));
+    // Tiny and off screen textures only need their last level
+    EXPECT_EQ(10u, TextureResidencyManager::GetWantedMipLevel(1024, 512, 11, 0.5f));
+    EXPECT_EQ(10u, TextureResidencyManager::GetWantedMipLevel(1024, 512, 11, 0));
+    // Textures without stored mips
+    EXPECT_EQ(0u, TextureResidencyManager::GetWantedMipLevel(1024, 512, 1, 16));
+}
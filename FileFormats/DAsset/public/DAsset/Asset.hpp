@@ -6,8 +6,12 @@
 #include <optional>
 #include <glm/glm.hpp>
 #include <glm/gtc/quaternion.hpp>
+#include <DAsset/ByteSpan.hpp>
 #include <Stream/FileDataWriteStream.hpp>
+#include <Stream/DataReadStream.hpp>
 #include <map>
+#include <mutex>
+#include <unordered_map>
 
 namespace DAsset {
 
@@ -32,21 +36,108 @@ namespace DAsset {
         MAT4
     };
 
+    /**
+     * Where the buffers of a lazily read asset read their payloads from when they are loaded.
+     * Either a stream shared by all buffers of the asset, so reads are serialized,
+     * or the asset's bytes in memory, of which payloads are slices without copies.
+     */
+    class PayloadSource {
+
+    private:
+        std::unique_ptr<Stream::DataReadStream> stream;
+        // The whole asset, if it is in memory
+        std::optional<ByteSpan> memory;
+        std::mutex mutex;
+
+    public:
+        explicit PayloadSource(std::unique_ptr<Stream::DataReadStream> stream);
+
+        explicit PayloadSource(const ByteSpan &memory);
+
+        /**
+         * The stream the metadata of the asset is read from, before any buffer is loaded
+         */
+        [[nodiscard]] const std::unique_ptr<Stream::DataReadStream> &getStream() const;
+
+        /**
+         * Locks the source, which buffers hold while they are loaded or unloaded
+         */
+        std::unique_lock<std::mutex> lock();
+
+        /**
+         * To be called while holding the lock
+         * @param position the position of the payload in the stream
+         */
+        ByteSpan read(uint64_t position, uint64_t size);
+    };
+
     struct Buffer {
         uint64_t bufferId;
-        std::vector<uint8_t> data;
-
-        Buffer(uint64_t bufferId, const std::vector<uint8_t> &data);
+        // The payload, empty while the buffer of a lazily read asset is not loaded
+        ByteSpan data;
+
+        Buffer(uint64_t bufferId, ByteSpan data);
+
+        /**
+         * A buffer whose payload is read from the source when it is loaded
+         */
+        Buffer(uint64_t bufferId, const std::shared_ptr<PayloadSource> &payloadSource, uint64_t payloadPosition,
+               uint64_t payloadSize);
+
+        /**
+         * Safe to call while other threads load or unload the buffer
+         */
+        [[nodiscard]] bool isLoaded() const;
+
+        /**
+         * Reads the payload into data if the buffer is not loaded yet.
+         * Any buffers of an asset, also the same one, may be loaded concurrently, loads are serialized by the source.
+         */
+        void load();
+
+        /**
+         * Drops the payload of a lazily read buffer, it is read again on the next load.
+         * Must not be called while other threads use data.
+         */
+        void unload();
+
+        /**
+         * Safe to call while other threads load or unload the buffer
+         * @return the size of the payload, also while it is not loaded
+         */
+        [[nodiscard]] uint64_t getSize() const;
+
+    private:
+        std::shared_ptr<PayloadSource> payloadSource;
+        uint64_t payloadPosition = 0;
+        uint64_t payloadSize = 0;
+        bool loaded = true;
     };
 
     struct BufferCollection {
         std::vector<std::shared_ptr<Buffer>> buffers;
-
+        // Key: id of a buffer not stored at the index equal to its id, value: its index
+        std::unordered_map<uint64_t, uint64_t> sparseIdIndices;
+        // Whether sparseIdIndices was built, lookups search linearly until then
+        bool idsIndexed = false;
+
+        /**
+         * @return the index of the buffer with the same id
+         */
         std::optional<uint64_t> find(const DAsset::Buffer &buffer) const;
 
         std::optional<std::shared_ptr<Buffer>> getBuffer(uint64_t bufferId) const;
 
+        /**
+         * Adds a buffer whose id is its index
+         */
         std::shared_ptr<Buffer> newBuffer(const uint8_t *data, size_t length);
+
+        /**
+         * Indexes the ids of buffers not stored at the index equal to their id, to be called after changing buffers.
+         * Afterwards, ids missing in the index are reported as not found without a linear search.
+         */
+        void indexIds();
     };
 
     struct BufferView {
@@ -66,11 +157,27 @@ namespace DAsset {
         REPEAT, MIRROR, CLAMP, BORDER, MIRROR_ONCE
     };
 
+    /**
+     * Encoding of the image in a texture's buffer view
+     */
+    enum class TextureFormat {
+        // A PNG file, decoded when the texture is loaded
+        PNG,
+        // 4x4 pixel blocks of 8 bytes, one channel
+        BC4,
+        // 4x4 pixel blocks of 16 bytes, two channels
+        BC5,
+        // 4x4 pixel blocks of 16 bytes, four channels
+        BC7
+    };
+
     struct Texture {
         uint64_t textureId;
         int32_t width, height;
+        // Channels of the image, for block compressed formats the channels of the format
         int32_t channels;
         uint32_t bitDepth;
+        TextureFormat format = TextureFormat::PNG;
         SamplerFilter minFilter;
         SamplerFilter magFilter;
         SamplerFilter mipMapFilter;
@@ -80,17 +187,54 @@ namespace DAsset {
 
         Texture(uint64_t textureId);
 
+        // The full size image, mip level 0
         BufferView bufferView;
+        // Mip levels 1 to n in the texture's format, each half as wide and high as the level before, down to 1x1.
+        // Empty if the mips are generated when the texture is loaded.
+        std::vector<BufferView> mipLevelBufferViews;
+
+        /**
+         * @return the number of mip levels stored in the texture, 1 if only the full size image is stored
+         */
+        uint32_t getMipLevelCount() const;
+
+        /**
+         * @param level 0 for the full size image
+         */
+        const BufferView &getMipLevelBufferView(uint32_t level) const;
+
+        /**
+         * @return the width and height of a mip level, at least 1 pixel
+         */
+        int32_t getMipLevelWidth(uint32_t level) const;
+
+        int32_t getMipLevelHeight(uint32_t level) const;
     };
 
     struct TextureCollection {
         std::vector<std::shared_ptr<Texture>> textures;
+        // Key: id of a texture not stored at the index equal to its id, value: its index
+        std::unordered_map<uint64_t, uint64_t> sparseIdIndices;
+        // Whether sparseIdIndices was built, lookups search linearly until then
+        bool idsIndexed = false;
 
         std::optional<std::shared_ptr<Texture>> getTexture(uint64_t textureId) const;
 
+        /**
+         * @return the index of the texture with the same id
+         */
         std::optional<uint64_t> find(const DAsset::Texture &texture) const;
 
+        /**
+         * Adds a texture whose id is its index
+         */
         std::shared_ptr<Texture> newTexture();
+
+        /**
+         * Indexes the ids of textures not stored at the index equal to their id, to be called after changing textures.
+         * Afterwards, ids missing in the index are reported as not found without a linear search.
+         */
+        void indexIds();
     };
 
     struct Material {
@@ -111,12 +255,28 @@ namespace DAsset {
 
     struct MaterialCollection {
         std::vector<std::shared_ptr<Material>> materials;
+        // Key: id of a material not stored at the index equal to its id, value: its index
+        std::unordered_map<uint64_t, uint64_t> sparseIdIndices;
+        // Whether sparseIdIndices was built, lookups search linearly until then
+        bool idsIndexed = false;
 
         std::optional<std::shared_ptr<Material>> getMaterial(uint64_t materialId) const;
 
+        /**
+         * @return the index of the material with the same id
+         */
         std::optional<uint64_t> find(const Material &material) const;
 
+        /**
+         * Adds a material whose id is its index
+         */
         std::shared_ptr<Material> newMaterial();
+
+        /**
+         * Indexes the ids of materials not stored at the index equal to their id, to be called after changing
+         * materials. Afterwards, ids missing in the index are reported as not found without a linear search.
+         */
+        void indexIds();
     };
 
 
@@ -167,10 +327,40 @@ namespace DAsset {
         MaterialCollection materialCollection;
     };
 
-    void WriteAsset(const Asset &asset, const std::unique_ptr<Stream::DataWriteStream> &stream);
-
+    /**
+     * Writes the asset in the current .dasset format version.
+     * A table of contents with the offset and size of each section and buffer follows the header,
+     * the metadata sections come before the buffer payloads.
+     * @throws IllegalStateException if a buffer of a lazily read asset is not loaded
+     * @param byteOrder the byte order of the values in the file.
+     * Little-endian by default, which lets little-endian hosts read and write without byte swapping.
+     */
+    void WriteAsset(const Asset &asset, const std::unique_ptr<Stream::DataWriteStream> &stream,
+                    Stream::ByteOrder byteOrder = Stream::ByteOrder::LITTLE);
+
+    /**
+     * Reads an asset of any .dasset format version, including big-endian files written before the format had a header
+     */
     DAsset::Asset ReadAsset(const std::unique_ptr<Stream::DataReadStream> &stream);
 
+    /**
+     * Reads an asset of any .dasset format version from memory, like a mapped file or a decompressed archive entry.
+     * The buffers are slices of the asset's bytes and keep them alive, their payloads are not copied.
+     */
+    DAsset::Asset ReadAsset(const ByteSpan &assetBytes);
+
+    /**
+     * Reads the textures, materials and nodes of an asset of any .dasset format version, but no buffer payloads.
+     * Buffers read their payloads from the stream when they are loaded, the stream has to support seeking.
+     * Version 4 files are read through their table of contents, older files are scanned past the payloads.
+     */
+    DAsset::Asset ReadAssetLazily(std::unique_ptr<Stream::DataReadStream> stream);
+
+    /**
+     * Reads the metadata of an asset in memory, its buffers become slices of the asset's bytes when they are loaded
+     */
+    DAsset::Asset ReadAssetLazily(const ByteSpan &assetBytes);
+
     std::string GetAttributeTypeName(const AttributeType type);
 
     std::string GetDataTypeName(const DataType type);
@@ -186,4 +376,6 @@ namespace DAsset {
     std::string GetTextureAddressModeName(SamplerAddressMode mode);
 
     std::string GetTextureFilterName(SamplerFilter filter);
+
+    std::string GetTextureFormatName(TextureFormat format);
 }
\ No newline at end of file
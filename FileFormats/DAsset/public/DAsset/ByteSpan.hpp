@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace DAsset {
+
+    /**
+     * Read-only bytes that keep the memory they point into alive.
+     * The memory belongs to an owner shared by all spans of it, like an owned vector, a mapped file or a
+     * decompressed archive entry, so spans are copied and sliced without copying any bytes.
+     */
+    class ByteSpan {
+
+    private:
+        std::shared_ptr<const void> owner;
+        const uint8_t *bytes = nullptr;
+        size_t length = 0;
+
+    public:
+        ByteSpan() = default;
+
+        /**
+         * Takes ownership of the vector without copying its bytes, implicit so vectors can be moved into spans
+         */
+        ByteSpan(std::vector<uint8_t> &&bytes);
+
+        /**
+         * @param owner keeps the bytes alive as long as any span of them exists
+         */
+        ByteSpan(std::shared_ptr<const void> owner, const uint8_t *bytes, size_t length);
+
+        static ByteSpan CopyOf(const uint8_t *bytes, size_t length);
+
+        /**
+         * @return a span of part of the bytes, sharing their owner
+         * @throws IllegalArgumentException if the part is not within the span
+         */
+        [[nodiscard]] ByteSpan slice(size_t offset, size_t sliceLength) const;
+
+        [[nodiscard]] const uint8_t *data() const;
+
+        [[nodiscard]] size_t size() const;
+
+        [[nodiscard]] bool empty() const;
+
+        [[nodiscard]] const uint8_t *begin() const;
+
+        [[nodiscard]] const uint8_t *end() const;
+
+        const uint8_t &operator[](size_t index) const;
+
+        /**
+         * @return a copy of the bytes
+         */
+        [[nodiscard]] std::vector<uint8_t> toVector() const;
+    };
+
+}
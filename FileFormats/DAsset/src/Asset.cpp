@@ -1,7 +1,48 @@
 #include <DAsset/Asset.hpp>
 #include "ErrorHandling/IllegalArgumentException.hpp"
 #include <ErrorHandling/IllegalStateException.hpp>
+#include <Stream/MemoryDataStream.hpp>
+#include <Stream/Record.hpp>
+#include <functional>
 #include <optional>
+#include <cstring>
+#include <algorithm>
+#include <unordered_map>
+
+// Files start with this magic, followed by the 8-bit format version and the 8-bit Stream::ByteOrder of all values.
+// Files written before the header existed start with their big-endian 64-bit buffer count instead,
+// which can not be this large.
+static const uint8_t DASSET_MAGIC[8] = {'D', 'A', 'S', 'S', 'E', 'T', 0, 0};
+
+// Version 2 added the format of textures
+// Version 3 added the mip levels of textures
+// Version 4 added the table of contents and moved the buffer payloads behind the metadata sections
+#define DASSET_FORMAT_VERSION 4
+
+// Buffer payloads of version 4 files start at a multiple of this many bytes from the start of the asset
+#define DASSET_PAYLOAD_ALIGNMENT 16
+
+// Metadata sections of version 4 files. Readers skip sections of types they do not know.
+enum class SectionType : uint8_t {
+    TEXTURES = 1,
+    MATERIALS = 2,
+    NODES = 3
+};
+
+// Offsets are from the start of the asset, the position of its magic
+struct TableOfContents {
+    // Key: section type, value: offset and size of the section
+    std::map<uint8_t, std::pair<uint64_t, uint64_t>> sections;
+
+    struct BufferEntry {
+        uint64_t bufferId;
+        uint64_t offset;
+        uint64_t size;
+    };
+
+    // In the order of the buffer collection
+    std::vector<BufferEntry> buffers;
+};
 
 void WriteBufferView(const DAsset::BufferCollection &bufferCollection, const DAsset::BufferView &bufferView,
                      const std::unique_ptr<Stream::DataWriteStream> &stream) {
@@ -77,14 +118,20 @@ void WriteNode(const DAsset::BufferCollection &bufferCollection, const DAsset::M
     }
 }
 
-void WriteBufferCollection(const DAsset::BufferCollection &collection,
-                           const std::unique_ptr<Stream::DataWriteStream> &stream) {
-    stream->writeInt64(collection.buffers.size());
-    for (const auto &buffer: collection.buffers) {
-        stream->writeInt64(buffer->bufferId);
-        stream->writeInt64(buffer->data.size());
-        stream->writeBuffer(buffer->data.data(), buffer->data.size());
-    }
+std::vector<uint8_t> WriteSection(Stream::ByteOrder byteOrder,
+                                  const std::function<void(const std::unique_ptr<Stream::DataWriteStream> &)> &write) {
+    auto memoryWriteStream = Stream::MemoryWriteStream::Growable();
+    auto *sectionData = memoryWriteStream.get();
+    std::unique_ptr<Stream::DataWriteStream> stream(std::move(memoryWriteStream));
+    stream->setByteOrder(byteOrder);
+    write(stream);
+    return sectionData->releaseBuffer();
+}
+
+uint64_t GetTableOfContentsSize(uint64_t sectionCount, uint64_t bufferCount) {
+    // Section count, type, offset and size of each section, buffer count, id, offset and size of each buffer
+    return sizeof(uint32_t) + sectionCount * (sizeof(uint8_t) + 2 * sizeof(uint64_t)) +
+           sizeof(uint64_t) + bufferCount * 3 * sizeof(uint64_t);
 }
 
 void WriteTextureCollection(const DAsset::BufferCollection &bufferCollection,
@@ -103,7 +150,12 @@ void WriteTextureCollection(const DAsset::BufferCollection &bufferCollection,
         stream->writeInt8(texture->addressModeU);
         stream->writeInt8(texture->addressModeV);
         stream->writeInt8(texture->addressModeW);
+        stream->writeInt8(static_cast<int8_t>(texture->format));
         WriteBufferView(bufferCollection, texture->bufferView, stream);
+        stream->writeInt32(static_cast<int32_t>(texture->mipLevelBufferViews.size()));
+        for (const auto &mipLevelBufferView: texture->mipLevelBufferViews) {
+            WriteBufferView(bufferCollection, mipLevelBufferView, stream);
+        }
     }
 }
 
@@ -143,32 +195,80 @@ void WriteMaterialCollection(const DAsset::MaterialCollection &materialCollectio
     }
 }
 
-void DAsset::WriteAsset(const DAsset::Asset &asset, const std::unique_ptr<Stream::DataWriteStream> &stream) {
-    WriteBufferCollection(asset.bufferCollection, stream);
-    WriteTextureCollection(asset.bufferCollection, asset.textureCollection, stream);
-    WriteMaterialCollection(asset.materialCollection, asset.textureCollection, stream);
-    WriteNode(asset.bufferCollection, asset.materialCollection, asset.rootNode, stream);
+void DAsset::WriteAsset(const DAsset::Asset &asset, const std::unique_ptr<Stream::DataWriteStream> &stream,
+                        Stream::ByteOrder byteOrder) {
+    const auto &buffers = asset.bufferCollection.buffers;
+    for (const auto &buffer: buffers) {
+        if (!buffer->isLoaded()) {
+            RAISE_EXCEPTION(errorhandling::IllegalStateException,
+                            "Buffer " + std::to_string(buffer->bufferId) + " is not loaded");
+        }
+    }
+
+    // The sections are serialized first, the table of contents gives their sizes
+    std::vector<std::pair<SectionType, std::vector<uint8_t>>> sections;
+    sections.emplace_back(SectionType::TEXTURES, WriteSection(byteOrder, [&](const auto &sectionStream) {
+        WriteTextureCollection(asset.bufferCollection, asset.textureCollection, sectionStream);
+    }));
+    sections.emplace_back(SectionType::MATERIALS, WriteSection(byteOrder, [&](const auto &sectionStream) {
+        WriteMaterialCollection(asset.materialCollection, asset.textureCollection, sectionStream);
+    }));
+    sections.emplace_back(SectionType::NODES, WriteSection(byteOrder, [&](const auto &sectionStream) {
+        WriteNode(asset.bufferCollection, asset.materialCollection, asset.rootNode, sectionStream);
+    }));
+
+    stream->writeBuffer(DASSET_MAGIC, sizeof(DASSET_MAGIC));
+    stream->writeUint8(DASSET_FORMAT_VERSION);
+    stream->writeUint8(static_cast<uint8_t>(byteOrder));
+
+    Stream::ByteOrderScope byteOrderScope(*stream, byteOrder);
+    uint64_t position = sizeof(DASSET_MAGIC) + 2 * sizeof(uint8_t) +
+                        GetTableOfContentsSize(sections.size(), buffers.size());
+    stream->writeUint32(static_cast<uint32_t>(sections.size()));
+    for (const auto &[sectionType, sectionData]: sections) {
+        stream->writeUint8(static_cast<uint8_t>(sectionType));
+        stream->writeUint64(position);
+        stream->writeUint64(sectionData.size());
+        position += sectionData.size();
+    }
+    stream->writeUint64(buffers.size());
+    std::vector<uint64_t> paddings;
+    for (const auto &buffer: buffers) {
+        uint64_t offset = (position + DASSET_PAYLOAD_ALIGNMENT - 1) / DASSET_PAYLOAD_ALIGNMENT *
+                          DASSET_PAYLOAD_ALIGNMENT;
+        paddings.push_back(offset - position);
+        stream->writeInt64(buffer->bufferId);
+        stream->writeUint64(offset);
+        stream->writeUint64(buffer->data.size());
+        position = offset + buffer->data.size();
+    }
+
+    for (const auto &[sectionType, sectionData]: sections) {
+        stream->writeBuffer(sectionData.data(), sectionData.size());
+    }
+    static const uint8_t padding[DASSET_PAYLOAD_ALIGNMENT] = {};
+    for (uint64_t bufferIndex = 0; bufferIndex < buffers.size(); bufferIndex++) {
+        stream->writeBuffer(padding, paddings[bufferIndex]);
+        stream->writeBuffer(buffers[bufferIndex]->data.data(), buffers[bufferIndex]->data.size());
+    }
 }
 
 DAsset::BufferView
 ReadBufferView(const DAsset::BufferCollection &bufferCollection,
                const std::unique_ptr<Stream::DataReadStream> &stream) {
     DAsset::BufferView bufferView{};
-    bufferView.byteOffset = stream->readInt64();
-    bufferView.byteLength = stream->readInt64();
-    bufferView.byteStride = stream->readInt64();
-    bufferView.dataType = static_cast<DAsset::DataType>(stream->readInt8());
-    bufferView.componentType = static_cast<DAsset::ComponentType>(stream->readInt8());
-    uint64_t bufferIndex = stream->readInt64();
+    auto [byteOffset, byteLength, byteStride, dataType, componentType, bufferIndex] =
+            Stream::ReadRecord<int64_t, int64_t, int64_t, int8_t, int8_t, uint64_t>(*stream);
+    bufferView.byteOffset = byteOffset;
+    bufferView.byteLength = byteLength;
+    bufferView.byteStride = byteStride;
+    bufferView.dataType = static_cast<DAsset::DataType>(dataType);
+    bufferView.componentType = static_cast<DAsset::ComponentType>(componentType);
+    // References are the index of the buffer in the collection, not its id
     if (bufferIndex >= bufferCollection.buffers.size()) {
         RAISE_EXCEPTION(errorhandling::IllegalStateException, "Mesh references unknown buffer");
     }
-    auto bufferOpt = bufferCollection.getBuffer(bufferIndex);
-    if (!bufferOpt.has_value()) {
-        RAISE_EXCEPTION(errorhandling::IllegalStateException, "Mesh references unknown buffer");
-    }
-    auto buffer = bufferOpt.value();
-    bufferView.buffer = buffer;
+    bufferView.buffer = bufferCollection.buffers[bufferIndex];
     return bufferView;
 }
 
@@ -190,12 +290,11 @@ ReadMesh(const DAsset::BufferCollection &bufferCollection, const DAsset::Materia
             meshPart.attributeBufferViews[attributeType] = ReadBufferView(bufferCollection, stream);
         }
         // Read material reference
-        auto materialIndex = stream->readInt64();
-        auto materialOpt = materialCollection.getMaterial(materialIndex);
-        if (!materialOpt.has_value()) {
+        uint64_t materialIndex = stream->readInt64();
+        if (materialIndex >= materialCollection.materials.size()) {
             RAISE_EXCEPTION(errorhandling::IllegalStateException, "MeshPart references unknown material");
         }
-        meshPart.material = materialOpt.value();
+        meshPart.material = materialCollection.materials[materialIndex];
     }
     return mesh;
 }
@@ -205,16 +304,15 @@ ReadNode(const DAsset::BufferCollection &bufferCollection, const DAsset::Materia
          const std::unique_ptr<Stream::DataReadStream> &stream) {
     DAsset::Node node{};
     node.name = stream->readString();
-    node.translation.x = stream->readFloat32();
-    node.translation.y = stream->readFloat32();
-    node.translation.z = stream->readFloat32();
-    node.rotation.x = stream->readFloat32();
-    node.rotation.y = stream->readFloat32();
-    node.rotation.z = stream->readFloat32();
-    node.rotation.w = stream->readFloat32();
-    node.scale.x = stream->readFloat32();
-    node.scale.y = stream->readFloat32();
-    node.scale.z = stream->readFloat32();
+    // Translation, rotation and scale
+    float transform[10];
+    stream->readFloat32Array(transform, 10);
+    node.translation = {transform[0], transform[1], transform[2]};
+    node.rotation.x = transform[3];
+    node.rotation.y = transform[4];
+    node.rotation.z = transform[5];
+    node.rotation.w = transform[6];
+    node.scale = {transform[7], transform[8], transform[9]};
     node.mesh = ReadMesh(bufferCollection, materialCollection, stream);
     auto nChildren = stream->readInt64();
     for (uint64_t i = 0; i < nChildren; ++i) {
@@ -223,55 +321,76 @@ ReadNode(const DAsset::BufferCollection &bufferCollection, const DAsset::Materia
     return node;
 }
 
-DAsset::BufferCollection ReadBufferCollection(const std::unique_ptr<Stream::DataReadStream> &stream) {
-    auto bufferCount = stream->readInt64();
+void ReadPayload(const std::unique_ptr<Stream::DataReadStream> &stream, uint8_t *data, uint64_t size) {
+    if (stream->read(data, size) != size) {
+        RAISE_EXCEPTION(errorhandling::IllegalStateException, "Asset ends within a buffer payload");
+    }
+}
+
+// Buffers of files before version 4, each followed by its payload.
+// Without a payload source the payloads are read, otherwise they are skipped and read when the buffers are loaded.
+DAsset::BufferCollection ReadBufferCollection(uint64_t bufferCount,
+                                              const std::unique_ptr<Stream::DataReadStream> &stream,
+                                              const std::shared_ptr<DAsset::PayloadSource> &payloadSource) {
     DAsset::BufferCollection collection;
     collection.buffers = std::vector<std::shared_ptr<DAsset::Buffer>>(bufferCount);
     for (uint64_t bufferIndex = 0u; bufferIndex < bufferCount; ++bufferIndex) {
         auto bufferId = stream->readInt64();
         auto bufferSize = stream->readInt64();
+        if (payloadSource != nullptr) {
+            collection.buffers[bufferIndex] = std::make_shared<DAsset::Buffer>(bufferId, payloadSource,
+                                                                               stream->getPosition(), bufferSize);
+            stream->skip(bufferSize);
+            continue;
+        }
         auto data = std::vector<uint8_t>(bufferSize);
-        stream->read(data.data(), bufferSize);
-        collection.buffers[bufferIndex] = std::make_shared<DAsset::Buffer>(bufferId, data);
+        ReadPayload(stream, data.data(), bufferSize);
+        collection.buffers[bufferIndex] = std::make_shared<DAsset::Buffer>(bufferId, std::move(data));
     }
+    collection.indexIds();
     return collection;
 }
 
-DAsset::TextureCollection ReadTextureCollection(const DAsset::BufferCollection &bufferCollection,
+DAsset::TextureCollection ReadTextureCollection(const DAsset::BufferCollection &bufferCollection, uint8_t version,
                                                 const std::unique_ptr<Stream::DataReadStream> &stream) {
     auto textureCount = stream->readInt64();
     DAsset::TextureCollection textureCollection{};
     textureCollection.textures = std::vector<std::shared_ptr<DAsset::Texture>>(textureCount);
     for (uint64_t textureIndex = 0u; textureIndex < textureCount; ++textureIndex) {
-        auto textureId = stream->readInt64();
-        auto width = stream->readInt32();
-        auto height = stream->readInt32();
-        auto channels = stream->readInt32();
-        auto bitDepth = stream->readInt32();
-        auto minFilter = static_cast<DAsset::SamplerFilter>(stream->readInt8());
-        auto magFilter = static_cast<DAsset::SamplerFilter>(stream->readInt8());
-        auto mipMapFilter = static_cast<DAsset::SamplerFilter>(stream->readInt8());
-
-        auto addressModeU = static_cast<DAsset::SamplerAddressMode>(stream->readInt8());
-        auto addressModeV = static_cast<DAsset::SamplerAddressMode>(stream->readInt8());
-        auto addressModeW = static_cast<DAsset::SamplerAddressMode>(stream->readInt8());
-
-        auto dataSize = width * height * channels * (bitDepth / 8);
+        auto [textureId, width, height, channels, bitDepth, minFilter, magFilter, mipMapFilter,
+              addressModeU, addressModeV, addressModeW] =
+                Stream::ReadRecord<int64_t, int32_t, int32_t, int32_t, int32_t, int8_t, int8_t, int8_t,
+                                   int8_t, int8_t, int8_t>(*stream);
+        // Textures were always PNG files before version 2
+        auto format = version >= 2 ? static_cast<DAsset::TextureFormat>(stream->readInt8())
+                                   : DAsset::TextureFormat::PNG;
+
         auto bufferView = ReadBufferView(bufferCollection, stream);
+        // Mips were always generated when loading before version 3
+        std::vector<DAsset::BufferView> mipLevelBufferViews;
+        if (version >= 3) {
+            auto nMipLevels = stream->readInt32();
+            for (int32_t level = 0; level < nMipLevels; level++) {
+                mipLevelBufferViews.push_back(ReadBufferView(bufferCollection, stream));
+            }
+        }
         auto texture = std::make_shared<DAsset::Texture>(textureId);
         texture->width = width;
         texture->height = height;
         texture->channels = channels;
         texture->bitDepth = bitDepth;
+        texture->format = format;
         texture->bufferView = bufferView;
-        texture->minFilter = minFilter;
-        texture->magFilter = magFilter;
-        texture->mipMapFilter = mipMapFilter;
-        texture->addressModeU = addressModeU;
-        texture->addressModeV = addressModeV;
-        texture->addressModeW = addressModeW;
+        texture->mipLevelBufferViews = std::move(mipLevelBufferViews);
+        texture->minFilter = static_cast<DAsset::SamplerFilter>(minFilter);
+        texture->magFilter = static_cast<DAsset::SamplerFilter>(magFilter);
+        texture->mipMapFilter = static_cast<DAsset::SamplerFilter>(mipMapFilter);
+        texture->addressModeU = static_cast<DAsset::SamplerAddressMode>(addressModeU);
+        texture->addressModeV = static_cast<DAsset::SamplerAddressMode>(addressModeV);
+        texture->addressModeW = static_cast<DAsset::SamplerAddressMode>(addressModeW);
         textureCollection.textures[textureIndex] = texture;
     }
+    textureCollection.indexIds();
     return textureCollection;
 }
 
@@ -281,12 +400,11 @@ std::optional<std::shared_ptr<DAsset::Texture>> ReadOptionalTexture(const DAsset
     if (optionalState == 0) {
         return std::nullopt;
     }
-    auto textureId = stream->readInt64();
-    auto textureOpt = textureCollection.getTexture(textureId);
-    if (!textureOpt.has_value()) {
+    uint64_t textureIndex = stream->readInt64();
+    if (textureIndex >= textureCollection.textures.size()) {
         RAISE_EXCEPTION(errorhandling::IllegalStateException, "Texture references unknown texture");
     }
-    return textureOpt;
+    return textureCollection.textures[textureIndex];
 }
 
 DAsset::MaterialCollection ReadMaterialCollection(const DAsset::TextureCollection &textureCollection,
@@ -300,33 +418,170 @@ DAsset::MaterialCollection ReadMaterialCollection(const DAsset::TextureCollectio
 
         auto material = std::make_shared<DAsset::Material>(materialId);
         material->name = materialName;
-        material->albedoFactor =
-                {stream->readFloat32(), stream->readFloat32(), stream->readFloat32(), stream->readFloat32()};
-        material->roughnessFactor = stream->readFloat32();
-        material->metalnessFactor = stream->readFloat32();
-        material->ambientOcclusionFactor = stream->readFloat32();
-        material->normalScale = stream->readFloat32();
+        float factors[8];
+        stream->readFloat32Array(factors, 8);
+        material->albedoFactor = {factors[0], factors[1], factors[2], factors[3]};
+        material->roughnessFactor = factors[4];
+        material->metalnessFactor = factors[5];
+        material->ambientOcclusionFactor = factors[6];
+        material->normalScale = factors[7];
 
         material->albedoTexture = ReadOptionalTexture(textureCollection, stream);
         material->normalTexture = ReadOptionalTexture(textureCollection, stream);
         material->metallicRoughnessAmbientOcclusionTexture = ReadOptionalTexture(textureCollection, stream);
         materialCollection.materials[materialIndex] = material;
     }
+    materialCollection.indexIds();
     return materialCollection;
 }
 
-DAsset::Asset DAsset::ReadAsset(const std::unique_ptr<Stream::DataReadStream> &stream) {
+// Reads the header and switches the stream to the byte order of the file
+// Returns the buffer count, as legacy files without a header start with it. Their version is 0.
+uint64_t ReadHeader(const std::unique_ptr<Stream::DataReadStream> &stream, uint8_t &version) {
+    uint8_t magic[sizeof(DASSET_MAGIC)];
+    if (stream->read(magic, sizeof(magic)) != sizeof(magic)) {
+        RAISE_EXCEPTION(errorhandling::IllegalStateException, "Asset is too short to contain a header");
+    }
+    if (memcmp(magic, DASSET_MAGIC, sizeof(DASSET_MAGIC)) != 0) {
+        stream->setByteOrder(Stream::ByteOrder::BIG);
+        uint64_t bufferCount = 0;
+        for (uint8_t byte: magic) {
+            bufferCount = bufferCount << 8 | byte;
+        }
+        version = 0;
+        return bufferCount;
+    }
+    version = stream->readUint8();
+    if (version > DASSET_FORMAT_VERSION) {
+        RAISE_EXCEPTION(errorhandling::IllegalStateException,
+                        "Asset has unsupported format version " + std::to_string(version));
+    }
+    auto byteOrder = static_cast<Stream::ByteOrder>(stream->readUint8());
+    if (byteOrder != Stream::ByteOrder::BIG && byteOrder != Stream::ByteOrder::LITTLE) {
+        RAISE_EXCEPTION(errorhandling::IllegalStateException, "Asset has unknown byte order");
+    }
+    stream->setByteOrder(byteOrder);
+    // From version 4 on the table of contents follows the header instead
+    return version >= 4 ? 0 : stream->readUint64();
+}
+
+TableOfContents ReadTableOfContents(const std::unique_ptr<Stream::DataReadStream> &stream, uint64_t assetStart) {
+    TableOfContents tableOfContents{};
+    auto sectionCount = stream->readUint32();
+    for (uint32_t i = 0; i < sectionCount; i++) {
+        auto [sectionType, offset, size] = Stream::ReadRecord<uint8_t, uint64_t, uint64_t>(*stream);
+        tableOfContents.sections[sectionType] = {offset, size};
+    }
+    auto bufferCount = stream->readUint64();
+    // The count is checked against the bytes left before allocating, so that a corrupt count can't exhaust memory.
+    // The stream may start before the asset, so the bytes left are overestimated, never underestimated.
+    // Entries, of an id, offset and size each, of streams of unknown length are added as they are read.
+    auto length = stream->getLength();
+    if (length != UINT64_MAX) {
+        auto consumed = stream->getPosition() - assetStart;
+        if (consumed > length || bufferCount > (length - consumed) / (3 * sizeof(uint64_t))) {
+            RAISE_EXCEPTION(errorhandling::IllegalStateException,
+                            "Asset lists " + std::to_string(bufferCount) + " buffers, more than it has room for");
+        }
+        tableOfContents.buffers.reserve(bufferCount);
+    }
+    for (uint64_t i = 0; i < bufferCount; i++) {
+        auto [bufferId, offset, size] = Stream::ReadRecord<int64_t, uint64_t, uint64_t>(*stream);
+        tableOfContents.buffers.push_back({static_cast<uint64_t>(bufferId), offset, size});
+    }
+    return tableOfContents;
+}
+
+// Moves forward by skipping where possible, so streams that can not seek read files in the order they are written
+void MoveTo(const std::unique_ptr<Stream::DataReadStream> &stream, uint64_t position) {
+    auto currentPosition = stream->getPosition();
+    if (position >= currentPosition) {
+        stream->skip(position - currentPosition);
+    } else {
+        stream->seek(position);
+    }
+}
+
+void MoveToSection(const std::unique_ptr<Stream::DataReadStream> &stream, uint64_t assetStart,
+                   const TableOfContents &tableOfContents, SectionType sectionType) {
+    auto section = tableOfContents.sections.find(static_cast<uint8_t>(sectionType));
+    if (section == tableOfContents.sections.end()) {
+        RAISE_EXCEPTION(errorhandling::IllegalStateException,
+                        "Asset has no section of type " + std::to_string(static_cast<int>(sectionType)));
+    }
+    MoveTo(stream, assetStart + section->second.first);
+}
+
+// Without a payload source all payloads are read, otherwise buffers read them when they are loaded
+DAsset::Asset ReadAssetContents(const std::unique_ptr<Stream::DataReadStream> &stream,
+                                const std::shared_ptr<DAsset::PayloadSource> &payloadSource) {
     DAsset::Asset asset{};
-    auto bufferCollection = ReadBufferCollection(stream);
-    auto textureCollection = ReadTextureCollection(bufferCollection, stream);
-    auto materialCollection = ReadMaterialCollection(textureCollection, stream);
-    asset.bufferCollection = bufferCollection;
-    asset.textureCollection = textureCollection;
-    asset.materialCollection = materialCollection;
-    asset.rootNode = ReadNode(bufferCollection, materialCollection, stream);
+    auto assetStart = stream->getPosition();
+    uint8_t version{};
+    auto bufferCount = ReadHeader(stream, version);
+    if (version < 4) {
+        asset.bufferCollection = ReadBufferCollection(bufferCount, stream, payloadSource);
+        asset.textureCollection = ReadTextureCollection(asset.bufferCollection, version, stream);
+        asset.materialCollection = ReadMaterialCollection(asset.textureCollection, stream);
+        asset.rootNode = ReadNode(asset.bufferCollection, asset.materialCollection, stream);
+        return asset;
+    }
+
+    auto tableOfContents = ReadTableOfContents(stream, assetStart);
+    // The sections reference the buffers, so they are created before their payloads are read
+    auto &buffers = asset.bufferCollection.buffers;
+    for (const auto &entry: tableOfContents.buffers) {
+        if (payloadSource != nullptr) {
+            buffers.push_back(std::make_shared<DAsset::Buffer>(entry.bufferId, payloadSource,
+                                                               assetStart + entry.offset, entry.size));
+        } else {
+            buffers.push_back(std::make_shared<DAsset::Buffer>(entry.bufferId, DAsset::ByteSpan()));
+        }
+    }
+    asset.bufferCollection.indexIds();
+
+    MoveToSection(stream, assetStart, tableOfContents, SectionType::TEXTURES);
+    asset.textureCollection = ReadTextureCollection(asset.bufferCollection, version, stream);
+    MoveToSection(stream, assetStart, tableOfContents, SectionType::MATERIALS);
+    asset.materialCollection = ReadMaterialCollection(asset.textureCollection, stream);
+    MoveToSection(stream, assetStart, tableOfContents, SectionType::NODES);
+    asset.rootNode = ReadNode(asset.bufferCollection, asset.materialCollection, stream);
+
+    if (payloadSource == nullptr) {
+        for (uint64_t bufferIndex = 0; bufferIndex < buffers.size(); bufferIndex++) {
+            const auto &entry = tableOfContents.buffers[bufferIndex];
+            MoveTo(stream, assetStart + entry.offset);
+            std::vector<uint8_t> data(entry.size);
+            ReadPayload(stream, data.data(), entry.size);
+            buffers[bufferIndex]->data = std::move(data);
+        }
+    }
+    return asset;
+}
+
+DAsset::Asset DAsset::ReadAsset(const std::unique_ptr<Stream::DataReadStream> &stream) {
+    Stream::ByteOrderScope byteOrderScope(*stream);
+    return ReadAssetContents(stream, nullptr);
+}
+
+DAsset::Asset DAsset::ReadAsset(const DAsset::ByteSpan &assetBytes) {
+    auto asset = ReadAssetLazily(assetBytes);
+    for (const auto &buffer: asset.bufferCollection.buffers) {
+        buffer->load();
+    }
     return asset;
 }
 
+DAsset::Asset DAsset::ReadAssetLazily(std::unique_ptr<Stream::DataReadStream> stream) {
+    auto payloadSource = std::make_shared<DAsset::PayloadSource>(std::move(stream));
+    return ReadAssetContents(payloadSource->getStream(), payloadSource);
+}
+
+DAsset::Asset DAsset::ReadAssetLazily(const DAsset::ByteSpan &assetBytes) {
+    auto payloadSource = std::make_shared<DAsset::PayloadSource>(assetBytes);
+    return ReadAssetContents(payloadSource->getStream(), payloadSource);
+}
+
 std::string DAsset::GetAttributeTypeName(const DAsset::AttributeType type) {
     switch (type) {
         case AttributeType::POSITION:
@@ -487,6 +742,21 @@ std::string DAsset::GetTextureFilterName(DAsset::SamplerFilter filter) {
     }
 }
 
+std::string DAsset::GetTextureFormatName(DAsset::TextureFormat format) {
+    switch (format) {
+        case TextureFormat::PNG:
+            return "PNG";
+        case TextureFormat::BC4:
+            return "BC4";
+        case TextureFormat::BC5:
+            return "BC5";
+        case TextureFormat::BC7:
+            return "BC7";
+        default:
+            return "UNKNOWN";
+    }
+}
+
 DAsset::ComponentType DAsset::GetRequiredComponentTypeForAttribute(DAsset::AttributeType attributeType) {
     switch (attributeType) {
         case AttributeType::POSITION:
@@ -511,85 +781,252 @@ DAsset::ComponentType DAsset::GetRequiredComponentTypeForAttribute(DAsset::Attri
     }
 }
 
-std::optional<uint64_t> DAsset::BufferCollection::find(const DAsset::Buffer &buffer) const {
-    for (uint64_t i = 0; i < buffers.size(); i++) {
-        if (buffers[i]->bufferId == buffer.bufferId) {
-            return i;
+/**
+ * @return the index of the element with the given id
+ */
+template<typename Element, typename GetId>
+std::optional<uint64_t> FindIndexOfId(const std::vector<std::shared_ptr<Element>> &elements,
+                                      const std::unordered_map<uint64_t, uint64_t> &sparseIdIndices, bool idsIndexed,
+                                      uint64_t id, GetId getId) {
+    if (id < elements.size() && getId(*elements[id]) == id) {
+        return id;
+    }
+    auto it = sparseIdIndices.find(id);
+    if (it != sparseIdIndices.end() && it->second < elements.size() && getId(*elements[it->second]) == id) {
+        return it->second;
+    }
+    // An indexed id is only missing when it is not in the collection
+    if (idsIndexed && it == sparseIdIndices.end()) {
+        return std::nullopt;
+    }
+    // Without an index, or with an entry outdated by elements changed without indexing them again
+    for (uint64_t index = 0; index < elements.size(); index++) {
+        if (getId(*elements[index]) == id) {
+            return index;
         }
     }
     return std::nullopt;
 }
 
-std::optional<std::shared_ptr<DAsset::Buffer>> DAsset::BufferCollection::getBuffer(uint64_t bufferId) const {
-    for (auto &buffer: buffers) {
-        if (buffer->bufferId == bufferId) {
-            return buffer;
+template<typename Element, typename GetId>
+std::unordered_map<uint64_t, uint64_t> IndexSparseIds(const std::vector<std::shared_ptr<Element>> &elements,
+                                                      GetId getId) {
+    std::unordered_map<uint64_t, uint64_t> sparseIdIndices{};
+    for (uint64_t index = 0; index < elements.size(); index++) {
+        auto id = getId(*elements[index]);
+        if (id == index) {
+            continue;
+        }
+        bool isDuplicate = (id < elements.size() && getId(*elements[id]) == id) ||
+                           !sparseIdIndices.emplace(id, index).second;
+        if (isDuplicate) {
+            RAISE_EXCEPTION(errorhandling::IllegalStateException, "Id " + std::to_string(id) + " is used twice");
         }
     }
-    return std::nullopt;
+    return sparseIdIndices;
+}
+
+/**
+ * @return the id of an element added at the end, which is its index
+ */
+template<typename Element, typename GetId>
+uint64_t GetNewId(const std::vector<std::shared_ptr<Element>> &elements,
+                  const std::unordered_map<uint64_t, uint64_t> &sparseIdIndices, bool idsIndexed, GetId getId) {
+    uint64_t id = elements.size();
+    if (FindIndexOfId(elements, sparseIdIndices, idsIndexed, id, getId).has_value()) {
+        RAISE_EXCEPTION(errorhandling::IllegalStateException,
+                        "Id " + std::to_string(id) + " of a new element is already used by another element");
+    }
+    return id;
+}
+
+static uint64_t GetBufferId(const DAsset::Buffer &buffer) {
+    return buffer.bufferId;
+}
+
+static uint64_t GetTextureId(const DAsset::Texture &texture) {
+    return texture.textureId;
+}
+
+static uint64_t GetMaterialId(const DAsset::Material &material) {
+    return material.materialId;
+}
+
+std::optional<uint64_t> DAsset::BufferCollection::find(const DAsset::Buffer &buffer) const {
+    return FindIndexOfId(buffers, sparseIdIndices, idsIndexed, buffer.bufferId, GetBufferId);
+}
+
+std::optional<std::shared_ptr<DAsset::Buffer>> DAsset::BufferCollection::getBuffer(uint64_t bufferId) const {
+    auto index = FindIndexOfId(buffers, sparseIdIndices, idsIndexed, bufferId, GetBufferId);
+    if (!index.has_value()) {
+        return std::nullopt;
+    }
+    return buffers[index.value()];
 }
 
 std::shared_ptr<DAsset::Buffer> DAsset::BufferCollection::newBuffer(const uint8_t *data, size_t length) {
-    std::vector<uint8_t> bufferData(length);
-    std::copy(data, data + length, bufferData.begin());
-    auto buffer = std::make_shared<DAsset::Buffer>(buffers.size(), bufferData);
+    auto buffer = std::make_shared<DAsset::Buffer>(GetNewId(buffers, sparseIdIndices, idsIndexed, GetBufferId),
+                                                   DAsset::ByteSpan::CopyOf(data, length));
     buffers.push_back(buffer);
     return buffer;
 }
 
-DAsset::Buffer::Buffer(uint64_t bufferId, const std::vector<uint8_t> &data) : bufferId(bufferId), data(data) {
+void DAsset::BufferCollection::indexIds() {
+    // Not indexed while indexing raises for duplicate ids
+    idsIndexed = false;
+    sparseIdIndices = IndexSparseIds(buffers, GetBufferId);
+    idsIndexed = true;
 }
 
-std::optional<std::shared_ptr<DAsset::Material>> DAsset::MaterialCollection::getMaterial(uint64_t materialId) const {
-    for (auto &material: materials) {
-        if (material->materialId == materialId) {
-            return material;
-        }
+DAsset::Buffer::Buffer(uint64_t bufferId, DAsset::ByteSpan data) : bufferId(bufferId), data(std::move(data)) {
+}
+
+DAsset::Buffer::Buffer(uint64_t bufferId, const std::shared_ptr<PayloadSource> &payloadSource,
+                       uint64_t payloadPosition, uint64_t payloadSize)
+        : bufferId(bufferId), payloadSource(payloadSource), payloadPosition(payloadPosition),
+          payloadSize(payloadSize), loaded(false) {
+}
+
+bool DAsset::Buffer::isLoaded() const {
+    if (payloadSource == nullptr) {
+        return true;
     }
-    return std::nullopt;
+    // Other threads may be loading the buffer
+    auto lock = payloadSource->lock();
+    return loaded;
 }
 
-std::optional<uint64_t> DAsset::MaterialCollection::find(const DAsset::Material &material) const {
-    for (uint64_t i = 0; i < materials.size(); i++) {
-        if (materials[i]->materialId == material.materialId) {
-            return i;
+void DAsset::Buffer::load() {
+    // Buffers without a source are always loaded
+    if (payloadSource == nullptr) {
+        return;
+    }
+    auto lock = payloadSource->lock();
+    if (loaded) {
+        return;
+    }
+    data = payloadSource->read(payloadPosition, payloadSize);
+    loaded = true;
+}
+
+void DAsset::Buffer::unload() {
+    // Buffers without a source could not be loaded again
+    if (payloadSource == nullptr) {
+        return;
+    }
+    auto lock = payloadSource->lock();
+    data = {};
+    loaded = false;
+}
+
+uint64_t DAsset::Buffer::getSize() const {
+    if (payloadSource == nullptr) {
+        return data.size();
+    }
+    auto lock = payloadSource->lock();
+    return loaded ? data.size() : payloadSize;
+}
+
+DAsset::PayloadSource::PayloadSource(std::unique_ptr<Stream::DataReadStream> stream) : stream(std::move(stream)) {
+}
+
+DAsset::PayloadSource::PayloadSource(const DAsset::ByteSpan &memory)
+        : stream(Stream::MemoryReadStream::Wrap(memory.data(), memory.size())), memory(memory) {
+}
+
+const std::unique_ptr<Stream::DataReadStream> &DAsset::PayloadSource::getStream() const {
+    return stream;
+}
+
+std::unique_lock<std::mutex> DAsset::PayloadSource::lock() {
+    return std::unique_lock<std::mutex>(mutex);
+}
+
+DAsset::ByteSpan DAsset::PayloadSource::read(uint64_t position, uint64_t size) {
+    if (memory.has_value()) {
+        if (position > memory->size() || size > memory->size() - position) {
+            RAISE_EXCEPTION(errorhandling::IllegalStateException, "Asset ends within a buffer payload");
         }
+        return memory->slice(position, size);
     }
-    return std::nullopt;
+    std::vector<uint8_t> data(size);
+    stream->seek(position);
+    ReadPayload(stream, data.data(), size);
+    return DAsset::ByteSpan(std::move(data));
+}
+
+std::optional<std::shared_ptr<DAsset::Material>> DAsset::MaterialCollection::getMaterial(uint64_t materialId) const {
+    auto index = FindIndexOfId(materials, sparseIdIndices, idsIndexed, materialId, GetMaterialId);
+    if (!index.has_value()) {
+        return std::nullopt;
+    }
+    return materials[index.value()];
+}
+
+std::optional<uint64_t> DAsset::MaterialCollection::find(const DAsset::Material &material) const {
+    return FindIndexOfId(materials, sparseIdIndices, idsIndexed, material.materialId, GetMaterialId);
 }
 
 std::shared_ptr<DAsset::Material> DAsset::MaterialCollection::newMaterial() {
-    auto material = std::make_shared<DAsset::Material>(materials.size());
+    auto material = std::make_shared<DAsset::Material>(GetNewId(materials, sparseIdIndices, idsIndexed, GetMaterialId));
     materials.push_back(material);
     return material;
 }
 
+void DAsset::MaterialCollection::indexIds() {
+    // Not indexed while indexing raises for duplicate ids
+    idsIndexed = false;
+    sparseIdIndices = IndexSparseIds(materials, GetMaterialId);
+    idsIndexed = true;
+}
+
 DAsset::Material::Material(uint64_t materialId) : materialId(materialId) {
 }
 
 std::optional<std::shared_ptr<DAsset::Texture>> DAsset::TextureCollection::getTexture(uint64_t textureId) const {
-    for (auto &texture: textures) {
-        if (texture->textureId == textureId) {
-            return texture;
-        }
+    auto index = FindIndexOfId(textures, sparseIdIndices, idsIndexed, textureId, GetTextureId);
+    if (!index.has_value()) {
+        return std::nullopt;
     }
-    return std::nullopt;
+    return textures[index.value()];
 }
 
 std::optional<uint64_t> DAsset::TextureCollection::find(const DAsset::Texture &texture) const {
-    for (uint64_t i = 0; i < textures.size(); i++) {
-        if (textures[i]->textureId == texture.textureId) {
-            return i;
-        }
-    }
-    return std::nullopt;
+    return FindIndexOfId(textures, sparseIdIndices, idsIndexed, texture.textureId, GetTextureId);
 }
 
 std::shared_ptr<DAsset::Texture> DAsset::TextureCollection::newTexture() {
-    auto texture = std::make_shared<DAsset::Texture>(textures.size());
+    auto texture = std::make_shared<DAsset::Texture>(GetNewId(textures, sparseIdIndices, idsIndexed, GetTextureId));
     textures.push_back(texture);
     return texture;
 }
 
+void DAsset::TextureCollection::indexIds() {
+    // Not indexed while indexing raises for duplicate ids
+    idsIndexed = false;
+    sparseIdIndices = IndexSparseIds(textures, GetTextureId);
+    idsIndexed = true;
+}
+
 DAsset::Texture::Texture(uint64_t textureId) : textureId(textureId) {
 }
+
+uint32_t DAsset::Texture::getMipLevelCount() const {
+    return static_cast<uint32_t>(mipLevelBufferViews.size()) + 1;
+}
+
+const DAsset::BufferView &DAsset::Texture::getMipLevelBufferView(uint32_t level) const {
+    if (level >= getMipLevelCount()) {
+        RAISE_EXCEPTION(errorhandling::IllegalArgumentException,
+                        "Texture has no mip level " + std::to_string(level));
+    }
+    return level == 0 ? bufferView : mipLevelBufferViews[level - 1];
+}
+
+int32_t DAsset::Texture::getMipLevelWidth(uint32_t level) const {
+    return std::max(1, width >> level);
+}
+
+int32_t DAsset::Texture::getMipLevelHeight(uint32_t level) const {
+    return std::max(1, height >> level);
+}
@@ -0,0 +1,55 @@
+#include <DAsset/ByteSpan.hpp>
+#include <ErrorHandling/IllegalArgumentException.hpp>
+#include <string>
+
+DAsset::ByteSpan::ByteSpan(std::vector<uint8_t> &&bytes) {
+    auto ownedBytes = std::make_shared<const std::vector<uint8_t>>(std::move(bytes));
+    this->bytes = ownedBytes->data();
+    length = ownedBytes->size();
+    owner = std::move(ownedBytes);
+}
+
+DAsset::ByteSpan::ByteSpan(std::shared_ptr<const void> owner, const uint8_t *bytes, size_t length)
+        : owner(std::move(owner)), bytes(bytes), length(length) {
+}
+
+DAsset::ByteSpan DAsset::ByteSpan::CopyOf(const uint8_t *bytes, size_t length) {
+    return {std::vector<uint8_t>(bytes, bytes + length)};
+}
+
+DAsset::ByteSpan DAsset::ByteSpan::slice(size_t offset, size_t sliceLength) const {
+    if (offset > length || sliceLength > length - offset) {
+        RAISE_EXCEPTION(errorhandling::IllegalArgumentException,
+                        "Slice of " + std::to_string(sliceLength) + " bytes at " + std::to_string(offset) +
+                        " is not within a span of " + std::to_string(length) + " bytes");
+    }
+    return {owner, bytes + offset, sliceLength};
+}
+
+const uint8_t *DAsset::ByteSpan::data() const {
+    return bytes;
+}
+
+size_t DAsset::ByteSpan::size() const {
+    return length;
+}
+
+bool DAsset::ByteSpan::empty() const {
+    return length == 0;
+}
+
+const uint8_t *DAsset::ByteSpan::begin() const {
+    return bytes;
+}
+
+const uint8_t *DAsset::ByteSpan::end() const {
+    return bytes + length;
+}
+
+const uint8_t &DAsset::ByteSpan::operator[](size_t index) const {
+    return bytes[index];
+}
+
+std::vector<uint8_t> DAsset::ByteSpan::toVector() const {
+    return {begin(), end()};
+}
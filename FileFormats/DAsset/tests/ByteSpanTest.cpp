@@ -0,0 +1,53 @@
+#include <gtest/gtest.h>
+#include <DAsset/Asset.hpp>
+#include <DAsset/ByteSpan.hpp>
+#include <ErrorHandling/IllegalArgumentException.hpp>
+#include <Stream/MemoryDataStream.hpp>
+
+TEST(ByteSpan, VectorsAreMovedNotCopied) {
+    std::vector<uint8_t> bytes = {1, 2, 3, 4};
+    const uint8_t *vectorData = bytes.data();
+    DAsset::ByteSpan span(std::move(bytes));
+    EXPECT_EQ(vectorData, span.data());
+    EXPECT_EQ(4u, span.size());
+
+    auto slice = span.slice(1, 2);
+    EXPECT_EQ(vectorData + 1, slice.data());
+    EXPECT_EQ((std::vector<uint8_t>{2, 3}), slice.toVector());
+    EXPECT_TRUE(span.slice(4, 0).empty());
+    EXPECT_THROW(span.slice(3, 2), errorhandling::IllegalArgumentException);
+}
+
+TEST(ByteSpan, SlicesKeepTheOwnerAlive) {
+    std::weak_ptr<const void> weakOwner;
+    DAsset::ByteSpan slice;
+    {
+        auto owner = std::make_shared<std::vector<uint8_t>>(std::vector<uint8_t>{5, 6, 7});
+        weakOwner = owner;
+        DAsset::ByteSpan span(owner, owner->data(), owner->size());
+        slice = span.slice(2, 1);
+    }
+    EXPECT_FALSE(weakOwner.expired());
+    EXPECT_EQ(7, slice[0]);
+    slice = {};
+    EXPECT_TRUE(weakOwner.expired());
+}
+
+TEST(ByteSpan, AssetsInMemoryAreReadWithoutCopies) {
+    DAsset::Asset asset{};
+    asset.bufferCollection.newBuffer(nullptr, 0)->data = std::vector<uint8_t>(64, 3);
+    auto writeStream = Stream::MemoryWriteStream::Growable();
+    auto *memoryWriteStream = writeStream.get();
+    std::unique_ptr<Stream::DataWriteStream> stream(std::move(writeStream));
+    DAsset::WriteAsset(asset, stream);
+    DAsset::ByteSpan assetBytes(memoryWriteStream->releaseBuffer());
+
+    auto readAsset = DAsset::ReadAsset(assetBytes);
+    auto &buffer = readAsset.bufferCollection.buffers.at(0);
+    EXPECT_TRUE(buffer->isLoaded());
+    ASSERT_EQ(64u, buffer->data.size());
+    // The payload is a slice of the asset's bytes
+    EXPECT_GE(buffer->data.data(), assetBytes.begin());
+    EXPECT_EQ(assetBytes.end(), buffer->data.end());
+    EXPECT_EQ(std::vector<uint8_t>(64, 3), buffer->data.toVector());
+}
@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+#include <DAsset/Asset.hpp>
+#include <ErrorHandling/IllegalStateException.hpp>
+#include <Stream/MemoryDataStream.hpp>
+
+TEST(Collection, NewElementsHaveDenseIds) {
+    DAsset::BufferCollection bufferCollection{};
+    for (uint64_t i = 0; i < 100; i++) {
+        EXPECT_EQ(i, bufferCollection.newBuffer(nullptr, 0)->bufferId);
+    }
+    EXPECT_TRUE(bufferCollection.sparseIdIndices.empty());
+    EXPECT_EQ(bufferCollection.buffers[42], bufferCollection.getBuffer(42).value());
+    EXPECT_EQ(42u, bufferCollection.find(*bufferCollection.buffers[42]).value());
+    EXPECT_FALSE(bufferCollection.getBuffer(100).has_value());
+}
+
+TEST(Collection, SparseIdsAreIndexed) {
+    DAsset::TextureCollection textureCollection{};
+    for (uint64_t textureId: {7, 1, 100}) {
+        textureCollection.textures.push_back(std::make_shared<DAsset::Texture>(textureId));
+    }
+    textureCollection.indexIds();
+    // Texture 1 is at its own index, the others are indexed
+    EXPECT_EQ(2u, textureCollection.sparseIdIndices.size());
+    EXPECT_EQ(7u, textureCollection.getTexture(7).value()->textureId);
+    EXPECT_EQ(100u, textureCollection.getTexture(100).value()->textureId);
+    EXPECT_EQ(1u, textureCollection.find(*textureCollection.textures[1]).value());
+    EXPECT_EQ(2u, textureCollection.find(DAsset::Texture(100)).value());
+    EXPECT_FALSE(textureCollection.getTexture(0).has_value());
+    EXPECT_FALSE(textureCollection.getTexture(2).has_value());
+
+    // Elements changed without indexing them again are still found
+    std::swap(textureCollection.textures[0], textureCollection.textures[2]);
+    EXPECT_EQ(0u, textureCollection.find(DAsset::Texture(100)).value());
+    EXPECT_EQ(7u, textureCollection.getTexture(7).value()->textureId);
+
+    // The next id is taken by a sparse texture
+    textureCollection.textures.resize(2);
+    textureCollection.textures[1] = std::make_shared<DAsset::Texture>(2);
+    textureCollection.indexIds();
+    EXPECT_THROW(textureCollection.newTexture(), errorhandling::IllegalStateException);
+}
+
+TEST(Collection, IdsMissingInTheIndexAreNotSearched) {
+    DAsset::TextureCollection textureCollection{};
+    textureCollection.textures.push_back(std::make_shared<DAsset::Texture>(7));
+    // Without an index, sparse ids are searched linearly
+    EXPECT_EQ(7u, textureCollection.getTexture(7).value()->textureId);
+
+    textureCollection.indexIds();
+    textureCollection.textures.push_back(std::make_shared<DAsset::Texture>(8));
+    EXPECT_FALSE(textureCollection.getTexture(8).has_value());
+    textureCollection.indexIds();
+    EXPECT_EQ(8u, textureCollection.getTexture(8).value()->textureId);
+}
+
+TEST(Collection, DuplicateIdsAreRejected) {
+    DAsset::MaterialCollection materialCollection{};
+    for (uint64_t materialId: {0, 0}) {
+        materialCollection.materials.push_back(std::make_shared<DAsset::Material>(materialId));
+    }
+    EXPECT_THROW(materialCollection.indexIds(), errorhandling::IllegalStateException);
+
+    materialCollection.materials = {std::make_shared<DAsset::Material>(5), std::make_shared<DAsset::Material>(5)};
+    EXPECT_THROW(materialCollection.indexIds(), errorhandling::IllegalStateException);
+}
+
+TEST(Collection, ReferencesToSparseIdsSurviveWritingAndReading) {
+    DAsset::Asset asset{};
+    auto buffer = std::make_shared<DAsset::Buffer>(9, std::vector<uint8_t>(16, 1));
+    asset.bufferCollection.buffers = {std::make_shared<DAsset::Buffer>(3, std::vector<uint8_t>(4, 0)), buffer};
+    asset.bufferCollection.indexIds();
+    auto material = std::make_shared<DAsset::Material>(11);
+    asset.materialCollection.materials = {material};
+    asset.materialCollection.indexIds();
+    DAsset::MeshPart meshPart{};
+    meshPart.renderMode = DAsset::RenderMode::TRIANGLES;
+    meshPart.attributeBufferViews[DAsset::AttributeType::POSITION] = {
+            4, 12, 12, DAsset::DataType::FLOAT, DAsset::ComponentType::VEC3, buffer
+    };
+    meshPart.material = material;
+    asset.rootNode.mesh.meshParts.push_back(meshPart);
+
+    auto writeStream = Stream::MemoryWriteStream::Growable();
+    auto *memoryWriteStream = writeStream.get();
+    std::unique_ptr<Stream::DataWriteStream> stream(std::move(writeStream));
+    DAsset::WriteAsset(asset, stream);
+    auto bytes = memoryWriteStream->releaseBuffer();
+    std::unique_ptr<Stream::DataReadStream> readStream(Stream::MemoryReadStream::CopyOf(bytes.data(), bytes.size()));
+    auto readAsset = DAsset::ReadAsset(readStream);
+
+    auto &readMeshPart = readAsset.rootNode.mesh.meshParts.at(0);
+    auto &readBufferView = readMeshPart.attributeBufferViews.at(DAsset::AttributeType::POSITION);
+    EXPECT_EQ(9u, readBufferView.buffer->bufferId);
+    EXPECT_EQ(16u, readBufferView.buffer->data.size());
+    EXPECT_EQ(11u, readMeshPart.material->materialId);
+    EXPECT_EQ(readBufferView.buffer, readAsset.bufferCollection.getBuffer(9).value());
+}
@@ -0,0 +1,155 @@
+#include <gtest/gtest.h>
+#include <DAsset/Asset.hpp>
+#include <ErrorHandling/IllegalStateException.hpp>
+#include <Stream/MemoryDataStream.hpp>
+#include <thread>
+
+static DAsset::Asset CreateAsset() {
+    DAsset::Asset asset{};
+    auto indices = asset.bufferCollection.newBuffer(nullptr, 0);
+    indices->data = std::vector<uint8_t>{0, 1, 2, 3, 4, 5};
+    auto positions = asset.bufferCollection.newBuffer(nullptr, 0);
+    positions->data = std::vector<uint8_t>(36, 7);
+    auto material = asset.materialCollection.newMaterial();
+    DAsset::MeshPart meshPart{};
+    meshPart.renderMode = DAsset::RenderMode::TRIANGLES;
+    meshPart.indexBufferView = DAsset::BufferView{
+            0, 6, 2, DAsset::DataType::UNSIGNED_SHORT, DAsset::ComponentType::SCALAR, indices
+    };
+    meshPart.attributeBufferViews[DAsset::AttributeType::POSITION] = {
+            0, 36, 12, DAsset::DataType::FLOAT, DAsset::ComponentType::VEC3, positions
+    };
+    meshPart.material = material;
+    asset.rootNode.name = "root";
+    asset.rootNode.mesh.meshParts.push_back(meshPart);
+    return asset;
+}
+
+static std::vector<uint8_t> Write(const DAsset::Asset &asset) {
+    auto writeStream = Stream::MemoryWriteStream::Growable();
+    auto *memoryWriteStream = writeStream.get();
+    std::unique_ptr<Stream::DataWriteStream> stream(std::move(writeStream));
+    DAsset::WriteAsset(asset, stream);
+    return memoryWriteStream->releaseBuffer();
+}
+
+TEST(Container, BuffersAreLoadedOnRequest) {
+    auto bytes = Write(CreateAsset());
+    auto asset = DAsset::ReadAssetLazily(Stream::MemoryReadStream::Wrap(bytes.data(), bytes.size()));
+
+    // The metadata is read without any payload
+    EXPECT_EQ("root", asset.rootNode.name);
+    auto &meshPart = asset.rootNode.mesh.meshParts.at(0);
+    auto positions = meshPart.attributeBufferViews.at(DAsset::AttributeType::POSITION).buffer;
+    auto indices = meshPart.indexBufferView.value().buffer;
+    EXPECT_FALSE(positions->isLoaded());
+    EXPECT_TRUE(positions->data.empty());
+    EXPECT_EQ(36u, positions->getSize());
+
+    positions->load();
+    EXPECT_TRUE(positions->isLoaded());
+    EXPECT_EQ(std::vector<uint8_t>(36, 7), positions->data.toVector());
+    EXPECT_FALSE(indices->isLoaded());
+    indices->load();
+    EXPECT_EQ((std::vector<uint8_t>{0, 1, 2, 3, 4, 5}), indices->data.toVector());
+
+    positions->unload();
+    EXPECT_FALSE(positions->isLoaded());
+    EXPECT_EQ(36u, positions->getSize());
+    positions->load();
+    EXPECT_EQ(std::vector<uint8_t>(36, 7), positions->data.toVector());
+}
+
+TEST(Container, EagerReadingLoadsAllBuffers) {
+    auto bytes = Write(CreateAsset());
+    std::unique_ptr<Stream::DataReadStream> stream(Stream::MemoryReadStream::Wrap(bytes.data(), bytes.size()));
+    auto asset = DAsset::ReadAsset(stream);
+    ASSERT_EQ(2u, asset.bufferCollection.buffers.size());
+    EXPECT_TRUE(asset.bufferCollection.buffers[0]->isLoaded());
+    EXPECT_EQ((std::vector<uint8_t>{0, 1, 2, 3, 4, 5}), asset.bufferCollection.buffers[0]->data.toVector());
+    EXPECT_EQ(std::vector<uint8_t>(36, 7), asset.bufferCollection.buffers[1]->data.toVector());
+    EXPECT_FALSE(stream->hasRemaining());
+
+    // The second payload starts at the next aligned offset behind the first one
+    auto firstPayload = std::search(bytes.begin(), bytes.end(), asset.bufferCollection.buffers[0]->data.begin(),
+                                    asset.bufferCollection.buffers[0]->data.end());
+    ASSERT_NE(bytes.end(), firstPayload);
+    EXPECT_EQ(0, (firstPayload - bytes.begin()) % 16);
+    EXPECT_EQ(bytes.size() - 36, (firstPayload - bytes.begin() + 6 + 15) / 16 * 16);
+}
+
+TEST(Container, UnloadedBuffersAreNotWritten) {
+    auto bytes = Write(CreateAsset());
+    auto asset = DAsset::ReadAssetLazily(Stream::MemoryReadStream::Wrap(bytes.data(), bytes.size()));
+    EXPECT_THROW(Write(asset), errorhandling::IllegalStateException);
+
+    for (const auto &buffer: asset.bufferCollection.buffers) {
+        buffer->load();
+    }
+    EXPECT_EQ(bytes, Write(asset));
+}
+
+TEST(Container, FilesWithoutTableOfContentsAreReadLazily) {
+    // A big-endian file written before the format had a header, with one buffer and an empty root node
+    auto writeStream = Stream::MemoryWriteStream::Growable();
+    writeStream->writeInt64(1);
+    writeStream->writeInt64(5);
+    writeStream->writeInt64(4);
+    writeStream->writeUint32(0xDEADBEEF);
+    // Textures, materials
+    writeStream->writeInt64(0);
+    writeStream->writeInt64(0);
+    writeStream->writeString("legacy");
+    for (int i = 0; i < 10; i++) {
+        writeStream->writeFloat32(1);
+    }
+    // Mesh parts, children
+    writeStream->writeInt64(0);
+    writeStream->writeInt64(0);
+    auto bytes = writeStream->releaseBuffer();
+
+    auto asset = DAsset::ReadAssetLazily(Stream::MemoryReadStream::Wrap(bytes.data(), bytes.size()));
+    EXPECT_EQ("legacy", asset.rootNode.name);
+    auto buffer = asset.bufferCollection.getBuffer(5).value();
+    EXPECT_FALSE(buffer->isLoaded());
+    EXPECT_EQ(4u, buffer->getSize());
+    buffer->load();
+    EXPECT_EQ((std::vector<uint8_t>{0xDE, 0xAD, 0xBE, 0xEF}), buffer->data.toVector());
+}
+
+TEST(Container, CorruptBufferCountsAreRejected) {
+    // A version 4 header without sections, listing far more buffers than the file holds
+    auto writeStream = Stream::MemoryWriteStream::Growable();
+    writeStream->writeBuffer(reinterpret_cast<const uint8_t *>("DASSET\0\0"), 8);
+    writeStream->writeUint8(4);
+    writeStream->writeUint8(static_cast<uint8_t>(Stream::ByteOrder::BIG));
+    writeStream->writeUint32(0);
+    writeStream->writeUint64(UINT64_MAX / 2);
+    writeStream->writeUint64(0);
+    auto bytes = writeStream->releaseBuffer();
+
+    EXPECT_THROW(DAsset::ReadAssetLazily(Stream::MemoryReadStream::Wrap(bytes.data(), bytes.size())),
+                 errorhandling::IllegalStateException);
+}
+
+TEST(Container, BuffersAreLoadedConcurrently) {
+    auto bytes = Write(CreateAsset());
+    for (int iteration = 0; iteration < 100; iteration++) {
+        auto asset = DAsset::ReadAssetLazily(Stream::MemoryReadStream::Wrap(bytes.data(), bytes.size()));
+        auto positions = asset.bufferCollection.buffers[1];
+        // The threads load the same buffer, one of them reads it
+        std::vector<std::thread> threads{};
+        for (int i = 0; i < 4; i++) {
+            threads.emplace_back([&positions]() { positions->load(); });
+        }
+        // Others ask for its state meanwhile
+        threads.emplace_back([&positions]() {
+            EXPECT_EQ(36u, positions->getSize());
+            positions->isLoaded();
+        });
+        for (auto &thread: threads) {
+            thread.join();
+        }
+        EXPECT_EQ(std::vector<uint8_t>(36, 7), positions->data.toVector());
+    }
+}
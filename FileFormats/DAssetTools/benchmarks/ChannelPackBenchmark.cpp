@@ -0,0 +1,101 @@
+#include <benchmark/benchmark.h>
+#include <DAssetTools/ChannelPack.hpp>
+#include <cstring>
+#include <random>
+#include <vector>
+
+enum class RMASources {
+    METALLIC_ROUGHNESS_AND_OCCLUSION,
+    METALLIC_ROUGHNESS_ONLY,
+    OCCLUSION_ONLY
+};
+
+struct RMAImages {
+    std::vector<uint8_t> metallicRoughness;
+    std::vector<uint8_t> occlusion;
+    std::vector<uint8_t> rma;
+
+    explicit RMAImages(size_t nPixels) : metallicRoughness(nPixels * 3), occlusion(nPixels), rma(nPixels * 3) {
+        std::mt19937 random(42);
+        for (auto &byte: metallicRoughness) {
+            byte = static_cast<uint8_t>(random());
+        }
+        for (auto &byte: occlusion) {
+            byte = static_cast<uint8_t>(random());
+        }
+    }
+
+    const uint8_t *getMetallicRoughness(RMASources sources) const {
+        return sources == RMASources::OCCLUSION_ONLY ? nullptr : metallicRoughness.data();
+    }
+
+    const uint8_t *getOcclusion(RMASources sources) const {
+        return sources == RMASources::METALLIC_ROUGHNESS_ONLY ? nullptr : occlusion.data();
+    }
+};
+
+// The per byte loop DAssetConvert used before PackRMA
+static void PackRMALoop(const uint8_t *metallicRoughnessImageData, const uint8_t *occlusionImageData,
+                        uint8_t *rmaImageData, size_t nPixels) {
+    uint64_t rmaImageChannels = 3;
+    uint64_t rmaImageDataLength = nPixels * rmaImageChannels;
+    memset(rmaImageData, 0, rmaImageDataLength);
+    for (uint64_t i = 0; i < rmaImageDataLength; i++) {
+        uint64_t pixel = i / rmaImageChannels;
+        uint64_t channel = i % rmaImageChannels;
+        if (channel == 0) {
+            if (metallicRoughnessImageData == nullptr) {
+                rmaImageData[i] = 0;
+            } else {
+                rmaImageData[i] = metallicRoughnessImageData[pixel * 3 + 1];
+            }
+        } else if (channel == 1) {
+            if (metallicRoughnessImageData == nullptr) {
+                rmaImageData[i] = 0;
+            } else {
+                rmaImageData[i] = metallicRoughnessImageData[pixel * 3 + 2];
+            }
+        } else if (channel == 2) {
+            if (occlusionImageData == nullptr) {
+                rmaImageData[i] = 0;
+            } else {
+                rmaImageData[i] = occlusionImageData[pixel];
+            }
+        }
+    }
+}
+
+template<RMASources sources>
+static void BM_PackRMALoop(benchmark::State &state) {
+    size_t nPixels = static_cast<size_t>(state.range(0) * state.range(0));
+    RMAImages images(nPixels);
+    for (auto _: state) {
+        PackRMALoop(images.getMetallicRoughness(sources), images.getOcclusion(sources), images.rma.data(), nPixels);
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * images.rma.size()));
+}
+
+template<RMASources sources>
+static void BM_PackRMA(benchmark::State &state) {
+    size_t nPixels = static_cast<size_t>(state.range(0) * state.range(0));
+    RMAImages images(nPixels);
+    for (auto _: state) {
+        DAssetTools::PackRMA(images.getMetallicRoughness(sources), images.getOcclusion(sources), images.rma.data(),
+                             nPixels);
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * images.rma.size()));
+}
+
+// Square textures with 1K and 4K sides
+static void TextureSizes(benchmark::internal::Benchmark *benchmark) {
+    benchmark->Arg(1024)->Arg(4096)->Unit(benchmark::kMillisecond);
+}
+
+BENCHMARK_TEMPLATE(BM_PackRMALoop, RMASources::METALLIC_ROUGHNESS_AND_OCCLUSION)->Apply(TextureSizes);
+BENCHMARK_TEMPLATE(BM_PackRMA, RMASources::METALLIC_ROUGHNESS_AND_OCCLUSION)->Apply(TextureSizes);
+BENCHMARK_TEMPLATE(BM_PackRMALoop, RMASources::METALLIC_ROUGHNESS_ONLY)->Apply(TextureSizes);
+BENCHMARK_TEMPLATE(BM_PackRMA, RMASources::METALLIC_ROUGHNESS_ONLY)->Apply(TextureSizes);
+BENCHMARK_TEMPLATE(BM_PackRMALoop, RMASources::OCCLUSION_ONLY)->Apply(TextureSizes);
+BENCHMARK_TEMPLATE(BM_PackRMA, RMASources::OCCLUSION_ONLY)->Apply(TextureSizes);
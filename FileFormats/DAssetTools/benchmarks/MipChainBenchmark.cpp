@@ -0,0 +1,29 @@
+#include <benchmark/benchmark.h>
+#include <DAssetTools/MipChain.hpp>
+#include <random>
+#include <vector>
+
+template<DAssetTools::MipFilter filter, bool srgb>
+static void BM_Downsample(benchmark::State &state) {
+    uint32_t size = static_cast<uint32_t>(state.range(0));
+    std::vector<uint8_t> image(static_cast<size_t>(size) * size * 4);
+    std::mt19937 random(42);
+    for (auto &byte: image) {
+        byte = static_cast<uint8_t>(random());
+    }
+    for (auto _: state) {
+        auto level = DAssetTools::Downsample(image.data(), size, size, 4, filter, srgb);
+        benchmark::DoNotOptimize(level.data());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * image.size()));
+}
+
+// The first level of square RGBA textures with 1K and 4K sides
+static void TextureSizes(benchmark::internal::Benchmark *benchmark) {
+    benchmark->Arg(1024)->Arg(4096)->Unit(benchmark::kMillisecond);
+}
+
+BENCHMARK_TEMPLATE(BM_Downsample, DAssetTools::MipFilter::BOX, false)->Apply(TextureSizes);
+BENCHMARK_TEMPLATE(BM_Downsample, DAssetTools::MipFilter::BOX, true)->Apply(TextureSizes);
+BENCHMARK_TEMPLATE(BM_Downsample, DAssetTools::MipFilter::KAISER, false)->Apply(TextureSizes);
+BENCHMARK_TEMPLATE(BM_Downsample, DAssetTools::MipFilter::KAISER, true)->Apply(TextureSizes);
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+// Size in bytes of one compressed block of 4x4 pixels
+#define BC4_BLOCK_SIZE 8
+#define BC5_BLOCK_SIZE 16
+#define BC7_BLOCK_SIZE 16
+
+namespace DAssetTools {
+
+    /**
+     * Compresses one channel of an image to BC4.
+     * Blocks at the right and bottom edge of images whose size is not a multiple of 4 repeat the edge pixels.
+     * @param pixels the image, channels bytes per pixel, rows from top to bottom
+     * @param channel the channel of the pixels to compress
+     * @return the compressed blocks, row by row
+     */
+    std::vector<uint8_t> CompressBC4(const uint8_t *pixels, uint32_t width, uint32_t height, uint32_t channels,
+                                     uint32_t channel = 0);
+
+    /**
+     * Compresses the first two channels of an image to BC5, eg. the x and y of a tangent space normal map.
+     * @param pixels the image, channels bytes per pixel, rows from top to bottom. Must have at least 2 channels.
+     * @return the compressed blocks, row by row
+     */
+    std::vector<uint8_t> CompressBC5(const uint8_t *pixels, uint32_t width, uint32_t height, uint32_t channels);
+
+    /**
+     * Compresses an RGB or RGBA image to BC7.
+     * Every block is encoded in mode 6, a single pair of RGBA endpoints with 16 interpolation steps,
+     * which is fitted along the principal axis of the block's colors and refined by least squares.
+     * RGB images are compressed with an alpha of 255.
+     * @param pixels the image, channels bytes per pixel, rows from top to bottom
+     * @param channels 3 or 4
+     * @return the compressed blocks, row by row
+     */
+    std::vector<uint8_t> CompressBC7(const uint8_t *pixels, uint32_t width, uint32_t height, uint32_t channels);
+
+}
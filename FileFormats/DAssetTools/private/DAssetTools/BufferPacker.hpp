@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <vector>
+#include <DAsset/Asset.hpp>
+
+namespace DAssetTools {
+
+    /**
+     * @param gltfComponentType the componentType of a glTF accessor
+     * @return the data type of the accessor's components, which have the same size
+     */
+    DAsset::DataType GetGltfDataType(int gltfComponentType);
+
+    /**
+     * Packs the elements of glTF accessors into one DAsset buffer per glTF buffer.
+     * Strided elements are stored tightly packed, so bytes between them that no accessor references are dropped.
+     * Accessors with the same content share one buffer view, the content is compared by its XXH3 hash first.
+     * The buffers stay empty until #finish, since their bytes still move while they grow.
+     */
+    class BufferPacker {
+
+    private:
+        struct PackedBuffer {
+            std::shared_ptr<DAsset::Buffer> buffer;
+            // Appended to with each pack, handed to the buffer by finish
+            std::vector<uint8_t> bytes;
+        };
+
+        struct PackedBufferView {
+            DAsset::BufferView bufferView;
+            // The packed buffer of the view's buffer, map nodes don't move
+            const PackedBuffer *packedBuffer;
+        };
+
+        /**
+         * Key: glTF buffer index
+         * Value: DAsset buffer its accessors are packed into
+         */
+        std::map<uint64_t, PackedBuffer> buffers{};
+
+        /**
+         * Key: XXH3 hash of the packed elements
+         * Value: buffer views of packed elements with that hash
+         */
+        std::multimap<uint64_t, PackedBufferView> bufferViewsByHash{};
+
+        uint64_t packedBytes = 0;
+        uint64_t deduplicatedBytes = 0;
+        bool finished = false;
+
+    public:
+        /**
+         * @param sourceBufferIndex the glTF buffer the elements are in
+         * @param elements the first element
+         * @param count the number of elements
+         * @param byteStride the bytes from the start of one element to the start of the next,
+         * 0 if the elements are tightly packed
+         * @return a view of the tightly packed elements
+         * @throws IllegalStateException if the packer is finished
+         */
+        DAsset::BufferView pack(DAsset::BufferCollection &bufferCollection, uint64_t sourceBufferIndex,
+                                const uint8_t *elements, uint64_t count, uint64_t byteStride,
+                                DAsset::DataType dataType, DAsset::ComponentType componentType);
+
+        /**
+         * Packs the indices of a glTF accessor like #pack. Graphics APIs have no 8-bit index buffers,
+         * so UNSIGNED_BYTE indices are widened to UNSIGNED_SHORT.
+         * @throws IllegalArgumentException if the data type is not one glTF allows for indices
+         */
+        DAsset::BufferView packIndices(DAsset::BufferCollection &bufferCollection, uint64_t sourceBufferIndex,
+                                       const uint8_t *indices, uint64_t count, uint64_t byteStride,
+                                       DAsset::DataType dataType);
+
+        /**
+         * Sets the data of the buffers to the packed bytes. Nothing can be packed afterwards.
+         */
+        void finish();
+
+        /**
+         * @return the bytes of elements stored in DAsset buffers
+         */
+        [[nodiscard]] uint64_t getPackedBytes() const;
+
+        /**
+         * @return the bytes of elements not stored again because the same content was already packed
+         */
+        [[nodiscard]] uint64_t getDeduplicatedBytes() const;
+    };
+
+}
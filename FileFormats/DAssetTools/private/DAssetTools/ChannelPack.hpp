@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+namespace DAssetTools {
+
+    /**
+     * The instruction sets the channel pack kernels are implemented with
+     */
+    enum class SimdLevel {
+        SCALAR,
+        SSSE3,
+        AVX2
+    };
+
+    /**
+     * @return the best instruction set supported by the CPU, SCALAR on other architectures than x86
+     */
+    SimdLevel GetSimdLevel();
+
+    /**
+     * Packs a glTF metallic-roughness and occlusion texture into one RGB texture
+     * (R = roughness, G = metalness, B = ambient occlusion).
+     * Roughness and metalness are taken from the green and blue channel of the metallic-roughness texture,
+     * ambient occlusion from the single channel of the occlusion texture.
+     * Uses AVX2 or SSSE3 byte shuffles if the CPU supports them.
+     * @param metallicRoughness RGB pixels, or nullptr to fill roughness and metalness with 0
+     * @param occlusion single channel pixels, or nullptr to fill ambient occlusion with 0
+     * @param rma the memory to write the nPixels * 3 packed bytes to
+     * @param nPixels the number of pixels
+     */
+    void PackRMA(const uint8_t *metallicRoughness, const uint8_t *occlusion, uint8_t *rma, size_t nPixels);
+
+    /**
+     * PackRMA with the kernel of the given instruction set, so the kernels can be compared with each other.
+     * @throws IllegalArgumentException if the CPU does not support the instruction set
+     */
+    void PackRMA(const uint8_t *metallicRoughness, const uint8_t *occlusion, uint8_t *rma, size_t nPixels,
+                 SimdLevel simdLevel);
+
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+namespace DAssetTools {
+
+    enum class MipFilter {
+        // Average of 2x2 pixels
+        BOX,
+        // 8x8 pixel Kaiser windowed sinc, keeps more detail and aliases less than the box filter
+        KAISER
+    };
+
+    /**
+     * @return the number of mip levels of an image, from the full size level down to 1x1 pixels
+     */
+    uint32_t GetMipLevelCount(uint32_t width, uint32_t height);
+
+    /**
+     * Computes the next mip level of an image, half as wide and high, rounded down to at least 1 pixel.
+     * Pixels outside the image repeat the edge pixels.
+     * Filters 4 channels at once with SSE2 if the target supports it.
+     * @param pixels the image, channels bytes per pixel, rows from top to bottom
+     * @param channels 1 to 4
+     * @param srgb whether the first 3 channels are sRGB encoded colors, which are then filtered in linear space.
+     * A 4th channel is always filtered as it is.
+     * @return the pixels of the next level, with the same channels
+     */
+    std::vector<uint8_t> Downsample(const uint8_t *pixels, uint32_t width, uint32_t height, uint32_t channels,
+                                    MipFilter filter, bool srgb);
+
+}
@@ -0,0 +1,359 @@
+#include <DAssetTools/BlockCompression.hpp>
+#include <ErrorHandling/IllegalArgumentException.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+using namespace DAssetTools;
+
+// Interpolation weights of BC7's 4-bit indices, in 64ths of the second endpoint
+static const int BC7_WEIGHTS_4[16] = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+// Least squares refinements of the BC7 endpoints after the principal axis fit
+#define BC7_REFINE_ITERATIONS 2
+
+/**
+ * Copies a 4x4 block into RGBA pixels.
+ * Pixels outside the image repeat the last row and column, missing channels are 0 and alpha is 255.
+ */
+static void LoadBlock(const uint8_t *pixels, uint32_t width, uint32_t height, uint32_t channels,
+                      uint32_t blockX, uint32_t blockY, uint8_t block[16][4]) {
+    for (uint32_t y = 0; y < 4; y++) {
+        uint32_t row = std::min(blockY * 4 + y, height - 1);
+        for (uint32_t x = 0; x < 4; x++) {
+            uint32_t column = std::min(blockX * 4 + x, width - 1);
+            const uint8_t *pixel = pixels + (static_cast<size_t>(row) * width + column) * channels;
+            uint8_t *blockPixel = block[y * 4 + x];
+            for (uint32_t channel = 0; channel < 4; channel++) {
+                blockPixel[channel] = channel < channels ? pixel[channel] : channel == 3 ? 255 : 0;
+            }
+        }
+    }
+}
+
+static void CheckImage(uint32_t width, uint32_t height, uint32_t channels, uint32_t minChannels) {
+    if (width == 0 || height == 0) {
+        RAISE_EXCEPTION(errorhandling::IllegalArgumentException, "Cannot compress an empty image");
+    }
+    if (channels < minChannels || channels > 4) {
+        RAISE_EXCEPTION(errorhandling::IllegalArgumentException,
+                        "Cannot compress an image with " + std::to_string(channels) + " channels");
+    }
+}
+
+/**
+ * Appends a BC4 block of the given channel of the pixels.
+ * The endpoints are the lowest and highest value, interpolated in 8 steps.
+ */
+static void CompressBC4Block(const uint8_t block[16][4], uint32_t channel, uint8_t *output) {
+    uint8_t low = 255, high = 0;
+    for (int i = 0; i < 16; i++) {
+        low = std::min(low, block[i][channel]);
+        high = std::max(high, block[i][channel]);
+    }
+    // The first endpoint being larger selects the mode with 6 interpolated values between the endpoints.
+    // Equal endpoints select the other mode, whose first value is also the first endpoint.
+    int palette[8] = {high, low};
+    for (int i = 2; i < 8; i++) {
+        palette[i] = ((8 - i) * high + (i - 1) * low + 3) / 7;
+    }
+    uint64_t indexBits = 0;
+    for (int i = 0; i < 16; i++) {
+        int value = block[i][channel];
+        uint64_t bestIndex = 0;
+        int bestError = 256;
+        for (int index = 0; index < 8; index++) {
+            int error = std::abs(palette[index] - value);
+            if (error < bestError) {
+                bestError = error;
+                bestIndex = index;
+            }
+        }
+        indexBits |= bestIndex << (i * 3);
+    }
+    output[0] = high;
+    output[1] = low;
+    for (int i = 0; i < 6; i++) {
+        output[2 + i] = static_cast<uint8_t>(indexBits >> (i * 8));
+    }
+}
+
+std::vector<uint8_t> DAssetTools::CompressBC4(const uint8_t *pixels, uint32_t width, uint32_t height,
+                                              uint32_t channels, uint32_t channel) {
+    CheckImage(width, height, channels, channel + 1);
+    uint32_t blocksX = (width + 3) / 4, blocksY = (height + 3) / 4;
+    std::vector<uint8_t> blocks(static_cast<size_t>(blocksX) * blocksY * BC4_BLOCK_SIZE);
+    uint8_t *output = blocks.data();
+    uint8_t block[16][4];
+    for (uint32_t blockY = 0; blockY < blocksY; blockY++) {
+        for (uint32_t blockX = 0; blockX < blocksX; blockX++) {
+            LoadBlock(pixels, width, height, channels, blockX, blockY, block);
+            CompressBC4Block(block, channel, output);
+            output += BC4_BLOCK_SIZE;
+        }
+    }
+    return blocks;
+}
+
+std::vector<uint8_t> DAssetTools::CompressBC5(const uint8_t *pixels, uint32_t width, uint32_t height,
+                                              uint32_t channels) {
+    CheckImage(width, height, channels, 2);
+    uint32_t blocksX = (width + 3) / 4, blocksY = (height + 3) / 4;
+    std::vector<uint8_t> blocks(static_cast<size_t>(blocksX) * blocksY * BC5_BLOCK_SIZE);
+    uint8_t *output = blocks.data();
+    uint8_t block[16][4];
+    for (uint32_t blockY = 0; blockY < blocksY; blockY++) {
+        for (uint32_t blockX = 0; blockX < blocksX; blockX++) {
+            LoadBlock(pixels, width, height, channels, blockX, blockY, block);
+            // A BC5 block is a BC4 block of the red channel followed by one of the green channel
+            CompressBC4Block(block, 0, output);
+            CompressBC4Block(block, 1, output + BC4_BLOCK_SIZE);
+            output += BC5_BLOCK_SIZE;
+        }
+    }
+    return blocks;
+}
+
+/**
+ * A BC7 mode 6 block before it is packed into bits
+ */
+struct BC7Mode6Block {
+    // Endpoint colors with 7 bits per channel, the shared lowest bit of each endpoint is its p-bit
+    uint8_t endpoints[2][4];
+    uint8_t pBits[2];
+    uint8_t indices[16];
+    // Sum of the squared differences of the decoded block to the original pixels
+    uint64_t error;
+};
+
+/**
+ * Rounds an endpoint to 7 bits per channel and the p-bit that together come closest to it
+ * @param opaque whether the p-bit has to be 1, the only way to encode an alpha of 255
+ */
+static void QuantizeEndpoint(const float endpoint[4], bool opaque, uint8_t quantized[4], uint8_t &pBit) {
+    float bestError = INFINITY;
+    for (uint8_t candidatePBit = opaque ? 1 : 0; candidatePBit < 2; candidatePBit++) {
+        uint8_t candidate[4];
+        float error = 0;
+        for (int channel = 0; channel < 4; channel++) {
+            float value = std::round((endpoint[channel] - candidatePBit) / 2.0f);
+            candidate[channel] = static_cast<uint8_t>(std::clamp(value, 0.0f, 127.0f));
+            float difference = static_cast<float>(candidate[channel] * 2 + candidatePBit) - endpoint[channel];
+            error += difference * difference;
+        }
+        if (error < bestError) {
+            bestError = error;
+            pBit = candidatePBit;
+            memcpy(quantized, candidate, 4);
+        }
+    }
+}
+
+/**
+ * Quantizes the endpoints and picks the closest of the 16 interpolated colors for every pixel
+ */
+static BC7Mode6Block EncodeBC7Mode6(const uint8_t block[16][4], bool opaque, const float endpoint0[4],
+                                    const float endpoint1[4]) {
+    BC7Mode6Block encoded{};
+    QuantizeEndpoint(endpoint0, opaque, encoded.endpoints[0], encoded.pBits[0]);
+    QuantizeEndpoint(endpoint1, opaque, encoded.endpoints[1], encoded.pBits[1]);
+
+    int palette[16][4];
+    for (int channel = 0; channel < 4; channel++) {
+        int value0 = encoded.endpoints[0][channel] * 2 + encoded.pBits[0];
+        int value1 = encoded.endpoints[1][channel] * 2 + encoded.pBits[1];
+        for (int index = 0; index < 16; index++) {
+            palette[index][channel] = ((64 - BC7_WEIGHTS_4[index]) * value0 + BC7_WEIGHTS_4[index] * value1 + 32) >> 6;
+        }
+    }
+    for (int i = 0; i < 16; i++) {
+        int bestError = INT32_MAX;
+        for (int index = 0; index < 16; index++) {
+            int error = 0;
+            for (int channel = 0; channel < 4; channel++) {
+                int difference = palette[index][channel] - block[i][channel];
+                error += difference * difference;
+            }
+            if (error < bestError) {
+                bestError = error;
+                encoded.indices[i] = static_cast<uint8_t>(index);
+            }
+        }
+        encoded.error += bestError;
+    }
+    return encoded;
+}
+
+/**
+ * Fits the endpoints that minimize the squared error for the current indices
+ * @return false if all pixels use the same weight, which leaves the endpoints undetermined
+ */
+static bool RefineBC7Endpoints(const uint8_t block[16][4], const uint8_t indices[16], float endpoint0[4],
+                               float endpoint1[4]) {
+    float weight00 = 0, weight01 = 0, weight11 = 0;
+    float sum0[4]{}, sum1[4]{};
+    for (int i = 0; i < 16; i++) {
+        float weight1 = BC7_WEIGHTS_4[indices[i]] / 64.0f;
+        float weight0 = 1.0f - weight1;
+        weight00 += weight0 * weight0;
+        weight01 += weight0 * weight1;
+        weight11 += weight1 * weight1;
+        for (int channel = 0; channel < 4; channel++) {
+            sum0[channel] += weight0 * block[i][channel];
+            sum1[channel] += weight1 * block[i][channel];
+        }
+    }
+    float determinant = weight00 * weight11 - weight01 * weight01;
+    if (std::abs(determinant) < 1e-6f) {
+        return false;
+    }
+    for (int channel = 0; channel < 4; channel++) {
+        endpoint0[channel] = std::clamp((weight11 * sum0[channel] - weight01 * sum1[channel]) / determinant,
+                                        0.0f, 255.0f);
+        endpoint1[channel] = std::clamp((weight00 * sum1[channel] - weight01 * sum0[channel]) / determinant,
+                                        0.0f, 255.0f);
+    }
+    return true;
+}
+
+/**
+ * Finds the endpoints at the extremes of the block's colors along their principal axis
+ */
+static void FitBC7Endpoints(const uint8_t block[16][4], float endpoint0[4], float endpoint1[4]) {
+    float mean[4]{};
+    for (int i = 0; i < 16; i++) {
+        for (int channel = 0; channel < 4; channel++) {
+            mean[channel] += block[i][channel] / 16.0f;
+        }
+    }
+    float covariance[4][4]{};
+    for (int i = 0; i < 16; i++) {
+        float difference[4];
+        for (int channel = 0; channel < 4; channel++) {
+            difference[channel] = block[i][channel] - mean[channel];
+        }
+        for (int row = 0; row < 4; row++) {
+            for (int column = 0; column < 4; column++) {
+                covariance[row][column] += difference[row] * difference[column];
+            }
+        }
+    }
+    // Power iteration, starting from the diagonal, which is close to the axis for most blocks
+    float axis[4];
+    for (int channel = 0; channel < 4; channel++) {
+        axis[channel] = covariance[channel][channel];
+    }
+    for (int iteration = 0; iteration < 8; iteration++) {
+        float next[4]{};
+        float length = 0;
+        for (int row = 0; row < 4; row++) {
+            for (int column = 0; column < 4; column++) {
+                next[row] += covariance[row][column] * axis[column];
+            }
+            length = std::max(length, std::abs(next[row]));
+        }
+        if (length == 0) {
+            break;
+        }
+        for (int channel = 0; channel < 4; channel++) {
+            axis[channel] = next[channel] / length;
+        }
+    }
+    float axisLengthSquared = 0;
+    for (float component: axis) {
+        axisLengthSquared += component * component;
+    }
+    float minProjection = 0, maxProjection = 0;
+    if (axisLengthSquared > 0) {
+        minProjection = INFINITY;
+        maxProjection = -INFINITY;
+        for (int i = 0; i < 16; i++) {
+            float projection = 0;
+            for (int channel = 0; channel < 4; channel++) {
+                projection += (block[i][channel] - mean[channel]) * axis[channel];
+            }
+            projection /= axisLengthSquared;
+            minProjection = std::min(minProjection, projection);
+            maxProjection = std::max(maxProjection, projection);
+        }
+    }
+    for (int channel = 0; channel < 4; channel++) {
+        endpoint0[channel] = std::clamp(mean[channel] + minProjection * axis[channel], 0.0f, 255.0f);
+        endpoint1[channel] = std::clamp(mean[channel] + maxProjection * axis[channel], 0.0f, 255.0f);
+    }
+}
+
+/**
+ * Writes the bits of a block from the lowest bit of the first byte on
+ */
+struct BlockBitWriter {
+    uint8_t *output;
+    uint32_t position = 0;
+
+    void write(uint32_t value, uint32_t nBits) {
+        for (uint32_t bit = 0; bit < nBits; bit++, position++) {
+            output[position / 8] |= static_cast<uint8_t>(((value >> bit) & 1) << (position % 8));
+        }
+    }
+};
+
+static void PackBC7Mode6(BC7Mode6Block encoded, uint8_t *output) {
+    // The highest bit of the first pixel's index is implied to be 0, which is achieved by swapping the endpoints
+    if (encoded.indices[0] >= 8) {
+        std::swap(encoded.endpoints[0], encoded.endpoints[1]);
+        std::swap(encoded.pBits[0], encoded.pBits[1]);
+        for (auto &index: encoded.indices) {
+            index = 15 - index;
+        }
+    }
+    memset(output, 0, BC7_BLOCK_SIZE);
+    BlockBitWriter writer{output};
+    // Mode 6 is selected by 6 zero bits followed by a one bit
+    writer.write(1 << 6, 7);
+    for (int channel = 0; channel < 4; channel++) {
+        writer.write(encoded.endpoints[0][channel], 7);
+        writer.write(encoded.endpoints[1][channel], 7);
+    }
+    writer.write(encoded.pBits[0], 1);
+    writer.write(encoded.pBits[1], 1);
+    writer.write(encoded.indices[0], 3);
+    for (int i = 1; i < 16; i++) {
+        writer.write(encoded.indices[i], 4);
+    }
+}
+
+static void CompressBC7Block(const uint8_t block[16][4], uint8_t *output) {
+    // Opaque blocks have to stay exactly opaque, even where a p-bit of 0 would fit the colors better
+    bool opaque = std::all_of(block, block + 16, [](const uint8_t *pixel) { return pixel[3] == 255; });
+    float endpoint0[4], endpoint1[4];
+    FitBC7Endpoints(block, endpoint0, endpoint1);
+    BC7Mode6Block best = EncodeBC7Mode6(block, opaque, endpoint0, endpoint1);
+    for (int iteration = 0; iteration < BC7_REFINE_ITERATIONS && best.error > 0; iteration++) {
+        if (!RefineBC7Endpoints(block, best.indices, endpoint0, endpoint1)) {
+            break;
+        }
+        BC7Mode6Block refined = EncodeBC7Mode6(block, opaque, endpoint0, endpoint1);
+        if (refined.error >= best.error) {
+            break;
+        }
+        best = refined;
+    }
+    PackBC7Mode6(best, output);
+}
+
+std::vector<uint8_t> DAssetTools::CompressBC7(const uint8_t *pixels, uint32_t width, uint32_t height,
+                                              uint32_t channels) {
+    CheckImage(width, height, channels, 3);
+    uint32_t blocksX = (width + 3) / 4, blocksY = (height + 3) / 4;
+    std::vector<uint8_t> blocks(static_cast<size_t>(blocksX) * blocksY * BC7_BLOCK_SIZE);
+    uint8_t *output = blocks.data();
+    uint8_t block[16][4];
+    for (uint32_t blockY = 0; blockY < blocksY; blockY++) {
+        for (uint32_t blockX = 0; blockX < blocksX; blockX++) {
+            LoadBlock(pixels, width, height, channels, blockX, blockY, block);
+            CompressBC7Block(block, output);
+            output += BC7_BLOCK_SIZE;
+        }
+    }
+    return blocks;
+}
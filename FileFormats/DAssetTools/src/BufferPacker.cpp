@@ -0,0 +1,143 @@
+#include "DAssetTools/BufferPacker.hpp"
+#include <ErrorHandling/IllegalArgumentException.hpp>
+#include <Stream/Xxh3.hpp>
+#include <ErrorHandling/IllegalStateException.hpp>
+#include <cstring>
+#include <vector>
+
+// Component types of glTF accessors, the OpenGL enums of the types
+#define GLTF_COMPONENT_TYPE_BYTE 5120
+#define GLTF_COMPONENT_TYPE_UNSIGNED_BYTE 5121
+#define GLTF_COMPONENT_TYPE_SHORT 5122
+#define GLTF_COMPONENT_TYPE_UNSIGNED_SHORT 5123
+#define GLTF_COMPONENT_TYPE_INT 5124
+#define GLTF_COMPONENT_TYPE_UNSIGNED_INT 5125
+#define GLTF_COMPONENT_TYPE_FLOAT 5126
+
+DAsset::DataType DAssetTools::GetGltfDataType(int gltfComponentType) {
+    switch (gltfComponentType) {
+        case GLTF_COMPONENT_TYPE_BYTE:
+            return DAsset::DataType::BYTE;
+        case GLTF_COMPONENT_TYPE_UNSIGNED_BYTE:
+            return DAsset::DataType::UNSIGNED_BYTE;
+        case GLTF_COMPONENT_TYPE_SHORT:
+            return DAsset::DataType::SHORT;
+        case GLTF_COMPONENT_TYPE_UNSIGNED_SHORT:
+            return DAsset::DataType::UNSIGNED_SHORT;
+        case GLTF_COMPONENT_TYPE_INT:
+            return DAsset::DataType::INT;
+        case GLTF_COMPONENT_TYPE_UNSIGNED_INT:
+            return DAsset::DataType::UNSIGNED_INT;
+        case GLTF_COMPONENT_TYPE_FLOAT:
+            return DAsset::DataType::FLOAT;
+        default:
+            RAISE_EXCEPTION(errorhandling::IllegalStateException,
+                            "Unknown gltf component type " + std::to_string(gltfComponentType));
+    }
+}
+
+DAsset::BufferView
+DAssetTools::BufferPacker::pack(DAsset::BufferCollection &bufferCollection, uint64_t sourceBufferIndex,
+                                const uint8_t *elements, uint64_t count, uint64_t byteStride,
+                                DAsset::DataType dataType, DAsset::ComponentType componentType) {
+    if (finished) {
+        RAISE_EXCEPTION(errorhandling::IllegalStateException, "Buffer packer is already finished");
+    }
+    uint64_t elementSize = DAsset::GetSize(dataType, componentType);
+    if (byteStride == 0) {
+        byteStride = elementSize;
+    }
+    if (byteStride < elementSize) {
+        RAISE_EXCEPTION(errorhandling::IllegalArgumentException,
+                        "Byte stride " + std::to_string(byteStride) + " is smaller than the element size " +
+                        std::to_string(elementSize));
+    }
+
+    std::vector<uint8_t> packedElements(count * elementSize);
+    if (byteStride == elementSize) {
+        std::memcpy(packedElements.data(), elements, packedElements.size());
+    } else {
+        for (uint64_t element = 0; element < count; element++) {
+            std::memcpy(&packedElements[element * elementSize], elements + element * byteStride, elementSize);
+        }
+    }
+
+    auto hash = Stream::Xxh3::Hash(packedElements.data(), packedElements.size());
+    auto [first, last] = bufferViewsByHash.equal_range(hash);
+    for (auto it = first; it != last; it++) {
+        auto &[bufferView, packedBuffer] = it->second;
+        if (bufferView.byteLength == packedElements.size() && bufferView.dataType == dataType &&
+            bufferView.componentType == componentType &&
+            std::memcmp(packedBuffer->bytes.data() + bufferView.byteOffset, packedElements.data(),
+                        packedElements.size()) == 0) {
+            deduplicatedBytes += packedElements.size();
+            return bufferView;
+        }
+    }
+
+    auto &packedBuffer = buffers[sourceBufferIndex];
+    if (packedBuffer.buffer == nullptr) {
+        packedBuffer.buffer = bufferCollection.newBuffer(nullptr, 0);
+    }
+    auto &bytes = packedBuffer.bytes;
+    // Elements start at a multiple of their component size
+    uint64_t alignment = DAsset::GetSize(dataType, DAsset::ComponentType::SCALAR);
+    uint64_t byteOffset = (bytes.size() + alignment - 1) / alignment * alignment;
+    bytes.resize(byteOffset);
+    bytes.insert(bytes.end(), packedElements.begin(), packedElements.end());
+    packedBytes += packedElements.size();
+
+    DAsset::BufferView bufferView{
+            .byteOffset = byteOffset,
+            .byteLength = packedElements.size(),
+            .byteStride = elementSize,
+            .dataType = dataType,
+            .componentType = componentType,
+            .buffer = packedBuffer.buffer
+    };
+    bufferViewsByHash.emplace(hash, PackedBufferView{bufferView, &packedBuffer});
+    return bufferView;
+}
+
+DAsset::BufferView
+DAssetTools::BufferPacker::packIndices(DAsset::BufferCollection &bufferCollection, uint64_t sourceBufferIndex,
+                                       const uint8_t *indices, uint64_t count, uint64_t byteStride,
+                                       DAsset::DataType dataType) {
+    if (dataType == DAsset::DataType::UNSIGNED_SHORT || dataType == DAsset::DataType::UNSIGNED_INT) {
+        return pack(bufferCollection, sourceBufferIndex, indices, count, byteStride, dataType,
+                    DAsset::ComponentType::SCALAR);
+    }
+    if (dataType != DAsset::DataType::UNSIGNED_BYTE) {
+        RAISE_EXCEPTION(errorhandling::IllegalArgumentException,
+                        "Indices must be unsigned integers, not " + DAsset::GetDataTypeName(dataType));
+    }
+    if (byteStride == 0) {
+        byteStride = 1;
+    }
+    // Little-endian, like all glTF data
+    std::vector<uint8_t> widenedIndices(count * 2);
+    for (uint64_t index = 0; index < count; index++) {
+        widenedIndices[index * 2] = indices[index * byteStride];
+    }
+    return pack(bufferCollection, sourceBufferIndex, widenedIndices.data(), count, 0,
+                DAsset::DataType::UNSIGNED_SHORT, DAsset::ComponentType::SCALAR);
+}
+
+void DAssetTools::BufferPacker::finish() {
+    if (finished) {
+        return;
+    }
+    finished = true;
+    for (auto &[sourceBufferIndex, packedBuffer]: buffers) {
+        packedBuffer.buffer->data = DAsset::ByteSpan(std::move(packedBuffer.bytes));
+    }
+    bufferViewsByHash.clear();
+}
+
+uint64_t DAssetTools::BufferPacker::getPackedBytes() const {
+    return packedBytes;
+}
+
+uint64_t DAssetTools::BufferPacker::getDeduplicatedBytes() const {
+    return deduplicatedBytes;
+}
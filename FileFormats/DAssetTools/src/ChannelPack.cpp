@@ -0,0 +1,226 @@
+#include <DAssetTools/ChannelPack.hpp>
+#include <ErrorHandling/IllegalArgumentException.hpp>
+#include <cstring>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define CHANNEL_PACK_X86
+
+#include <immintrin.h>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+// MSVC allows intrinsics of any instruction set without compiler flags
+#define CHANNEL_PACK_TARGET(instructionSet)
+#else
+#define CHANNEL_PACK_TARGET(instructionSet) __attribute__((target(instructionSet)))
+#endif
+
+#endif
+
+using namespace DAssetTools;
+
+static SimdLevel DetectSimdLevel() {
+#ifdef CHANNEL_PACK_X86
+#ifdef _MSC_VER
+    int cpuInfo[4];
+    __cpuid(cpuInfo, 1);
+    bool ssse3 = (cpuInfo[2] & (1 << 9)) != 0;
+    // AVX registers are only usable if the OS saves them on context switches
+    bool osAvx = (cpuInfo[2] & (1 << 27)) != 0 && (_xgetbv(0) & 0x6) == 0x6;
+    __cpuidex(cpuInfo, 7, 0);
+    bool avx2 = osAvx && (cpuInfo[1] & (1 << 5)) != 0;
+#else
+    __builtin_cpu_init();
+    bool ssse3 = __builtin_cpu_supports("ssse3");
+    bool avx2 = __builtin_cpu_supports("avx2");
+#endif
+    if (avx2) {
+        return SimdLevel::AVX2;
+    }
+    if (ssse3) {
+        return SimdLevel::SSSE3;
+    }
+#endif
+    return SimdLevel::SCALAR;
+}
+
+SimdLevel DAssetTools::GetSimdLevel() {
+    static const SimdLevel simdLevel = DetectSimdLevel();
+    return simdLevel;
+}
+
+template<bool hasMetallicRoughness, bool hasOcclusion>
+static void PackRMAScalar(const uint8_t *metallicRoughness, const uint8_t *occlusion, uint8_t *rma, size_t nPixels) {
+    for (size_t pixel = 0; pixel < nPixels; pixel++) {
+        if constexpr (hasMetallicRoughness) {
+            rma[0] = metallicRoughness[1];
+            rma[1] = metallicRoughness[2];
+            metallicRoughness += 3;
+        } else {
+            rma[0] = 0;
+            rma[1] = 0;
+        }
+        if constexpr (hasOcclusion) {
+            rma[2] = occlusion[pixel];
+        } else {
+            rma[2] = 0;
+        }
+        rma += 3;
+    }
+}
+
+#ifdef CHANNEL_PACK_X86
+
+/*
+ * Every third output byte is ambient occlusion, all others are the metallic-roughness byte one position further,
+ * so the output is the metallic-roughness data loaded at an offset of one byte,
+ * with the occlusion bytes shuffled into every third position.
+ * 16 bytes are 5 1/3 pixels, so the positions of the occlusion bytes repeat only every 3 blocks.
+ */
+struct PackRMATables {
+    // Per block: 0xFF where the output is a metallic-roughness byte, 0 where it is an occlusion byte
+    alignas(32) uint8_t keepMasks[3][32];
+    // Per block: index of the occlusion byte in the shuffled register, or 0x80 (shuffles in 0) for the other bytes
+    alignas(32) uint8_t occlusionShuffles[3][32];
+};
+
+static PackRMATables MakePackRMATables(size_t blockSize) {
+    PackRMATables tables{};
+    for (size_t block = 0; block < 3; block++) {
+        for (size_t i = 0; i < blockSize; i++) {
+            size_t outputIndex = block * blockSize + i;
+            if (outputIndex % 3 != 2) {
+                tables.keepMasks[block][i] = 0xFF;
+                tables.occlusionShuffles[block][i] = 0x80;
+                continue;
+            }
+            size_t occlusionIndex = outputIndex / 3;
+            if (blockSize == 32) {
+                // AVX2 shuffles within 128-bit lanes. The lanes of the first block are both filled with the low
+                // 16 occlusion bytes, the lanes of the last block with the high ones, the middle block gets one each.
+                size_t lane = i / 16;
+                size_t sourceHalf = block == 0 ? 0 : block == 2 ? 1 : lane;
+                occlusionIndex -= sourceHalf * 16;
+            }
+            tables.keepMasks[block][i] = 0;
+            tables.occlusionShuffles[block][i] = static_cast<uint8_t>(occlusionIndex);
+        }
+    }
+    return tables;
+}
+
+template<bool hasMetallicRoughness, bool hasOcclusion>
+CHANNEL_PACK_TARGET("ssse3")
+static size_t PackRMASsse3(const uint8_t *metallicRoughness, const uint8_t *occlusion, uint8_t *rma, size_t nPixels) {
+    static const PackRMATables tables = MakePackRMATables(16);
+    __m128i keepMasks[3], occlusionShuffles[3];
+    for (int block = 0; block < 3; block++) {
+        keepMasks[block] = _mm_load_si128(reinterpret_cast<const __m128i *>(tables.keepMasks[block]));
+        occlusionShuffles[block] = _mm_load_si128(reinterpret_cast<const __m128i *>(tables.occlusionShuffles[block]));
+    }
+    size_t pixel = 0;
+    // The offset metallic-roughness loads read one byte past the 16 pixels, which must still be inside the image
+    for (; pixel + 16 < nPixels; pixel += 16) {
+        __m128i occlusionBytes{};
+        if constexpr (hasOcclusion) {
+            occlusionBytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(occlusion + pixel));
+        }
+        for (int block = 0; block < 3; block++) {
+            __m128i packed;
+            if constexpr (hasMetallicRoughness) {
+                packed = _mm_and_si128(keepMasks[block], _mm_loadu_si128(
+                        reinterpret_cast<const __m128i *>(metallicRoughness + pixel * 3 + block * 16 + 1)));
+                if constexpr (hasOcclusion) {
+                    packed = _mm_or_si128(packed, _mm_shuffle_epi8(occlusionBytes, occlusionShuffles[block]));
+                }
+            } else {
+                packed = _mm_shuffle_epi8(occlusionBytes, occlusionShuffles[block]);
+            }
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(rma + pixel * 3 + block * 16), packed);
+        }
+    }
+    return pixel;
+}
+
+template<bool hasMetallicRoughness, bool hasOcclusion>
+CHANNEL_PACK_TARGET("avx2")
+static size_t PackRMAAvx2(const uint8_t *metallicRoughness, const uint8_t *occlusion, uint8_t *rma, size_t nPixels) {
+    static const PackRMATables tables = MakePackRMATables(32);
+    __m256i keepMasks[3], occlusionShuffles[3];
+    for (int block = 0; block < 3; block++) {
+        keepMasks[block] = _mm256_load_si256(reinterpret_cast<const __m256i *>(tables.keepMasks[block]));
+        occlusionShuffles[block] = _mm256_load_si256(
+                reinterpret_cast<const __m256i *>(tables.occlusionShuffles[block]));
+    }
+    size_t pixel = 0;
+    for (; pixel + 32 < nPixels; pixel += 32) {
+        __m256i occlusionSources[3]{};
+        if constexpr (hasOcclusion) {
+            __m256i occlusionBytes = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(occlusion + pixel));
+            occlusionSources[0] = _mm256_permute2x128_si256(occlusionBytes, occlusionBytes, 0x00);
+            occlusionSources[1] = occlusionBytes;
+            occlusionSources[2] = _mm256_permute2x128_si256(occlusionBytes, occlusionBytes, 0x11);
+        }
+        for (int block = 0; block < 3; block++) {
+            __m256i packed;
+            if constexpr (hasMetallicRoughness) {
+                packed = _mm256_and_si256(keepMasks[block], _mm256_loadu_si256(
+                        reinterpret_cast<const __m256i *>(metallicRoughness + pixel * 3 + block * 32 + 1)));
+                if constexpr (hasOcclusion) {
+                    packed = _mm256_or_si256(packed,
+                                             _mm256_shuffle_epi8(occlusionSources[block], occlusionShuffles[block]));
+                }
+            } else {
+                packed = _mm256_shuffle_epi8(occlusionSources[block], occlusionShuffles[block]);
+            }
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(rma + pixel * 3 + block * 32), packed);
+        }
+    }
+    return pixel;
+}
+
+#endif
+
+template<bool hasMetallicRoughness, bool hasOcclusion>
+static void PackRMAWith(const uint8_t *metallicRoughness, const uint8_t *occlusion, uint8_t *rma, size_t nPixels,
+                        SimdLevel simdLevel) {
+    size_t nPacked = 0;
+#ifdef CHANNEL_PACK_X86
+    switch (simdLevel) {
+        case SimdLevel::AVX2:
+            nPacked = PackRMAAvx2<hasMetallicRoughness, hasOcclusion>(metallicRoughness, occlusion, rma, nPixels);
+            break;
+        case SimdLevel::SSSE3:
+            nPacked = PackRMASsse3<hasMetallicRoughness, hasOcclusion>(metallicRoughness, occlusion, rma, nPixels);
+            break;
+        default:
+            break;
+    }
+#endif
+    PackRMAScalar<hasMetallicRoughness, hasOcclusion>(
+            hasMetallicRoughness ? metallicRoughness + nPacked * 3 : nullptr,
+            hasOcclusion ? occlusion + nPacked : nullptr,
+            rma + nPacked * 3, nPixels - nPacked);
+}
+
+void DAssetTools::PackRMA(const uint8_t *metallicRoughness, const uint8_t *occlusion, uint8_t *rma, size_t nPixels) {
+    PackRMA(metallicRoughness, occlusion, rma, nPixels, GetSimdLevel());
+}
+
+void DAssetTools::PackRMA(const uint8_t *metallicRoughness, const uint8_t *occlusion, uint8_t *rma, size_t nPixels,
+                          SimdLevel simdLevel) {
+    // The levels are ordered, a CPU supporting one supports all lower ones
+    if (static_cast<int>(simdLevel) > static_cast<int>(GetSimdLevel())) {
+        RAISE_EXCEPTION(errorhandling::IllegalArgumentException,
+                        "The CPU does not support the instruction set of the PackRMA kernel");
+    }
+    if (metallicRoughness != nullptr && occlusion != nullptr) {
+        PackRMAWith<true, true>(metallicRoughness, occlusion, rma, nPixels, simdLevel);
+    } else if (metallicRoughness != nullptr) {
+        PackRMAWith<true, false>(metallicRoughness, nullptr, rma, nPixels, simdLevel);
+    } else if (occlusion != nullptr) {
+        PackRMAWith<false, true>(nullptr, occlusion, rma, nPixels, simdLevel);
+    } else {
+        memset(rma, 0, nPixels * 3);
+    }
+}
@@ -8,19 +8,52 @@
 
 #include <tiny_gltf.h>
 #include <DAsset/Asset.hpp>
+#include <DAssetTools/BlockCompression.hpp>
+#include <DAssetTools/ChannelPack.hpp>
+#include <DAssetTools/MipChain.hpp>
+#include <DAssetTools/BufferPacker.hpp>
 #include <iostream>
 #include <ErrorHandling/IllegalStateException.hpp>
 #include <ErrorHandling/IllegalArgumentException.hpp>
 
 #include <Stream/FileDataWriteStream.hpp>
+#include <Stream/HashingDataStream.hpp>
+#include <Utils/ParallelJobs.hpp>
+#include <iomanip>
 
 #include <glm/gtx/matrix_decompose.hpp>
 #include <glm/gtc/type_ptr.hpp>
 #include <queue>
 #include <map>
+#include <algorithm>
 
 DAsset::Asset FromTinyGLTF(const tinygltf::Model &model);
 
+enum class TextureJobKind {
+    // Re-encodes a glTF texture
+    TEXTURE,
+    // Packs a glTF metallic-roughness and occlusion texture into one RMA texture
+    RMA
+};
+
+/**
+ * Decoding and re-encoding of one texture, which is run on a worker thread after the scene has been converted.
+ * The texture and its buffer are created when the job is queued, so their ids do not depend on the order
+ * in which the jobs finish. The job fills in the image size and the encoded image data.
+ */
+struct TextureJob {
+    TextureJobKind kind;
+    // Format to store the texture in
+    DAsset::TextureFormat format;
+    // Whether the colors are sRGB encoded, their mips are then filtered in linear space
+    bool srgb;
+    int32_t textureIndex;
+    int32_t metallicRoughnessTextureIndex;
+    int32_t occlusionTextureIndex;
+    std::shared_ptr<DAsset::Texture> texture;
+    std::shared_ptr<DAsset::Buffer> buffer;
+};
+
 struct ConverterState {
 private:
     /**
@@ -41,6 +74,12 @@ private:
      */
     std::map<uint64_t, uint64_t> materialIndexToIdMapping{};
 
+    /**
+     * Key: glTF accessor index
+     * Value: DAsset buffer view of the accessor's elements
+     */
+    std::map<uint64_t, DAsset::BufferView> accessorIndexToBufferView{};
+
 public:
 
     std::optional<uint64_t> getRMATextureId(uint64_t key) {
@@ -79,6 +118,28 @@ public:
         materialIndexToIdMapping[gltfMaterialIndex] = dAssetMaterialId;
     }
 
+    std::optional<DAsset::BufferView> getAccessorBufferView(uint64_t gltfAccessorIndex) {
+        auto it = accessorIndexToBufferView.find(gltfAccessorIndex);
+        if (it == accessorIndexToBufferView.end()) {
+            return std::nullopt;
+        }
+        return it->second;
+    }
+
+    void setAccessorBufferView(uint64_t gltfAccessorIndex, const DAsset::BufferView &bufferView) {
+        accessorIndexToBufferView[gltfAccessorIndex] = bufferView;
+    }
+
+    /**
+     * Packs the accessors' elements into one buffer per glTF buffer
+     */
+    DAssetTools::BufferPacker bufferPacker{};
+
+    /**
+     * Texture jobs in the order their textures were created
+     */
+    std::vector<TextureJob> textureJobs{};
+
 };
 
 int main(int argc, char **argv) {
@@ -103,31 +164,15 @@ int main(int argc, char **argv) {
         return 1;
     }
     DAsset::Asset asset = FromTinyGLTF(model);
-    DAsset::WriteAsset(asset, Stream::FileDataWriteStream::Open(argv[2]));
-}
-
-DAsset::DataType GetDataType(int gltfComponentType) {
-    switch (gltfComponentType) {
-        case TINYGLTF_COMPONENT_TYPE_BYTE:
-            return DAsset::DataType::BYTE;
-        case TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE:
-            return DAsset::DataType::UNSIGNED_SHORT;
-        case TINYGLTF_COMPONENT_TYPE_SHORT:
-            return DAsset::DataType::SHORT;
-        case TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT:
-            return DAsset::DataType::UNSIGNED_SHORT;
-        case TINYGLTF_COMPONENT_TYPE_INT:
-            return DAsset::DataType::INT;
-        case TINYGLTF_COMPONENT_TYPE_UNSIGNED_INT:
-            return DAsset::DataType::UNSIGNED_SHORT;
-        case TINYGLTF_COMPONENT_TYPE_FLOAT:
-            return DAsset::DataType::FLOAT;
-        default:
-            RAISE_EXCEPTION(errorhandling::IllegalStateException, "Unknown gltf component type");
-    }
+    // The output is hashed while it is written, instead of reading the file again
+    auto hashingStream = std::make_unique<Stream::HashingWriteStream>(Stream::FileDataWriteStream::Open(argv[2]));
+    auto &hashedOutput = *hashingStream;
+    std::unique_ptr<Stream::DataWriteStream> outputStream(std::move(hashingStream));
+    DAsset::WriteAsset(asset, outputStream);
+    std::cout << "Wrote " << hashedOutput.getPosition() << " bytes, xxh3 " << std::hex << std::setw(16)
+              << std::setfill('0') << hashedOutput.getHash() << std::dec << std::endl;
 }
 
-
 DAsset::ComponentType GetComponentType(int gltfType) {
     switch (gltfType) {
         case TINYGLTF_TYPE_SCALAR:
@@ -194,7 +239,7 @@ stbi_uc *ReadTextureImageData(const tinygltf::Model &model, uint64_t textureInde
     auto &gltfImage = model.images[gltfTexture.source];
     auto &gltfBufferView = model.bufferViews[gltfImage.bufferView];
     auto &gltfBuffer = model.buffers[gltfBufferView.buffer];
-    auto bufferData = gltfBuffer.data;
+    const auto &bufferData = gltfBuffer.data;
     auto bufferSize = gltfBufferView.byteLength;
     auto bufferOffset = gltfBufferView.byteOffset;
     if (gltfBufferView.byteStride != 0) {
@@ -297,9 +342,174 @@ DAsset::SamplerAddressMode GetAddressMode(int gltfWrap) {
     }
 }
 
+/**
+ * Encodes one mip level of an image in the given format.
+ */
+std::vector<uint8_t> EncodeTextureLevel(DAsset::TextureFormat format, const uint8_t *imageData, uint32_t imageWidth,
+                                        uint32_t imageHeight, uint32_t imageChannels) {
+    switch (format) {
+        case DAsset::TextureFormat::BC4:
+            return DAssetTools::CompressBC4(imageData, imageWidth, imageHeight, imageChannels);
+        case DAsset::TextureFormat::BC5:
+            return DAssetTools::CompressBC5(imageData, imageWidth, imageHeight, imageChannels);
+        case DAsset::TextureFormat::BC7:
+            return DAssetTools::CompressBC7(imageData, imageWidth, imageHeight, imageChannels);
+        default: {
+            size_t encodedImageDataLength{};
+            auto encodedImageData = ImageEncode(imageData, imageWidth, imageHeight, imageChannels,
+                                                encodedImageDataLength);
+            std::vector<uint8_t> data(encodedImageData, encodedImageData + encodedImageDataLength);
+            delete[] encodedImageData;
+            return data;
+        }
+    }
+}
+
+/**
+ * Encodes a decoded image and its full mip chain in the given format and stores them in the texture's buffer,
+ * one buffer view per level.
+ * Block compressed formats need whole blocks of 4x4 pixels, images of other sizes are stored as PNG instead.
+ * @param srgb whether the colors are sRGB encoded, the mips are then filtered in linear space
+ */
+void StoreTextureImage(DAsset::Texture &texture, DAsset::Buffer &buffer, DAsset::TextureFormat format, bool srgb,
+                       const uint8_t *imageData, uint32_t imageChannels) {
+    uint32_t imageWidth = texture.width, imageHeight = texture.height;
+    if (imageWidth % 4 != 0 || imageHeight % 4 != 0) {
+        format = DAsset::TextureFormat::PNG;
+    }
+    texture.format = format;
+    switch (format) {
+        case DAsset::TextureFormat::BC4:
+            texture.channels = 1;
+            break;
+        case DAsset::TextureFormat::BC5:
+            texture.channels = 2;
+            break;
+        case DAsset::TextureFormat::BC7:
+            texture.channels = 4;
+            break;
+        default:
+            texture.channels = imageChannels;
+            break;
+    }
+
+    std::vector<uint8_t> bufferData;
+    texture.mipLevelBufferViews.clear();
+    // Each level is filtered from the one before, only the current level is kept decoded
+    std::vector<uint8_t> levelData;
+    const uint8_t *levelImageData = imageData;
+    uint32_t levelWidth = imageWidth, levelHeight = imageHeight;
+    uint32_t nLevels = DAssetTools::GetMipLevelCount(imageWidth, imageHeight);
+    for (uint32_t level = 0; level < nLevels; level++) {
+        if (level > 0) {
+            levelData = DAssetTools::Downsample(levelImageData, levelWidth, levelHeight, imageChannels,
+                                                DAssetTools::MipFilter::KAISER, srgb);
+            levelImageData = levelData.data();
+            levelWidth = std::max(1u, levelWidth / 2);
+            levelHeight = std::max(1u, levelHeight / 2);
+        }
+        auto encodedLevel = EncodeTextureLevel(format, levelImageData, levelWidth, levelHeight, imageChannels);
+        DAsset::BufferView levelBufferView = texture.bufferView;
+        levelBufferView.byteOffset = bufferData.size();
+        levelBufferView.byteLength = encodedLevel.size();
+        bufferData.insert(bufferData.end(), encodedLevel.begin(), encodedLevel.end());
+        if (level == 0) {
+            texture.bufferView = levelBufferView;
+        } else {
+            texture.mipLevelBufferViews.push_back(levelBufferView);
+        }
+    }
+    buffer.data = std::move(bufferData);
+}
+
+void RunTextureJob(const tinygltf::Model &model, TextureJob &job) {
+    auto &texture = job.texture;
+    if (job.kind == TextureJobKind::TEXTURE) {
+        // TODO: Support other formats than jpeg
+        stbi_uc *imageData = ReadTextureImageData(model, job.textureIndex, texture->width, texture->height,
+                                                  texture->channels, STBI_rgb);
+        if (imageData == nullptr) {
+            RAISE_EXCEPTION(errorhandling::IllegalStateException, "Failed to load texture data");
+        }
+
+        StoreTextureImage(*texture, *job.buffer, job.format, job.srgb, imageData, texture->channels);
+        delete[] imageData;
+        return;
+    }
+
+    stbi_uc *metallicRoughnessImageData = nullptr;
+
+    // Metallic roughness texture
+    int32_t metallicRoughnessWidth{}, metallicRoughnessHeight{}, metallicRoughnessChannels{};
+    if (job.metallicRoughnessTextureIndex != -1) {
+        metallicRoughnessImageData = ReadTextureImageData(model, job.metallicRoughnessTextureIndex,
+                                                          metallicRoughnessWidth, metallicRoughnessHeight,
+                                                          metallicRoughnessChannels, 3);
+        if (metallicRoughnessImageData == nullptr) {
+            RAISE_EXCEPTION(errorhandling::IllegalStateException, "Failed to load roughness-metallic texture data");
+        }
+    }
+
+    stbi_uc *occlusionImageData = nullptr;
+
+    // Occlusion texture
+    int32_t occlusionWidth{}, occlusionHeight{}, occlusionChannels{};
+    if (job.occlusionTextureIndex != -1) {
+        occlusionImageData = ReadTextureImageData(model, job.occlusionTextureIndex, occlusionWidth,
+                                                  occlusionHeight, occlusionChannels, 1);
+        if (occlusionImageData == nullptr) {
+            delete[] metallicRoughnessImageData;
+            RAISE_EXCEPTION(errorhandling::IllegalStateException, "Failed to load occlusion texture data");
+        }
+    }
+    if (metallicRoughnessImageData != nullptr && occlusionImageData != nullptr) {
+        if (occlusionWidth != metallicRoughnessWidth || occlusionHeight != metallicRoughnessHeight) {
+            delete[] metallicRoughnessImageData;
+            delete[] occlusionImageData;
+            RAISE_EXCEPTION(errorhandling::IllegalStateException,
+                            "Occlusion texture dimensions do not match roughness-metallic texture dimensions");
+        }
+    }
+
+    uint64_t rmaImageWidth{};
+    uint64_t rmaImageHeight{};
+
+    if (metallicRoughnessImageData != nullptr) {
+        rmaImageWidth = metallicRoughnessWidth;
+        rmaImageHeight = metallicRoughnessHeight;
+    } else {
+        rmaImageWidth = occlusionWidth;
+        rmaImageHeight = occlusionHeight;
+    }
+
+    uint64_t rmaImageChannels = 3;
+    uint64_t rmaImageDataLength = rmaImageWidth * rmaImageHeight * rmaImageChannels * sizeof(uint8_t);
+    // (R = roughness, G = Metalness, B = Ambient Occlusion)
+    uint8_t *rmaImageData = new stbi_uc[rmaImageDataLength];
+    DAssetTools::PackRMA(metallicRoughnessImageData, occlusionImageData, rmaImageData,
+                         rmaImageWidth * rmaImageHeight);
+    delete[] metallicRoughnessImageData;
+    delete[] occlusionImageData;
+
+    texture->width = rmaImageWidth;
+    texture->height = rmaImageHeight;
+    StoreTextureImage(*texture, *job.buffer, job.format, job.srgb, rmaImageData, rmaImageChannels);
+    delete[] rmaImageData;
+}
+
+/**
+ * Runs the texture jobs on all cores.
+ * Image decoding and PNG encoding dominate the conversion time of textured assets and are independent per texture.
+ */
+void RunTextureJobs(const tinygltf::Model &model, std::vector<TextureJob> &jobs) {
+    ParallelJobs::Run(jobs.size(), [&](size_t i) {
+        RunTextureJob(model, jobs[i]);
+    });
+}
+
 std::optional<std::shared_ptr<DAsset::Texture>>
 GetOrMakeTexture(DAsset::Asset &asset, const tinygltf::Model &model, uint64_t textureIndex,
-                 ConverterState &converterState) {
+                 DAsset::TextureFormat format, bool srgb, ConverterState &converterState) {
     auto &textureCollection = asset.textureCollection;
     auto &bufferCollection = asset.bufferCollection;
     if (textureIndex == -1) {
@@ -310,8 +520,6 @@ GetOrMakeTexture(DAsset::Asset &asset, const tinygltf::Model &model, uint64_t te
         auto texture = textureCollection.newTexture();
         converterState.setTextureId(textureIndex, texture->textureId);
 
-        // TODO: Support other formats than jpeg
-
         auto &gltfTexture = model.textures[textureIndex];
         auto sampler = model.samplers[gltfTexture.sampler];
 
@@ -322,36 +530,30 @@ GetOrMakeTexture(DAsset::Asset &asset, const tinygltf::Model &model, uint64_t te
         texture->minFilter = GetTextureFilter(sampler.minFilter);
         texture->magFilter = GetTextureFilter(sampler.magFilter);
         texture->mipMapFilter = GetMipmapFilter(sampler.magFilter);
-
-        stbi_uc *imageData = ReadTextureImageData(model, textureIndex, texture->width, texture->height,
-                                                  texture->channels, STBI_rgb);
         texture->bitDepth = 8;
-        if (imageData == nullptr) {
-            RAISE_EXCEPTION(errorhandling::IllegalStateException, "Failed to load texture data");
-        }
-
-        uint32_t imageWidth = texture->width, imageHeight = texture->height, imageChannels = texture->channels;
-        uint64_t imageDataLength = imageWidth * imageWidth * imageChannels;
 
-        size_t compressedImageDataLength{};
-        auto compressedImageData = ImageEncode(
-                imageData, imageWidth, imageHeight,
-                imageChannels,
-                compressedImageDataLength
-        );
-        delete[] imageData;
-
-        auto buffer = bufferCollection.newBuffer(compressedImageData, compressedImageDataLength);
-        delete[] compressedImageData;
+        // Size and data are filled in by the texture job
+        auto buffer = bufferCollection.newBuffer(nullptr, 0);
 
         texture->bufferView = {
                 .byteOffset = 0,
-                .byteLength = compressedImageDataLength,
+                .byteLength = 0,
                 .byteStride = 0,
                 .dataType = DAsset::DataType::UNSIGNED_BYTE,
                 .componentType = DAsset::ComponentType::VEC4,
                 .buffer = buffer,
         };
+        // A glTF texture used in several roles is stored once, in the format of the role it is first used in
+        converterState.textureJobs.push_back({
+                .kind = TextureJobKind::TEXTURE,
+                .format = format,
+                .srgb = srgb,
+                .textureIndex = static_cast<int32_t>(textureIndex),
+                .metallicRoughnessTextureIndex = -1,
+                .occlusionTextureIndex = -1,
+                .texture = texture,
+                .buffer = buffer
+        });
         return texture;
     }
     auto textureId = textureIdOpt.value();
@@ -374,101 +576,12 @@ GetOrMakeRMATexture(DAsset::Asset &asset, const tinygltf::Model &model, const ti
 
     auto rmaTextureIdOpt = converterState.getRMATextureId(lookupKey);
     if (!rmaTextureIdOpt.has_value()) {
-        stbi_uc *metallicRoughnessImageData = nullptr;
-
-        // Metallic roughness texture
-        int32_t metallicRoughnessWidth{}, metallicRoughnessHeight{}, metallicRoughnessChannels{};
-        if (metallicRoughnessTextureIndex != -1) {
-            auto &gltfMetallicRoughnessTexture = model.textures[metallicRoughnessTextureIndex];
-
-            metallicRoughnessImageData = ReadTextureImageData(model, metallicRoughnessTextureIndex,
-                                                              metallicRoughnessWidth, metallicRoughnessHeight,
-                                                              metallicRoughnessChannels, 3);
-            if (metallicRoughnessImageData == nullptr) {
-                RAISE_EXCEPTION(errorhandling::IllegalStateException, "Failed to load roughness-metallic texture data");
-            }
-
-            uint64_t metallicRoughnessImageDataLength =
-                    metallicRoughnessWidth * metallicRoughnessHeight * 3 * sizeof(uint8_t);
-        }
-
-        stbi_uc *occlusionImageData = nullptr;
-
-        // Occlusion texture
-        int32_t occlusionWidth{}, occlusionHeight{}, occlusionChannels{};
-        if (occlusionTextureIndex != -1) {
-            auto &gltfOcclusionTexture = model.textures[occlusionTextureIndex];
-            occlusionImageData = ReadTextureImageData(model, occlusionTextureIndex, occlusionWidth,
-                                                      occlusionHeight, occlusionChannels, 1);
-            if (occlusionImageData == nullptr) {
-                RAISE_EXCEPTION(errorhandling::IllegalStateException, "Failed to load occlusion texture data");
-            }
-            uint64_t occlusionImageDataLength = occlusionWidth * occlusionHeight * 1 * sizeof(uint8_t);
-        }
-        if (metallicRoughnessImageData != nullptr && occlusionImageData != nullptr) {
-            if (occlusionWidth != metallicRoughnessWidth || occlusionHeight != metallicRoughnessHeight) {
-                RAISE_EXCEPTION(errorhandling::IllegalStateException,
-                                "Occlusion texture dimensions do not match roughness-metallic texture dimensions");
-            }
-        } else if (metallicRoughnessImageData == nullptr && occlusionImageData == nullptr) {
+        if (metallicRoughnessTextureIndex == -1 && occlusionTextureIndex == -1) {
             return std::nullopt;
         }
 
-        uint64_t rmaImageWidth{};
-        uint64_t rmaImageHeight{};
-
-        if (metallicRoughnessImageData != nullptr) {
-            rmaImageWidth = metallicRoughnessWidth;
-            rmaImageHeight = metallicRoughnessHeight;
-        } else if (occlusionImageData != nullptr) {
-            rmaImageWidth = occlusionWidth;
-            rmaImageHeight = occlusionHeight;
-        }
-
-        uint64_t rmaImageChannels = 3;
-        uint64_t rmaImageDataLength = rmaImageWidth * rmaImageHeight * rmaImageChannels * sizeof(uint8_t);
-        // (R = roughness, G = Metalness, B = Ambient Occlusion)
-        uint8_t *rmaImageData = new stbi_uc[rmaImageDataLength];
-        memset(rmaImageData, 0, rmaImageDataLength);
-        for (uint64_t i = 0; i < rmaImageDataLength; i++) {
-            uint64_t pixel = i / rmaImageChannels;
-            uint64_t channel = i % rmaImageChannels;
-            if (channel == 0) {
-                // Roughness is in the green channel of the metallicRoughness texture.
-                if (metallicRoughnessImageData == nullptr) {
-                    rmaImageData[i] = 0;
-                } else {
-                    rmaImageData[i] = metallicRoughnessImageData[pixel * 3 + 1];
-                }
-            } else if (channel == 1) {
-                // Metalness is in the blue channel of the metallicRoughness texture.
-                if (metallicRoughnessImageData == nullptr) {
-                    rmaImageData[i] = 0;
-                } else {
-                    rmaImageData[i] = metallicRoughnessImageData[pixel * 3 + 2];
-                }
-            } else if (channel == 2) {
-                // Ambient Occlusion is in the red channel of the occlusion texture.
-                if (occlusionImageData == nullptr) {
-                    rmaImageData[i] = 0;
-                } else {
-                    rmaImageData[i] = occlusionImageData[pixel];
-                }
-            }
-        }
-        size_t rmaCompressedImageDataLength{};
-        auto rmaCompressedImageData = ImageEncode(
-                rmaImageData, rmaImageWidth, rmaImageHeight,
-                rmaImageChannels,
-                rmaCompressedImageDataLength
-        );
-        delete[] rmaImageData;
-
         auto rmaTexture = textureCollection.newTexture();
         converterState.setRMATextureId(lookupKey, rmaTexture->textureId);
-        rmaTexture->width = rmaImageWidth;
-        rmaTexture->height = rmaImageHeight;
-        rmaTexture->channels = rmaImageChannels;
         rmaTexture->bitDepth = 8;
 
         rmaTexture->addressModeU = DAsset::CLAMP;
@@ -479,15 +592,24 @@ GetOrMakeRMATexture(DAsset::Asset &asset, const tinygltf::Model &model, const ti
         rmaTexture->magFilter = DAsset::LINEAR;
         rmaTexture->mipMapFilter = DAsset::LINEAR;
 
+        // Size and data are filled in by the texture job
+        auto buffer = bufferCollection.newBuffer(nullptr, 0);
         rmaTexture->bufferView = DAsset::BufferView{
                 .byteOffset = 0,
-                .byteLength = rmaCompressedImageDataLength,
+                .byteLength = 0,
                 .byteStride = 0,
-                .buffer = bufferCollection.newBuffer(rmaCompressedImageData, rmaCompressedImageDataLength)
+                .buffer = buffer
         };
-        delete[] rmaCompressedImageData;
-        delete[] metallicRoughnessImageData;
-        delete[] occlusionImageData;
+        converterState.textureJobs.push_back({
+                .kind = TextureJobKind::RMA,
+                .format = DAsset::TextureFormat::BC7,
+                .srgb = false,
+                .textureIndex = -1,
+                .metallicRoughnessTextureIndex = static_cast<int32_t>(metallicRoughnessTextureIndex),
+                .occlusionTextureIndex = static_cast<int32_t>(occlusionTextureIndex),
+                .texture = rmaTexture,
+                .buffer = buffer
+        });
         return rmaTexture;
     }
     auto rmaTextureId = rmaTextureIdOpt.value();
@@ -528,14 +650,16 @@ GetOrMakeMaterial(DAsset::Asset &asset, const tinygltf::Model &model, uint64_t m
 
         // Albedo texture
         {
-            auto albedoTextureOpt = GetOrMakeTexture(asset, model, gltfPbr.baseColorTexture.index, converterState);
+            auto albedoTextureOpt = GetOrMakeTexture(asset, model, gltfPbr.baseColorTexture.index,
+                                                     DAsset::TextureFormat::BC7, true, converterState);
             if (albedoTextureOpt.has_value()) {
                 material->albedoTexture = albedoTextureOpt.value();
             }
         }
         // Normal texture
         {
-            auto normalTextureOpt = GetOrMakeTexture(asset, model, gltfMaterial.normalTexture.index, converterState);
+            auto normalTextureOpt = GetOrMakeTexture(asset, model, gltfMaterial.normalTexture.index,
+                                                     DAsset::TextureFormat::BC5, false, converterState);
             if (normalTextureOpt.has_value()) {
                 material->normalTexture = normalTextureOpt.value();
             }
@@ -561,26 +685,42 @@ GetOrMakeMaterial(DAsset::Asset &asset, const tinygltf::Model &model, uint64_t m
 
 DAsset::BufferView
 MakeBufferView(DAsset::BufferCollection &bufferCollection, const tinygltf::Model &model, uint64_t accessorIndex,
-               ConverterState &converterState) {
-    auto accessor = model.accessors[accessorIndex];
-    auto bufferView = model.bufferViews[accessor.bufferView];
+               ConverterState &converterState, bool indices = false) {
+    // Primitives sharing an accessor share its buffer view
+    auto existingBufferView = converterState.getAccessorBufferView(accessorIndex);
+    if (existingBufferView.has_value()) {
+        return existingBufferView.value();
+    }
+    auto &accessor = model.accessors[accessorIndex];
+    if (accessor.bufferView < 0) {
+        RAISE_EXCEPTION(errorhandling::IllegalArgumentException,
+                        "Accessor " + std::to_string(accessorIndex) + " has no buffer view");
+    }
+    auto &bufferView = model.bufferViews[accessor.bufferView];
+    auto &bufferData = model.buffers[bufferView.buffer].data;
 
-    auto dataType = GetDataType(accessor.componentType);
+    auto dataType = DAssetTools::GetGltfDataType(accessor.componentType);
     auto componentType = GetComponentType(accessor.type);
     auto elementSize = DAsset::GetSize(dataType, componentType);
-
-    auto dAssetBuffer = bufferCollection.newBuffer(
-            &model.buffers[bufferView.buffer].data[bufferView.byteOffset + accessor.byteOffset],
-            bufferView.byteLength
-    );
-
-    return {0,
-            accessor.count * elementSize,
-            bufferView.byteStride, // TODO: un-stride array to avoid storing unreferenced data
-            dataType,
-            componentType,
-            dAssetBuffer
-    };
+    auto byteStride = bufferView.byteStride != 0 ? bufferView.byteStride : elementSize;
+    auto elementsOffset = bufferView.byteOffset + accessor.byteOffset;
+    if (accessor.count > 0 && elementsOffset + (accessor.count - 1) * byteStride + elementSize > bufferData.size()) {
+        RAISE_EXCEPTION(errorhandling::IllegalArgumentException,
+                        "Accessor " + std::to_string(accessorIndex) + " exceeds its buffer");
+    }
+
+    // Interleaved attributes are split into one tightly packed array per accessor,
+    // the engine binds one vertex buffer per attribute
+    auto &bufferPacker = converterState.bufferPacker;
+    auto dAssetBufferView = indices && componentType == DAsset::ComponentType::SCALAR
+                            ? bufferPacker.packIndices(bufferCollection, bufferView.buffer,
+                                                       bufferData.data() + elementsOffset, accessor.count,
+                                                       byteStride, dataType)
+                            : bufferPacker.pack(bufferCollection, bufferView.buffer,
+                                                bufferData.data() + elementsOffset, accessor.count,
+                                                byteStride, dataType, componentType);
+    converterState.setAccessorBufferView(accessorIndex, dAssetBufferView);
+    return dAssetBufferView;
 }
 
 DAsset::Mesh
@@ -592,12 +732,10 @@ FromGLTFMesh(DAsset::Asset &asset, const tinygltf::Model &model, const tinygltf:
     for (const auto &primitive: mesh.primitives) {
         DAsset::BufferView indexBufferView;
 
-        // TODO: Reference already existing buffer in buffer views when possible
-
         // Create index buffer + view
         if (primitive.indices != -1) {
             auto accessorIndex = primitive.indices;
-            indexBufferView = MakeBufferView(bufferCollection, model, accessorIndex, converterState);
+            indexBufferView = MakeBufferView(bufferCollection, model, accessorIndex, converterState, true);
             if (indexBufferView.componentType != DAsset::ComponentType::SCALAR) {
                 RAISE_EXCEPTION(errorhandling::IllegalArgumentException,
                                 "Index buffer component type must be scalar");
@@ -723,6 +861,9 @@ DAsset::Asset FromTinyGLTF(const tinygltf::Model &model) {
         // Adds to bufferCollection, textureCollection and materialCollection
         rootNode.children.push_back(FromGLTFNode(asset, model, gltfNode, converterState));
     }
+    converterState.bufferPacker.finish();
+    // Textures are only decoded and encoded here, all at once, with their ids already assigned in scene order
+    RunTextureJobs(model, converterState.textureJobs);
     asset.rootNode = rootNode;
     return asset;
 }
@@ -10,7 +10,8 @@ int main(int argc, char **argv) {
         return 1;
     }
 
-    DAsset::Asset asset = DAsset::ReadAsset(Stream::FileDataReadStream::Open(argv[1]));
+    // Buffer payloads are never loaded, only their sizes are printed
+    DAsset::Asset asset = DAsset::ReadAssetLazily(Stream::FileDataReadStream::Open(argv[1]));
     Print(asset);
     return 0;
 }
@@ -48,11 +49,11 @@ void PrintNode(int depth, const DAsset::Node &node) {
             Indent(depth + 4);
             std::cout << "ComponentType: " << DAsset::GetComponentTypeName(bufferView.componentType) << std::endl;
             Indent(depth + 4);
-            std::cout << "ByteOffset: " << bufferView.offset << std::endl;
+            std::cout << "ByteOffset: " << bufferView.byteOffset << std::endl;
             Indent(depth + 4);
-            std::cout << "ByteLength: " << bufferView.length << std::endl;
+            std::cout << "ByteLength: " << bufferView.byteLength << std::endl;
             Indent(depth + 4);
-            std::cout << "ByteStride: " << bufferView.stride << std::endl;
+            std::cout << "ByteStride: " << bufferView.byteStride << std::endl;
         }
     }
 
@@ -66,5 +67,10 @@ void PrintNode(int depth, const DAsset::Node &node) {
 }
 
 void Print(const DAsset::Asset &asset) {
+    std::cout << "Buffers:" << std::endl;
+    for (const auto &buffer: asset.bufferCollection.buffers) {
+        Indent(1);
+        std::cout << "Buffer " << buffer->bufferId << ": " << buffer->getSize() << " bytes" << std::endl;
+    }
     PrintNode(0, asset.rootNode);
 }
@@ -0,0 +1,276 @@
+#include <DAssetTools/MipChain.hpp>
+#include <ErrorHandling/IllegalArgumentException.hpp>
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MIP_CHAIN_SSE2
+#include <emmintrin.h>
+#endif
+
+using namespace DAssetTools;
+
+// Taps of the Kaiser filter, centered between the two source pixels of a destination pixel
+#define KAISER_TAPS 8
+// Shape of the Kaiser window, higher is smoother but blurrier
+#define KAISER_BETA 4.0
+
+static const double PI = 3.14159265358979323846;
+
+// Resolution of the linear to sRGB table, finer than 8 bits so dark colors survive the round trip
+#define LINEAR_TO_SRGB_STEPS 65536
+
+#ifdef MIP_CHAIN_SSE2
+
+// A pixel of 4 float channels, wrapped so vectors of pixels keep the alignment of __m128
+struct Pixel {
+    __m128 values;
+};
+
+static inline Pixel MakePixel(const float values[4]) {
+    return {_mm_loadu_ps(values)};
+}
+
+static inline Pixel ZeroPixel() {
+    return {_mm_setzero_ps()};
+}
+
+static inline Pixel MultiplyAdd(Pixel sum, Pixel pixel, float weight) {
+    return {_mm_add_ps(sum.values, _mm_mul_ps(pixel.values, _mm_set1_ps(weight)))};
+}
+
+// Clamps the channels to 0 to scale and rounds them to integers, the filter's negative lobes can overshoot
+static inline void Quantize(Pixel pixel, Pixel scale, int32_t values[4]) {
+    __m128 scaled = _mm_mul_ps(pixel.values, scale.values);
+    scaled = _mm_min_ps(_mm_max_ps(scaled, _mm_setzero_ps()), scale.values);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(values), _mm_cvttps_epi32(_mm_add_ps(scaled, _mm_set1_ps(0.5f))));
+}
+
+#else
+
+// A pixel of 4 float channels
+struct Pixel {
+    float values[4];
+};
+
+static inline Pixel MakePixel(const float values[4]) {
+    return {{values[0], values[1], values[2], values[3]}};
+}
+
+static inline Pixel ZeroPixel() {
+    return {{0, 0, 0, 0}};
+}
+
+static inline Pixel MultiplyAdd(Pixel sum, Pixel pixel, float weight) {
+    for (int channel = 0; channel < 4; channel++) {
+        sum.values[channel] += pixel.values[channel] * weight;
+    }
+    return sum;
+}
+
+// Clamps the channels to 0 to scale and rounds them to integers, the filter's negative lobes can overshoot
+static inline void Quantize(Pixel pixel, Pixel scale, int32_t values[4]) {
+    for (int channel = 0; channel < 4; channel++) {
+        float scaled = std::clamp(pixel.values[channel] * scale.values[channel], 0.0f, scale.values[channel]);
+        values[channel] = static_cast<int32_t>(scaled + 0.5f);
+    }
+}
+
+#endif
+
+/**
+ * Weights of a filter halving an image.
+ * Destination pixel x is the weighted sum of the source pixels 2 * x + firstOffset + i.
+ */
+struct DownsampleFilter {
+    int firstOffset;
+    std::vector<float> weights;
+};
+
+static double BesselI0(double x) {
+    double sum = 1, term = 1;
+    for (int k = 1; k < 32; k++) {
+        term *= (x / (2 * k)) * (x / (2 * k));
+        sum += term;
+    }
+    return sum;
+}
+
+static DownsampleFilter MakeBoxFilter() {
+    return {0, {0.5f, 0.5f}};
+}
+
+static DownsampleFilter MakeKaiserFilter() {
+    DownsampleFilter filter{-(KAISER_TAPS / 2 - 1), std::vector<float>(KAISER_TAPS)};
+    double radius = KAISER_TAPS / 2.0;
+    double sum = 0;
+    std::vector<double> weights(KAISER_TAPS);
+    for (int i = 0; i < KAISER_TAPS; i++) {
+        // Distance in source pixels from the center of the destination pixel, 2 * x + 0.5
+        double distance = filter.firstOffset + i - 0.5;
+        // Halving the image halves the cutoff frequency of the sinc
+        double sincArgument = PI * distance / 2;
+        double sinc = std::sin(sincArgument) / sincArgument;
+        double windowPosition = distance / radius;
+        double window = BesselI0(KAISER_BETA * std::sqrt(1 - windowPosition * windowPosition)) / BesselI0(KAISER_BETA);
+        weights[i] = sinc * window;
+        sum += weights[i];
+    }
+    for (int i = 0; i < KAISER_TAPS; i++) {
+        filter.weights[i] = static_cast<float>(weights[i] / sum);
+    }
+    return filter;
+}
+
+static const DownsampleFilter &GetFilter(MipFilter filter) {
+    static const DownsampleFilter boxFilter = MakeBoxFilter();
+    static const DownsampleFilter kaiserFilter = MakeKaiserFilter();
+    return filter == MipFilter::KAISER ? kaiserFilter : boxFilter;
+}
+
+static const float *GetSrgbToLinearTable() {
+    static const auto table = [] {
+        std::vector<float> values(256);
+        for (int i = 0; i < 256; i++) {
+            double srgb = i / 255.0;
+            values[i] = static_cast<float>(srgb <= 0.04045 ? srgb / 12.92 : std::pow((srgb + 0.055) / 1.055, 2.4));
+        }
+        return values;
+    }();
+    return table.data();
+}
+
+static const float *GetUnormToFloatTable() {
+    static const auto table = [] {
+        std::vector<float> values(256);
+        for (int i = 0; i < 256; i++) {
+            values[i] = i / 255.0f;
+        }
+        return values;
+    }();
+    return table.data();
+}
+
+static const uint8_t *GetLinearToSrgbTable() {
+    static const auto table = [] {
+        std::vector<uint8_t> values(LINEAR_TO_SRGB_STEPS);
+        for (int i = 0; i < LINEAR_TO_SRGB_STEPS; i++) {
+            double linear = i / double(LINEAR_TO_SRGB_STEPS - 1);
+            double srgb = linear <= 0.0031308 ? linear * 12.92 : 1.055 * std::pow(linear, 1 / 2.4) - 0.055;
+            values[i] = static_cast<uint8_t>(std::lround(srgb * 255));
+        }
+        return values;
+    }();
+    return table.data();
+}
+
+/**
+ * Converts a row of pixels to linear float RGBA and filters it horizontally.
+ * @param toFloat the table converting the bytes of each channel to linear floats
+ * @param linearRow scratch space for width pixels
+ */
+static void FilterRow(const uint8_t *row, uint32_t width, uint32_t channels, const float *const toFloat[4],
+                      const DownsampleFilter &filter, uint32_t outputWidth, std::vector<Pixel> &linearRow,
+                      Pixel *output) {
+    for (uint32_t x = 0; x < width; x++) {
+        float values[4] = {0, 0, 0, 0};
+        for (uint32_t channel = 0; channel < channels; channel++) {
+            values[channel] = toFloat[channel][row[x * channels + channel]];
+        }
+        linearRow[x] = MakePixel(values);
+    }
+    int lastColumn = static_cast<int>(width) - 1;
+    int nTaps = static_cast<int>(filter.weights.size());
+    for (uint32_t x = 0; x < outputWidth; x++) {
+        Pixel sum = ZeroPixel();
+        int firstColumn = static_cast<int>(x * 2) + filter.firstOffset;
+        if (firstColumn >= 0 && firstColumn + nTaps - 1 <= lastColumn) {
+            const Pixel *columns = &linearRow[firstColumn];
+            for (int tap = 0; tap < nTaps; tap++) {
+                sum = MultiplyAdd(sum, columns[tap], filter.weights[tap]);
+            }
+        } else {
+            // Near the edges
+            for (int tap = 0; tap < nTaps; tap++) {
+                int column = std::clamp(firstColumn + tap, 0, lastColumn);
+                sum = MultiplyAdd(sum, linearRow[column], filter.weights[tap]);
+            }
+        }
+        output[x] = sum;
+    }
+}
+
+uint32_t DAssetTools::GetMipLevelCount(uint32_t width, uint32_t height) {
+    uint32_t nLevels = 1;
+    while (width > 1 || height > 1) {
+        width = std::max(1u, width / 2);
+        height = std::max(1u, height / 2);
+        nLevels++;
+    }
+    return nLevels;
+}
+
+std::vector<uint8_t> DAssetTools::Downsample(const uint8_t *pixels, uint32_t width, uint32_t height,
+                                             uint32_t channels, MipFilter mipFilter, bool srgb) {
+    if (width == 0 || height == 0) {
+        RAISE_EXCEPTION(errorhandling::IllegalArgumentException, "Cannot downsample an empty image");
+    }
+    if (channels < 1 || channels > 4) {
+        RAISE_EXCEPTION(errorhandling::IllegalArgumentException,
+                        "Cannot downsample an image with " + std::to_string(channels) + " channels");
+    }
+    const DownsampleFilter &filter = GetFilter(mipFilter);
+    uint32_t colorChannels = srgb ? std::min(channels, 3u) : 0;
+    // Colors are quantized to the steps of the linear to sRGB table, the other channels to bytes
+    const float *toFloat[4];
+    float scales[4];
+    for (uint32_t channel = 0; channel < 4; channel++) {
+        bool color = channel < colorChannels;
+        toFloat[channel] = color ? GetSrgbToLinearTable() : GetUnormToFloatTable();
+        scales[channel] = color ? LINEAR_TO_SRGB_STEPS - 1 : 255;
+    }
+    Pixel scale = MakePixel(scales);
+    uint32_t outputWidth = std::max(1u, width / 2);
+    uint32_t outputHeight = std::max(1u, height / 2);
+    std::vector<uint8_t> output(static_cast<size_t>(outputWidth) * outputHeight * channels);
+
+    // The horizontally filtered source rows the current output row needs.
+    // The output rows step 2 source rows at a time through a window of as many rows as the filter has taps,
+    // so source row r stays in slot r % taps until the window has moved past it.
+    size_t nTaps = filter.weights.size();
+    std::vector<Pixel> filteredRows(nTaps * outputWidth);
+    std::vector<int> filteredRowIndices(nTaps, -1);
+    std::vector<Pixel *> tapRows(nTaps);
+    std::vector<Pixel> linearRow(width);
+    int lastRow = static_cast<int>(height) - 1;
+
+    const uint8_t *linearToSrgb = GetLinearToSrgbTable();
+    for (uint32_t y = 0; y < outputHeight; y++) {
+        int firstRow = static_cast<int>(y * 2) + filter.firstOffset;
+        uint8_t *outputRow = &output[static_cast<size_t>(y) * outputWidth * channels];
+        for (size_t tap = 0; tap < nTaps; tap++) {
+            int row = std::clamp(firstRow + static_cast<int>(tap), 0, lastRow);
+            size_t slot = static_cast<size_t>(row) % nTaps;
+            tapRows[tap] = &filteredRows[slot * outputWidth];
+            if (filteredRowIndices[slot] != row) {
+                FilterRow(pixels + static_cast<size_t>(row) * width * channels, width, channels, toFloat,
+                          filter, outputWidth, linearRow, tapRows[tap]);
+                filteredRowIndices[slot] = row;
+            }
+        }
+        for (uint32_t x = 0; x < outputWidth; x++) {
+            Pixel sum = ZeroPixel();
+            for (size_t tap = 0; tap < nTaps; tap++) {
+                sum = MultiplyAdd(sum, tapRows[tap][x], filter.weights[tap]);
+            }
+            int32_t values[4];
+            Quantize(sum, scale, values);
+            for (uint32_t channel = 0; channel < channels; channel++) {
+                outputRow[x * channels + channel] = channel < colorChannels ? linearToSrgb[values[channel]]
+                                                                            : static_cast<uint8_t>(values[channel]);
+            }
+        }
+    }
+    return output;
+}
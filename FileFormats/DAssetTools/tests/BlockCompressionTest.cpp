@@ -0,0 +1,190 @@
+#include <gtest/gtest.h>
+#include <DAssetTools/BlockCompression.hpp>
+#include <ErrorHandling/IllegalArgumentException.hpp>
+#include <cmath>
+
+// Reference decoders, written from the format specifications independently of the encoders
+
+static void DecodeBC4Block(const uint8_t *block, uint8_t values[16]) {
+    int red0 = block[0], red1 = block[1];
+    int palette[8] = {red0, red1};
+    if (red0 > red1) {
+        for (int i = 2; i < 8; i++) {
+            palette[i] = static_cast<int>(std::lround(((8 - i) * red0 + (i - 1) * red1) / 7.0));
+        }
+    } else {
+        for (int i = 2; i < 6; i++) {
+            palette[i] = static_cast<int>(std::lround(((6 - i) * red0 + (i - 1) * red1) / 5.0));
+        }
+        palette[6] = 0;
+        palette[7] = 255;
+    }
+    uint64_t indexBits = 0;
+    for (int i = 0; i < 6; i++) {
+        indexBits |= static_cast<uint64_t>(block[2 + i]) << (i * 8);
+    }
+    for (int i = 0; i < 16; i++) {
+        values[i] = static_cast<uint8_t>(palette[(indexBits >> (i * 3)) & 7]);
+    }
+}
+
+static uint32_t ReadBits(const uint8_t *block, uint32_t &position, uint32_t nBits) {
+    uint32_t value = 0;
+    for (uint32_t bit = 0; bit < nBits; bit++, position++) {
+        value |= ((block[position / 8] >> (position % 8)) & 1) << bit;
+    }
+    return value;
+}
+
+// Decodes BC7 blocks in mode 6, the only mode the encoder writes
+static void DecodeBC7Block(const uint8_t *block, uint8_t pixels[16][4]) {
+    static const int weights[16] = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+    uint32_t position = 0;
+    ASSERT_EQ(1u << 6, ReadBits(block, position, 7)) << "Not a mode 6 block";
+    int endpoints[2][4];
+    for (int channel = 0; channel < 4; channel++) {
+        endpoints[0][channel] = static_cast<int>(ReadBits(block, position, 7));
+        endpoints[1][channel] = static_cast<int>(ReadBits(block, position, 7));
+    }
+    for (auto &endpoint: endpoints) {
+        int pBit = static_cast<int>(ReadBits(block, position, 1));
+        for (int &value: endpoint) {
+            value = value << 1 | pBit;
+        }
+    }
+    for (int i = 0; i < 16; i++) {
+        int index = static_cast<int>(ReadBits(block, position, i == 0 ? 3 : 4));
+        for (int channel = 0; channel < 4; channel++) {
+            pixels[i][channel] = static_cast<uint8_t>(
+                    ((64 - weights[index]) * endpoints[0][channel] + weights[index] * endpoints[1][channel] + 32) >> 6);
+        }
+    }
+}
+
+static std::vector<uint8_t> MakeImage(uint32_t width, uint32_t height, uint32_t channels) {
+    std::vector<uint8_t> image(width * height * channels);
+    for (uint32_t y = 0; y < height; y++) {
+        for (uint32_t x = 0; x < width; x++) {
+            // Like the textures of a typical asset: detail mostly in the brightness, slowly changing colors
+            double luminance = 128 + 80 * std::sin(x * 0.11) * std::cos(y * 0.07) + 20 * std::sin((x + y) * 0.9);
+            for (uint32_t channel = 0; channel < channels; channel++) {
+                double value = luminance * (0.8 + 0.1 * channel) + 15 * std::sin(x * 0.03 + y * 0.02 + channel * 2);
+                image[(y * width + x) * channels + channel] = static_cast<uint8_t>(std::clamp(value, 0.0, 255.0));
+            }
+        }
+    }
+    return image;
+}
+
+// Peak signal to noise ratio in dB of the decoded channels
+static double Psnr(const std::vector<uint8_t> &image, const std::vector<uint8_t> &decoded, uint32_t channels,
+                   uint32_t nDecodedChannels) {
+    double squaredError = 0;
+    size_t nValues = 0;
+    for (size_t pixel = 0; pixel < image.size() / channels; pixel++) {
+        for (uint32_t channel = 0; channel < nDecodedChannels; channel++) {
+            double difference = double(image[pixel * channels + channel]) - decoded[pixel * channels + channel];
+            squaredError += difference * difference;
+            nValues++;
+        }
+    }
+    if (squaredError == 0) {
+        return INFINITY;
+    }
+    return 10 * std::log10(255.0 * 255.0 / (squaredError / nValues));
+}
+
+TEST(BlockCompression, BC4) {
+    uint32_t width = 64, height = 32, channels = 3;
+    auto image = MakeImage(width, height, channels);
+    auto blocks = DAssetTools::CompressBC4(image.data(), width, height, channels, 1);
+    ASSERT_EQ(width / 4 * height / 4 * BC4_BLOCK_SIZE, blocks.size());
+
+    std::vector<uint8_t> decoded(image.size());
+    for (uint32_t blockIndex = 0; blockIndex < blocks.size() / BC4_BLOCK_SIZE; blockIndex++) {
+        uint8_t values[16];
+        DecodeBC4Block(&blocks[blockIndex * BC4_BLOCK_SIZE], values);
+        uint32_t blockX = blockIndex % (width / 4), blockY = blockIndex / (width / 4);
+        for (uint32_t i = 0; i < 16; i++) {
+            size_t pixel = (blockY * 4 + i / 4) * width + blockX * 4 + i % 4;
+            decoded[pixel * channels + 1] = values[i];
+        }
+    }
+    for (size_t pixel = 0; pixel < width * height; pixel++) {
+        decoded[pixel * channels] = image[pixel * channels];
+    }
+    EXPECT_GT(Psnr(image, decoded, channels, 2), 40);
+}
+
+TEST(BlockCompression, BC5StoresTwoBC4Blocks) {
+    uint32_t width = 8, height = 8, channels = 2;
+    auto image = MakeImage(width, height, channels);
+    auto bc5Blocks = DAssetTools::CompressBC5(image.data(), width, height, channels);
+    auto redBlocks = DAssetTools::CompressBC4(image.data(), width, height, channels, 0);
+    auto greenBlocks = DAssetTools::CompressBC4(image.data(), width, height, channels, 1);
+    ASSERT_EQ(4 * BC5_BLOCK_SIZE, bc5Blocks.size());
+    for (size_t block = 0; block < 4; block++) {
+        EXPECT_EQ(0, memcmp(&bc5Blocks[block * BC5_BLOCK_SIZE], &redBlocks[block * BC4_BLOCK_SIZE], BC4_BLOCK_SIZE));
+        EXPECT_EQ(0, memcmp(&bc5Blocks[block * BC5_BLOCK_SIZE + BC4_BLOCK_SIZE], &greenBlocks[block * BC4_BLOCK_SIZE],
+                            BC4_BLOCK_SIZE));
+    }
+    EXPECT_THROW(DAssetTools::CompressBC5(image.data(), width, height, 1), errorhandling::IllegalArgumentException);
+}
+
+TEST(BlockCompression, BC7) {
+    for (uint32_t channels: {3, 4}) {
+        uint32_t width = 64, height = 64;
+        auto image = MakeImage(width, height, channels);
+        auto blocks = DAssetTools::CompressBC7(image.data(), width, height, channels);
+        ASSERT_EQ(width / 4 * height / 4 * BC7_BLOCK_SIZE, blocks.size());
+
+        std::vector<uint8_t> decoded(image.size());
+        for (uint32_t blockIndex = 0; blockIndex < blocks.size() / BC7_BLOCK_SIZE; blockIndex++) {
+            uint8_t pixels[16][4];
+            DecodeBC7Block(&blocks[blockIndex * BC7_BLOCK_SIZE], pixels);
+            uint32_t blockX = blockIndex % (width / 4), blockY = blockIndex / (width / 4);
+            for (uint32_t i = 0; i < 16; i++) {
+                size_t pixel = (blockY * 4 + i / 4) * width + blockX * 4 + i % 4;
+                for (uint32_t channel = 0; channel < channels; channel++) {
+                    decoded[pixel * channels + channel] = pixels[i][channel];
+                }
+                if (channels == 3) {
+                    EXPECT_EQ(255, pixels[i][3]);
+                }
+            }
+        }
+        EXPECT_GT(Psnr(image, decoded, channels, channels), 40) << channels << " channels";
+    }
+}
+
+TEST(BlockCompression, BC7SolidColorIsExact) {
+    std::vector<uint8_t> image(4 * 4 * 3);
+    for (size_t pixel = 0; pixel < 16; pixel++) {
+        image[pixel * 3] = 200;
+        image[pixel * 3 + 1] = 31;
+        image[pixel * 3 + 2] = 128;
+    }
+    auto blocks = DAssetTools::CompressBC7(image.data(), 4, 4, 3);
+    uint8_t pixels[16][4];
+    DecodeBC7Block(blocks.data(), pixels);
+    for (auto &pixel: pixels) {
+        EXPECT_NEAR(200, pixel[0], 1);
+        EXPECT_NEAR(31, pixel[1], 1);
+        EXPECT_NEAR(128, pixel[2], 1);
+    }
+}
+
+TEST(BlockCompression, PartialBlocksRepeatTheEdge) {
+    uint32_t width = 5, height = 3, channels = 4;
+    auto image = MakeImage(width, height, channels);
+    auto blocks = DAssetTools::CompressBC7(image.data(), width, height, channels);
+    ASSERT_EQ(2 * BC7_BLOCK_SIZE, blocks.size());
+    // The second block only covers the last column, it is compressed like that column repeated to 4x4 pixels
+    std::vector<uint8_t> edge(4 * 4 * channels);
+    for (uint32_t i = 0; i < 16; i++) {
+        uint32_t row = std::min(i / 4, height - 1);
+        memcpy(&edge[i * channels], &image[(row * width + 4) * channels], channels);
+    }
+    auto edgeBlocks = DAssetTools::CompressBC7(edge.data(), 4, 4, channels);
+    EXPECT_EQ(0, memcmp(&blocks[BC7_BLOCK_SIZE], edgeBlocks.data(), BC7_BLOCK_SIZE));
+}
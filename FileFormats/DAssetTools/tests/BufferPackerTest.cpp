@@ -0,0 +1,135 @@
+#include <gtest/gtest.h>
+#include <DAssetTools/BufferPacker.hpp>
+#include <ErrorHandling/IllegalArgumentException.hpp>
+#include <ErrorHandling/IllegalStateException.hpp>
+
+TEST(BufferPacker, InterleavedElementsAreUnstrided) {
+    DAsset::BufferCollection bufferCollection{};
+    DAssetTools::BufferPacker packer{};
+    // Two interleaved 2 byte attributes followed by 2 bytes no accessor references, 3 vertices
+    std::vector<uint8_t> interleaved = {
+            1, 2, 10, 20, 0xFF, 0xFF,
+            3, 4, 30, 40, 0xFF, 0xFF,
+            5, 6, 50, 60, 0xFF, 0xFF
+    };
+    auto first = packer.pack(bufferCollection, 0, interleaved.data(), 3, 6,
+                             DAsset::DataType::UNSIGNED_BYTE, DAsset::ComponentType::VEC2);
+    auto second = packer.pack(bufferCollection, 0, interleaved.data() + 2, 3, 6,
+                              DAsset::DataType::UNSIGNED_BYTE, DAsset::ComponentType::VEC2);
+
+    packer.finish();
+
+    // Both accessors are packed into the same buffer, without the unreferenced bytes
+    ASSERT_EQ(1u, bufferCollection.buffers.size());
+    EXPECT_EQ(first.buffer, second.buffer);
+    EXPECT_EQ((std::vector<uint8_t>{1, 2, 3, 4, 5, 6, 10, 20, 30, 40, 50, 60}), first.buffer->data.toVector());
+    EXPECT_EQ(0u, first.byteOffset);
+    EXPECT_EQ(6u, first.byteLength);
+    EXPECT_EQ(2u, first.byteStride);
+    EXPECT_EQ(6u, second.byteOffset);
+    EXPECT_EQ(12u, packer.getPackedBytes());
+}
+
+TEST(BufferPacker, EqualContentIsStoredOnce) {
+    DAsset::BufferCollection bufferCollection{};
+    DAssetTools::BufferPacker packer{};
+    std::vector<float> positions = {0, 1, 2, 3, 4, 5};
+    auto data = reinterpret_cast<const uint8_t *>(positions.data());
+    auto first = packer.pack(bufferCollection, 0, data, 2, 0,
+                             DAsset::DataType::FLOAT, DAsset::ComponentType::VEC3);
+    // The same content from another glTF buffer
+    auto second = packer.pack(bufferCollection, 1, data, 2, 0,
+                              DAsset::DataType::FLOAT, DAsset::ComponentType::VEC3);
+    EXPECT_EQ(first.buffer, second.buffer);
+    EXPECT_EQ(first.byteOffset, second.byteOffset);
+    EXPECT_EQ(1u, bufferCollection.buffers.size());
+    EXPECT_EQ(24u, packer.getPackedBytes());
+    EXPECT_EQ(24u, packer.getDeduplicatedBytes());
+
+    // The same bytes with another type are a different view
+    auto asIntegers = packer.pack(bufferCollection, 0, data, 6, 0,
+                                  DAsset::DataType::UNSIGNED_INT, DAsset::ComponentType::SCALAR);
+    EXPECT_EQ(DAsset::DataType::UNSIGNED_INT, asIntegers.dataType);
+    EXPECT_EQ(24u, asIntegers.byteOffset);
+    EXPECT_EQ(48u, packer.getPackedBytes());
+}
+
+TEST(BufferPacker, ElementsAreAlignedToTheirComponentSize) {
+    DAsset::BufferCollection bufferCollection{};
+    DAssetTools::BufferPacker packer{};
+    std::vector<uint8_t> bytes = {1, 2, 3};
+    std::vector<uint32_t> indices = {7, 8};
+    packer.pack(bufferCollection, 0, bytes.data(), 3, 0,
+                DAsset::DataType::UNSIGNED_BYTE, DAsset::ComponentType::SCALAR);
+    auto indexView = packer.pack(bufferCollection, 0, reinterpret_cast<const uint8_t *>(indices.data()), 2, 0,
+                                 DAsset::DataType::UNSIGNED_INT, DAsset::ComponentType::SCALAR);
+    EXPECT_EQ(4u, indexView.byteOffset);
+
+    EXPECT_THROW(packer.pack(bufferCollection, 0, bytes.data(), 1, 2,
+                             DAsset::DataType::UNSIGNED_INT, DAsset::ComponentType::SCALAR),
+                 errorhandling::IllegalArgumentException);
+    packer.finish();
+    EXPECT_EQ(12u, indexView.buffer->data.size());
+}
+
+TEST(BufferPacker, GltfComponentTypesKeepTheirSize) {
+    // UNSIGNED_BYTE, UNSIGNED_SHORT and UNSIGNED_INT
+    EXPECT_EQ(DAsset::DataType::UNSIGNED_BYTE, DAssetTools::GetGltfDataType(5121));
+    EXPECT_EQ(DAsset::DataType::UNSIGNED_SHORT, DAssetTools::GetGltfDataType(5123));
+    EXPECT_EQ(DAsset::DataType::UNSIGNED_INT, DAssetTools::GetGltfDataType(5125));
+    for (int gltfComponentType: {5120, 5121, 5122, 5123, 5124, 5125, 5126}) {
+        EXPECT_EQ(gltfComponentType <= 5121 ? 1u : gltfComponentType <= 5123 ? 2u : 4u,
+                  DAsset::GetSize(DAssetTools::GetGltfDataType(gltfComponentType), DAsset::ComponentType::SCALAR));
+    }
+}
+
+TEST(BufferPacker, IndicesAreWidenedTo16Bits) {
+    DAsset::BufferCollection bufferCollection{};
+    DAssetTools::BufferPacker packer{};
+    // Every other byte is an index
+    std::vector<uint8_t> byteIndices = {1, 0xFF, 200, 0xFF, 3, 0xFF};
+    auto shortView = packer.packIndices(bufferCollection, 0, byteIndices.data(), 3, 2,
+                                        DAsset::DataType::UNSIGNED_BYTE);
+    EXPECT_EQ(DAsset::DataType::UNSIGNED_SHORT, shortView.dataType);
+    EXPECT_EQ(6u, shortView.byteLength);
+    EXPECT_EQ(2u, shortView.byteStride);
+
+    // More than 65535 vertices need 32-bit indices, which are kept as they are
+    std::vector<uint8_t> intIndices = {0x00, 0x00, 0x01, 0x00, 0xFF, 0xFF, 0x01, 0x00};
+    auto intView = packer.packIndices(bufferCollection, 0, intIndices.data(), 2, 0,
+                                      DAsset::DataType::UNSIGNED_INT);
+    EXPECT_EQ(DAsset::DataType::UNSIGNED_INT, intView.dataType);
+    EXPECT_EQ(8u, intView.byteLength);
+    EXPECT_THROW(packer.packIndices(bufferCollection, 0, intIndices.data(), 2, 0, DAsset::DataType::FLOAT),
+                 errorhandling::IllegalArgumentException);
+
+    packer.finish();
+    EXPECT_EQ((std::vector<uint8_t>{1, 0, 200, 0, 3, 0, 0, 0, 0x00, 0x00, 0x01, 0x00, 0xFF, 0xFF, 0x01, 0x00}),
+              shortView.buffer->data.toVector());
+}
+
+TEST(BufferPacker, BuffersGetTheirBytesWhenFinished) {
+    DAsset::BufferCollection bufferCollection{};
+    DAssetTools::BufferPacker packer{};
+    std::vector<uint8_t> bytes(1000);
+    for (size_t i = 0; i < bytes.size(); i++) {
+        bytes[i] = static_cast<uint8_t>(i);
+    }
+    // Enough views to grow the bytes several times
+    std::vector<DAsset::BufferView> bufferViews;
+    for (uint64_t count = 1; count < 100; count++) {
+        bufferViews.push_back(packer.pack(bufferCollection, 0, bytes.data() + count, count, 0,
+                                          DAsset::DataType::UNSIGNED_BYTE, DAsset::ComponentType::SCALAR));
+        EXPECT_EQ(0u, bufferViews.back().buffer->data.size());
+    }
+    packer.finish();
+
+    for (const auto &bufferView: bufferViews) {
+        auto data = bufferView.buffer->data.data() + bufferView.byteOffset;
+        EXPECT_EQ(std::vector<uint8_t>(bytes.data() + bufferView.byteLength, bytes.data() + 2 * bufferView.byteLength),
+                  std::vector<uint8_t>(data, data + bufferView.byteLength));
+    }
+    EXPECT_THROW(packer.pack(bufferCollection, 0, bytes.data(), 1, 0,
+                             DAsset::DataType::UNSIGNED_BYTE, DAsset::ComponentType::SCALAR),
+                 errorhandling::IllegalStateException);
+}
@@ -0,0 +1,79 @@
+#include <gtest/gtest.h>
+#include <DAssetTools/ChannelPack.hpp>
+#include <ErrorHandling/IllegalArgumentException.hpp>
+#include <random>
+#include <vector>
+
+static std::vector<uint8_t> RandomBytes(size_t n, std::mt19937 &random) {
+    std::vector<uint8_t> bytes(n);
+    for (auto &byte: bytes) {
+        byte = static_cast<uint8_t>(random());
+    }
+    return bytes;
+}
+
+// Packs with the given kernel into an output with guard bytes behind it, which must stay untouched
+static std::vector<uint8_t> Pack(const uint8_t *metallicRoughness, const uint8_t *occlusion, size_t nPixels,
+                                 DAssetTools::SimdLevel simdLevel) {
+    std::vector<uint8_t> rma(nPixels * 3 + 64, 0xCD);
+    DAssetTools::PackRMA(metallicRoughness, occlusion, rma.data(), nPixels, simdLevel);
+    for (size_t i = nPixels * 3; i < rma.size(); i++) {
+        EXPECT_EQ(0xCD, rma[i]) << "Byte " << i - nPixels * 3 << " behind the output was overwritten";
+    }
+    rma.resize(nPixels * 3);
+    return rma;
+}
+
+TEST(ChannelPack, ScalarPacksRoughnessMetalnessAndOcclusion) {
+    std::vector<uint8_t> metallicRoughness = {1, 2, 3, 4, 5, 6};
+    std::vector<uint8_t> occlusion = {7, 8};
+    auto scalar = DAssetTools::SimdLevel::SCALAR;
+    EXPECT_EQ((std::vector<uint8_t>{2, 3, 7, 5, 6, 8}), Pack(metallicRoughness.data(), occlusion.data(), 2, scalar));
+    EXPECT_EQ((std::vector<uint8_t>{2, 3, 0, 5, 6, 0}), Pack(metallicRoughness.data(), nullptr, 2, scalar));
+    EXPECT_EQ((std::vector<uint8_t>{0, 0, 7, 0, 0, 8}), Pack(nullptr, occlusion.data(), 2, scalar));
+    EXPECT_EQ((std::vector<uint8_t>(6, 0)), Pack(nullptr, nullptr, 2, scalar));
+}
+
+TEST(ChannelPack, SimdKernelsMatchScalar) {
+    std::mt19937 random(42);
+    std::vector<DAssetTools::SimdLevel> simdLevels{};
+    for (auto simdLevel: {DAssetTools::SimdLevel::SSSE3, DAssetTools::SimdLevel::AVX2}) {
+        if (static_cast<int>(simdLevel) <= static_cast<int>(DAssetTools::GetSimdLevel())) {
+            simdLevels.push_back(simdLevel);
+        }
+    }
+    if (simdLevels.empty()) {
+        GTEST_SKIP() << "The CPU supports no SIMD kernel";
+    }
+    // Lengths around the block sizes of 16 and 32 pixels, so the tails behind the SIMD loops are covered
+    std::vector<size_t> pixelCounts{};
+    for (size_t nPixels = 0; nPixels <= 100; nPixels++) {
+        pixelCounts.push_back(nPixels);
+    }
+    pixelCounts.insert(pixelCounts.end(), {1023, 1024, 1025, 4099});
+
+    for (auto nPixels: pixelCounts) {
+        // Sized exactly, so reads past the images show up in sanitized builds
+        auto metallicRoughness = RandomBytes(nPixels * 3, random);
+        auto occlusion = RandomBytes(nPixels, random);
+        for (int sources = 0; sources < 3; sources++) {
+            const uint8_t *metallicRoughnessData = sources == 2 ? nullptr : metallicRoughness.data();
+            const uint8_t *occlusionData = sources == 1 ? nullptr : occlusion.data();
+            auto expected = Pack(metallicRoughnessData, occlusionData, nPixels, DAssetTools::SimdLevel::SCALAR);
+            for (auto simdLevel: simdLevels) {
+                EXPECT_EQ(expected, Pack(metallicRoughnessData, occlusionData, nPixels, simdLevel))
+                                    << nPixels << " pixels, sources " << sources << ", SIMD level "
+                                    << static_cast<int>(simdLevel);
+            }
+        }
+    }
+}
+
+TEST(ChannelPack, UnsupportedKernelsAreRejected) {
+    if (DAssetTools::GetSimdLevel() == DAssetTools::SimdLevel::AVX2) {
+        GTEST_SKIP() << "The CPU supports all kernels";
+    }
+    uint8_t rma[3];
+    EXPECT_THROW(DAssetTools::PackRMA(nullptr, nullptr, rma, 1, DAssetTools::SimdLevel::AVX2),
+                 errorhandling::IllegalArgumentException);
+}
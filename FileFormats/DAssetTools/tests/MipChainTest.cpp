@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+#include <DAssetTools/MipChain.hpp>
+#include <ErrorHandling/IllegalArgumentException.hpp>
+#include <cmath>
+
+TEST(MipChain, MipLevelCount) {
+    EXPECT_EQ(1u, DAssetTools::GetMipLevelCount(1, 1));
+    EXPECT_EQ(2u, DAssetTools::GetMipLevelCount(2, 2));
+    EXPECT_EQ(11u, DAssetTools::GetMipLevelCount(1024, 1024));
+    EXPECT_EQ(11u, DAssetTools::GetMipLevelCount(1024, 4));
+    EXPECT_EQ(3u, DAssetTools::GetMipLevelCount(5, 7));
+}
+
+TEST(MipChain, BoxAveragesLinearChannels) {
+    // 4x2 pixels with 2 channels
+    std::vector<uint8_t> image = {
+            0, 10, 100, 20, 200, 30, 255, 40,
+            50, 50, 22, 60, 210, 70, 255, 80
+    };
+    auto level = DAssetTools::Downsample(image.data(), 4, 2, 2, DAssetTools::MipFilter::BOX, false);
+    ASSERT_EQ(2u * 1 * 2, level.size());
+    EXPECT_EQ(43, level[0]);
+    EXPECT_EQ(35, level[1]);
+    EXPECT_EQ(230, level[2]);
+    EXPECT_EQ(55, level[3]);
+}
+
+TEST(MipChain, SrgbColorsAreAveragedInLinearSpace) {
+    // Black and white pixels with an alpha of 0 and 255
+    std::vector<uint8_t> image = {
+            0, 0, 0, 0, 255, 255, 255, 255,
+            0, 0, 0, 0, 255, 255, 255, 255
+    };
+    auto level = DAssetTools::Downsample(image.data(), 2, 2, 4, DAssetTools::MipFilter::BOX, true);
+    ASSERT_EQ(4u, level.size());
+    // Half the light of white is not the sRGB value halfway between black and white
+    EXPECT_EQ(188, level[0]);
+    EXPECT_EQ(188, level[1]);
+    EXPECT_EQ(188, level[2]);
+    // Alpha is linear
+    EXPECT_EQ(128, level[3]);
+
+    level = DAssetTools::Downsample(image.data(), 2, 2, 4, DAssetTools::MipFilter::BOX, false);
+    EXPECT_EQ(128, level[0]);
+}
+
+TEST(MipChain, SolidImagesStaySolid) {
+    uint32_t width = 37, height = 20, channels = 3;
+    std::vector<uint8_t> image(width * height * channels);
+    for (size_t pixel = 0; pixel < width * height; pixel++) {
+        image[pixel * channels] = 17;
+        image[pixel * channels + 1] = 128;
+        image[pixel * channels + 2] = 240;
+    }
+    for (auto filter: {DAssetTools::MipFilter::BOX, DAssetTools::MipFilter::KAISER}) {
+        for (bool srgb: {false, true}) {
+            auto level = DAssetTools::Downsample(image.data(), width, height, channels, filter, srgb);
+            ASSERT_EQ(18u * 10 * channels, level.size());
+            for (size_t pixel = 0; pixel < 18 * 10; pixel++) {
+                EXPECT_EQ(17, level[pixel * channels]);
+                EXPECT_EQ(128, level[pixel * channels + 1]);
+                EXPECT_EQ(240, level[pixel * channels + 2]);
+            }
+        }
+    }
+}
+
+TEST(MipChain, KaiserRemovesDetailTheBoxFilterAliases) {
+    // Stripes 3 pixels wide are finer than the next level can show, so they should fade to their average
+    uint32_t width = 96, height = 4;
+    std::vector<uint8_t> image(width * height);
+    for (uint32_t y = 0; y < height; y++) {
+        for (uint32_t x = 0; x < width; x++) {
+            image[y * width + x] = x % 3 == 0 ? 255 : 0;
+        }
+    }
+    auto deviation = [&](DAssetTools::MipFilter filter) {
+        auto level = DAssetTools::Downsample(image.data(), width, height, 1, filter, false);
+        double squaredError = 0;
+        // Only the middle row, away from the clamped edges
+        for (uint32_t x = 8; x < width / 2 - 8; x++) {
+            double difference = level[width / 2 + x] - 85.0;
+            squaredError += difference * difference;
+        }
+        return std::sqrt(squaredError / (width / 2 - 16));
+    };
+    double boxDeviation = deviation(DAssetTools::MipFilter::BOX);
+    double kaiserDeviation = deviation(DAssetTools::MipFilter::KAISER);
+    EXPECT_GT(boxDeviation, 50);
+    EXPECT_LT(kaiserDeviation, boxDeviation / 2);
+}
+
+TEST(MipChain, ChainEndsAtOnePixel) {
+    uint32_t width = 8, height = 2;
+    std::vector<uint8_t> level(width * height * 4, 99);
+    uint32_t nLevels = DAssetTools::GetMipLevelCount(width, height);
+    for (uint32_t i = 1; i < nLevels; i++) {
+        level = DAssetTools::Downsample(level.data(), width, height, 4, DAssetTools::MipFilter::KAISER, true);
+        width = std::max(1u, width / 2);
+        height = std::max(1u, height / 2);
+        ASSERT_EQ(width * height * 4, level.size());
+    }
+    EXPECT_EQ(1u, width);
+    EXPECT_EQ(1u, height);
+    EXPECT_EQ(99, level[0]);
+    EXPECT_THROW(DAssetTools::Downsample(level.data(), 0, 1, 4, DAssetTools::MipFilter::BOX, false),
+                 errorhandling::IllegalArgumentException);
+}
@@ -35,8 +35,16 @@ namespace DShader {
         std::optional<ShaderVariant> find(ShaderType type, ShaderApi api) const;
     };
 
+    /**
+     * Loads a shader package of any format version, including big-endian files written before the format had a header
+     */
     DShader LoadDShader(const std::unique_ptr<Stream::DataReadStream> &stream);
 
-    void WriteDShader(const std::unique_ptr<Stream::DataWriteStream> &stream, const DShader &shader);
+    /**
+     * Writes the shader package in the current format version
+     * @param byteOrder the byte order of the values in the file, little-endian by default
+     */
+    void WriteDShader(const std::unique_ptr<Stream::DataWriteStream> &stream, const DShader &shader,
+                      Stream::ByteOrder byteOrder = Stream::ByteOrder::LITTLE);
 
 }
\ No newline at end of file
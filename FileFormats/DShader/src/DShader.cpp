@@ -1,4 +1,13 @@
 #include <DShader/DShader.hpp>
+#include <Stream/AbstractDataReadStream.hpp>
+#include <ErrorHandling/IllegalStateException.hpp>
+#include <cstring>
+
+// Files start with this magic, followed by the 8-bit format version and the 8-bit Stream::ByteOrder of all values.
+// Files written before the header existed start with the big-endian 64-bit length of the shader name instead.
+static const uint8_t DSHADER_MAGIC[8] = {'D', 'S', 'H', 'A', 'D', 'E', 'R', 0};
+
+#define DSHADER_FORMAT_VERSION 1
 
 namespace DShader {
 
@@ -15,9 +24,42 @@ namespace DShader {
         return variant;
     }
 
+    // Reads the header and the shader name, and switches the stream to the byte order of the file
+    std::string ReadDShaderHeader(const std::unique_ptr<Stream::DataReadStream> &stream) {
+        uint8_t magic[sizeof(DSHADER_MAGIC)];
+        if (stream->read(magic, sizeof(magic)) != sizeof(magic)) {
+            RAISE_EXCEPTION(errorhandling::IllegalStateException, "Shader package is too short to contain a header");
+        }
+        if (memcmp(magic, DSHADER_MAGIC, sizeof(DSHADER_MAGIC)) != 0) {
+            // Legacy file, the bytes read are the big-endian length of the name
+            stream->setByteOrder(Stream::ByteOrder::BIG);
+            uint64_t nameLength = 0;
+            for (uint8_t byte: magic) {
+                nameLength = nameLength << 8 | byte;
+            }
+            std::string name(nameLength, '\0');
+            if (stream->read(reinterpret_cast<uint8_t *>(name.data()), nameLength) != nameLength) {
+                RAISE_EXCEPTION(Stream::StreamUnderflowException, "Shader package ended in the shader name");
+            }
+            return name;
+        }
+        auto version = stream->readUint8();
+        if (version > DSHADER_FORMAT_VERSION) {
+            RAISE_EXCEPTION(errorhandling::IllegalStateException,
+                            "Shader package has unsupported format version " + std::to_string(version));
+        }
+        auto byteOrder = static_cast<Stream::ByteOrder>(stream->readUint8());
+        if (byteOrder != Stream::ByteOrder::BIG && byteOrder != Stream::ByteOrder::LITTLE) {
+            RAISE_EXCEPTION(errorhandling::IllegalStateException, "Shader package has unknown byte order");
+        }
+        stream->setByteOrder(byteOrder);
+        return stream->readString();
+    }
+
     DShader LoadDShader(const std::unique_ptr<Stream::DataReadStream> &stream) {
         DShader shader{};
-        shader.name = stream->readString();
+        Stream::ByteOrderScope byteOrderScope(*stream);
+        shader.name = ReadDShaderHeader(stream);
         uint64_t nVariants = stream->readUint64();
         for (uint64_t i = 0; i < nVariants; i++) {
             shader.variants.push_back(ReadDShaderVariant(stream));
@@ -32,7 +74,13 @@ namespace DShader {
         stream->writeBuffer(variant.data.data(), variant.data.size());
     }
 
-    void WriteDShader(const std::unique_ptr<Stream::DataWriteStream> &stream, const DShader &shader) {
+    void WriteDShader(const std::unique_ptr<Stream::DataWriteStream> &stream, const DShader &shader,
+                      Stream::ByteOrder byteOrder) {
+        stream->writeBuffer(DSHADER_MAGIC, sizeof(DSHADER_MAGIC));
+        stream->writeUint8(DSHADER_FORMAT_VERSION);
+        stream->writeUint8(static_cast<uint8_t>(byteOrder));
+
+        Stream::ByteOrderScope byteOrderScope(*stream, byteOrder);
         stream->writeString(shader.name);
         stream->writeUint64(shader.variants.size());
         for (const auto &variant : shader.variants) {
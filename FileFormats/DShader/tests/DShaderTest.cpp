@@ -0,0 +1,74 @@
+#include <gtest/gtest.h>
+#include <DShader/DShader.hpp>
+#include <Stream/MemoryDataStream.hpp>
+
+static DShader::DShader CreateShader() {
+    DShader::DShader shader{};
+    shader.name = "Lit";
+    shader.variants.push_back({DShader::VERTEX_SHADER, DShader::SPIRV_BINARY, {1, 2, 3, 4}});
+    shader.variants.push_back({DShader::FRAGMENT_SHADER, DShader::GLSL_SOURCE, {'v', 'o', 'i', 'd'}});
+    return shader;
+}
+
+static void ExpectShadersEqual(const DShader::DShader &expected, const DShader::DShader &actual) {
+    EXPECT_EQ(expected.name, actual.name);
+    ASSERT_EQ(expected.variants.size(), actual.variants.size());
+    for (size_t i = 0; i < expected.variants.size(); i++) {
+        EXPECT_EQ(expected.variants[i].type, actual.variants[i].type);
+        EXPECT_EQ(expected.variants[i].api, actual.variants[i].api);
+        EXPECT_EQ(expected.variants[i].data, actual.variants[i].data);
+    }
+}
+
+static DShader::DShader RoundTrip(const DShader::DShader &shader, Stream::ByteOrder byteOrder) {
+    auto writeStream = Stream::MemoryWriteStream::Growable();
+    std::unique_ptr<Stream::DataWriteStream> dataWriteStream = std::move(writeStream);
+    DShader::WriteDShader(dataWriteStream, shader, byteOrder);
+    auto buffer = dynamic_cast<Stream::MemoryWriteStream &>(*dataWriteStream).releaseBuffer();
+
+    std::unique_ptr<Stream::DataReadStream> readStream = Stream::MemoryReadStream::CopyOf(buffer.data(), buffer.size());
+    return DShader::LoadDShader(readStream);
+}
+
+TEST(DShader, RoundTripsLittleEndian) {
+    auto shader = CreateShader();
+    ExpectShadersEqual(shader, RoundTrip(shader, Stream::ByteOrder::LITTLE));
+}
+
+TEST(DShader, RoundTripsBigEndian) {
+    auto shader = CreateShader();
+    ExpectShadersEqual(shader, RoundTrip(shader, Stream::ByteOrder::BIG));
+}
+
+TEST(DShader, LoadsLegacyFilesWithoutHeader) {
+    // Files written before the header existed are big-endian and start with the name
+    auto shader = CreateShader();
+    std::unique_ptr<Stream::DataWriteStream> writeStream = Stream::MemoryWriteStream::Growable();
+    writeStream->writeString(shader.name);
+    writeStream->writeUint64(shader.variants.size());
+    for (const auto &variant: shader.variants) {
+        writeStream->writeInt32(variant.type);
+        writeStream->writeInt32(variant.api);
+        writeStream->writeUint64(variant.data.size());
+        writeStream->writeBuffer(variant.data.data(), variant.data.size());
+    }
+    auto buffer = dynamic_cast<Stream::MemoryWriteStream &>(*writeStream).releaseBuffer();
+
+    std::unique_ptr<Stream::DataReadStream> readStream = Stream::MemoryReadStream::CopyOf(buffer.data(), buffer.size());
+    ExpectShadersEqual(shader, DShader::LoadDShader(readStream));
+    EXPECT_EQ(Stream::ByteOrder::BIG, readStream->getByteOrder());
+}
+
+TEST(DShader, RestoresByteOrderOfTruncatedFiles) {
+    auto writeStream = Stream::MemoryWriteStream::Growable();
+    std::unique_ptr<Stream::DataWriteStream> dataWriteStream = std::move(writeStream);
+    DShader::WriteDShader(dataWriteStream, CreateShader(), Stream::ByteOrder::LITTLE);
+    auto buffer = dynamic_cast<Stream::MemoryWriteStream &>(*dataWriteStream).releaseBuffer();
+
+    // Cut off in the size of the last variant
+    std::unique_ptr<Stream::DataReadStream> readStream = Stream::MemoryReadStream::CopyOf(buffer.data(),
+                                                                                          buffer.size() - 8);
+    readStream->setByteOrder(Stream::ByteOrder::BIG);
+    EXPECT_THROW(DShader::LoadDShader(readStream), Stream::StreamUnderflowException);
+    EXPECT_EQ(Stream::ByteOrder::BIG, readStream->getByteOrder());
+}
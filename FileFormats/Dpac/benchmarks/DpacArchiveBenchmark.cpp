@@ -0,0 +1,66 @@
+#include <benchmark/benchmark.h>
+#include <Dpac/Dpac.hpp>
+#include <Stream/MemoryDataStream.hpp>
+
+static std::string MakeArchive(uint64_t nEntries) {
+    std::string archivePath = "DpacArchiveBenchmark_" + std::to_string(nEntries) + ".dpac";
+    const uint8_t content[] = "Benchmark entry content";
+
+    Dpac::WriteOnlyArchive writeArchive = Dpac::WriteOnlyArchive::Open(archivePath);
+    writeArchive.reserveNEntries(nEntries);
+    writeArchive.finalizeEntryTable();
+    for (uint64_t entryIndex = 0; entryIndex < nEntries; entryIndex++) {
+        std::shared_ptr<Stream::DataReadStream> memoryStream = Stream::MemoryReadStream::CopyOf(content, sizeof(content));
+        writeArchive.defineEntryFromUncompressedStream(entryIndex, "/entry" + std::to_string(entryIndex) + ".txt",
+                                                       memoryStream);
+    }
+    writeArchive.close();
+    return archivePath;
+}
+
+static void BM_OpenArchive(benchmark::State &state) {
+    auto nEntries = static_cast<uint64_t>(state.range(0));
+    std::string archivePath = MakeArchive(nEntries);
+    for (auto _: state) {
+        Dpac::ReadOnlyArchive archive = Dpac::ReadOnlyArchive::Open(archivePath);
+        benchmark::DoNotOptimize(archive.getFileContentOffsetTable().size());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * nEntries));
+}
+
+BENCHMARK(BM_OpenArchive)->Arg(1000)->Arg(10000)->Arg(100000)->Unit(benchmark::kMillisecond);
+
+static std::vector<std::string> EntryNames(uint64_t nEntries) {
+    std::vector<std::string> entryNames;
+    for (uint64_t entryIndex = 0; entryIndex < nEntries; entryIndex++) {
+        entryNames.push_back("/entry" + std::to_string(entryIndex) + ".txt");
+    }
+    return entryNames;
+}
+
+static void BM_ReadEntriesOneByOne(benchmark::State &state) {
+    auto nEntries = static_cast<uint64_t>(state.range(0));
+    Dpac::ReadOnlyArchive archive = Dpac::ReadOnlyArchive::Open(MakeArchive(nEntries));
+    auto entryNames = EntryNames(nEntries);
+    for (auto _: state) {
+        for (const auto &entryName: entryNames) {
+            std::vector<uint8_t> content(archive.getUncompressedEntrySize(entryName));
+            archive.getEntryStream(entryName)->read(content.data(), content.size());
+            benchmark::DoNotOptimize(content.data());
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * nEntries));
+}
+
+static void BM_ReadEntriesBatched(benchmark::State &state) {
+    auto nEntries = static_cast<uint64_t>(state.range(0));
+    Dpac::ReadOnlyArchive archive = Dpac::ReadOnlyArchive::Open(MakeArchive(nEntries));
+    auto entryNames = EntryNames(nEntries);
+    for (auto _: state) {
+        benchmark::DoNotOptimize(archive.readEntries(entryNames));
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * nEntries));
+}
+
+BENCHMARK(BM_ReadEntriesOneByOne)->Arg(100)->Arg(1000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ReadEntriesBatched)->Arg(100)->Arg(1000)->Unit(benchmark::kMillisecond);
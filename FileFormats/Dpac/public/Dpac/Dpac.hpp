@@ -3,6 +3,7 @@
 #include <ErrorHandling/ErrorHandling.hpp>
 #include <Stream/FileDataReadStream.hpp>
 #include <Stream/FileDataWriteStream.hpp>
+#include <Stream/BatchReader.hpp>
 #include <map>
 #include <vector>
 #include <string>
@@ -26,10 +27,27 @@ namespace Dpac {
 
     NEW_EXCEPTION_TYPE(ArchiveEntryTableAlreadyFinalizedException);
 
+    /**
+     * How the entries of an archive are read from its file
+     */
+    enum class ArchiveReadMode {
+        /**
+         * Through the page cache, for archives that are read repeatedly
+         */
+        CACHED,
+        /**
+         * Bypassing the page cache, for bulk ingestion of large archives read once,
+         * which would otherwise evict everything else from the cache
+         */
+        DIRECT
+    };
+
     class ReadOnlyArchive {
     private:
         std::shared_ptr<Stream::FileDataReadStream> dataStream;
 
+        ArchiveReadMode readMode;
+
         uint64_t heapStart{};
 
         /**
@@ -48,17 +66,42 @@ namespace Dpac {
          */
         std::map<std::string, uint64_t> entryContentUncompressedSizeTable{};
 
-        explicit ReadOnlyArchive(const std::string &archiveFilePath);
+        /**
+         * Opened on the first batch read
+         */
+        std::shared_ptr<Stream::BatchReader> batchReader;
+
+        ReadOnlyArchive(const std::string &archiveFilePath, ArchiveReadMode readMode);
+
+        uint64_t getEntryOffset(const std::string &entryName);
 
     public:
 
-        static ReadOnlyArchive Open(const std::string &archiveFilePath);
+        static ReadOnlyArchive Open(const std::string &archiveFilePath,
+                                    ArchiveReadMode readMode = ArchiveReadMode::CACHED);
 
         [[nodiscard]] const std::map<std::string, uint64_t> &getFileContentOffsetTable() const;
 
         [[nodiscard]] std::unique_ptr<Stream::DataReadStream> getEntryStream(const std::string &entryName);
 
+        /**
+         * @param entryName the name of the entry
+         * @return a stream of the zstd compressed entry content, as it is stored in the archive
+         */
+        [[nodiscard]] std::unique_ptr<Stream::FileDataReadStream> getCompressedEntryStream(const std::string &entryName);
+
+        uint64_t getCompressedEntrySize(const std::string &entryName);
+
         uint64_t getUncompressedEntrySize(const std::string &entryName);
+
+        /**
+         * Reads and decompresses many entries at once.
+         * The compressed entries are read in a single batch, using io_uring on Linux where available,
+         * instead of one blocking read after another.
+         * @param entryNames the names of the entries to read
+         * @return the uncompressed contents of the entries, in the order of entryNames
+         */
+        std::vector<std::vector<uint8_t>> readEntries(const std::vector<std::string> &entryNames);
     };
 
     class WriteOnlyArchive {
@@ -95,6 +138,17 @@ namespace Dpac {
         void defineEntryFromUncompressedStream(uint64_t entryIndex, const std::string &entryName,
                                                const std::shared_ptr<Stream::DataReadStream> &uncompressedStream);
 
+        /**
+         * Defines an entry from content that is already zstd compressed. The content is copied as is.
+         * @param entryIndex the index of the entry in the entry table
+         * @param entryName the name of the entry
+         * @param compressedStream the zstd compressed entry content, eg. from ReadOnlyArchive::getCompressedEntryStream
+         * @param uncompressedSize the size of the entry content after decompression
+         */
+        void defineEntryFromCompressedStream(uint64_t entryIndex, const std::string &entryName,
+                                             const std::shared_ptr<Stream::DataReadStream> &compressedStream,
+                                             uint64_t uncompressedSize);
+
         void reserveNEntries(uint64_t numEntries);
 
         void finalizeEntryTable();
@@ -103,6 +157,11 @@ namespace Dpac {
 
     private:
         static uint64_t getEntryTableOffset(uint64_t entryIndex);
+
+        void checkEntryDefinable(uint64_t entryIndex) const;
+
+        void writeEntry(uint64_t entryIndex, const std::string &entryName, uint64_t compressedSize,
+                        uint64_t uncompressedSize);
     };
 
 }
\ No newline at end of file
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <ErrorHandling/ErrorHandling.hpp>
+#include <string>
+#include <cstdint>
+
+namespace Dpac {
+
+    NEW_EXCEPTION_TYPE(PatchInvalidException);
+
+    /**
+     * Describes how the content of an entry of the new archive is obtained when applying a patch.
+     */
+    enum class PatchOperation : int8_t {
+        /**
+         * The entry is unchanged and copied from the old archive.
+         * The hash of its content is stored in the patch and checked before copying.
+         */
+        COPY = 0,
+        /**
+         * The entry is stored in the patch as a zstd frame, the same way it is stored in an archive
+         */
+        ADD = 1,
+        /**
+         * The entry is stored in the patch as a zstd frame compressed against the content of
+         * the entry with the same name in the old archive (like zstd --patch-from).
+         */
+        DELTA = 2
+    };
+
+    /**
+     * Creates a patch, which turns the old archive into the new archive.
+     * Entries are diffed by name. Unchanged entries are referenced, modified entries are delta compressed against
+     * their old version, unless a plain copy of the new entry is smaller. New entries are stored as is.
+     * @param oldArchivePath the path of the archive the patch is applied to
+     * @param newArchivePath the path of the archive the patch produces
+     * @param patchFilePath the path to write the patch to
+     */
+    void CreatePatch(const std::string &oldArchivePath, const std::string &newArchivePath,
+                     const std::string &patchFilePath);
+
+    /**
+     * Applies a patch created by #CreatePatch to the old archive, writing the new archive.
+     * Entries are streamed. The memory used is bounded by the size of the largest delta compressed entry,
+     * not by the size of the archives.
+     * @param oldArchivePath the path of the archive the patch was created against
+     * @param patchFilePath the path of the patch
+     * @param newArchivePath the path to write the new archive to
+     * @throws PatchInvalidException if the patch is malformed or the old archive is not the one it was created against
+     */
+    void ApplyPatch(const std::string &oldArchivePath, const std::string &patchFilePath,
+                    const std::string &newArchivePath);
+
+}
@@ -2,6 +2,10 @@
 #include <Utils/FileUtils.hpp>
 #include <Stream/ZstdDeflateStream.hpp>
 #include <Stream/ZstdInflateStream.hpp>
+#include <Stream/PrefetchingReadStream.hpp>
+#include <Stream/MemoryDataStream.hpp>
+#include <Stream/DirectFileReadStream.hpp>
+#include <cstring>
 
 using namespace Dpac;
 
@@ -13,21 +17,56 @@ EXCEPTION_TYPE_DEFAULT_IMPL(ArchiveTooFewEntriesReservedException);
 EXCEPTION_TYPE_DEFAULT_IMPL(ArchiveEntryNotDefinedException);
 EXCEPTION_TYPE_DEFAULT_IMPL(EntryDoesNotExistException);
 
-ReadOnlyArchive::ReadOnlyArchive(const std::string &archiveFilePath) : dataStream(
-        Stream::FileDataReadStream::Open(archiveFilePath)) {
+// Size of one entry in the entry table:
+// fixed BYTE string + 64-bit offset, + 64-bit compressed size, + 64-bit uncompressed size
+#define DPAC_ENTRY_SIZE (DPAC_MAX_PATH + sizeof(uint64_t) + sizeof(uint64_t) + sizeof(uint64_t))
+
+// Compressed size from which entries are read ahead while decompressing.
+// Smaller entries are read in a few calls, which does not pay for starting a thread.
+#define DPAC_PREFETCH_MIN_COMPRESSED_SIZE 1048576
+
+static uint64_t ReadBigEndianUint64(const uint8_t *bytes) {
+    uint64_t value = 0;
+    for (size_t i = 0; i < sizeof(uint64_t); i++) {
+        value = value << 8 | bytes[i];
+    }
+    return value;
+}
+
+ReadOnlyArchive::ReadOnlyArchive(const std::string &archiveFilePath, ArchiveReadMode readMode) :
+        dataStream(Stream::FileDataReadStream::Open(archiveFilePath)), readMode(readMode) {
     heapStart = dataStream->readUint64();
 
-    // Read entry table
-    while (  dataStream->getPosition() < heapStart) {
-        std::string entryName =   dataStream->readFixedString(DPAC_MAX_PATH);
-        entryContentOffsetTable[entryName] =   dataStream->readUint64();
-        entryContentCompressedSizeTable[entryName] =   dataStream->readUint64();
-        entryContentUncompressedSizeTable[entryName] =   dataStream->readUint64();
+    uint64_t entryTableOffset = dataStream->getPosition();
+    if (heapStart < entryTableOffset || heapStart > dataStream->getLength() ||
+        (heapStart - entryTableOffset) % DPAC_ENTRY_SIZE != 0) {
+        RAISE_EXCEPTION(ArchiveOpenFailedException,
+                        "Failed to open archive \"" + archiveFilePath + "\": Invalid heap start " +
+                        std::to_string(heapStart));
+    }
+
+    // Read the entire entry table with one read and parse it in memory.
+    // Reading it field by field from the file stream costs multiple reads per entry.
+    uint64_t entryTableLength = heapStart - entryTableOffset;
+    std::vector<uint8_t> entryTable(entryTableLength);
+    if (dataStream->read(entryTable.data(), entryTableLength) != entryTableLength) {
+        RAISE_EXCEPTION(ArchiveOpenFailedException,
+                        "Failed to open archive \"" + archiveFilePath + "\": Entry table is truncated");
+    }
+
+    for (uint64_t entryOffset = 0; entryOffset < entryTableLength; entryOffset += DPAC_ENTRY_SIZE) {
+        const uint8_t *entry = entryTable.data() + entryOffset;
+        const char *entryNameChars = reinterpret_cast<const char *>(entry);
+        std::string entryName(entryNameChars, strnlen(entryNameChars, DPAC_MAX_PATH));
+        entry += DPAC_MAX_PATH;
+        entryContentOffsetTable[entryName] = ReadBigEndianUint64(entry);
+        entryContentCompressedSizeTable[entryName] = ReadBigEndianUint64(entry + sizeof(uint64_t));
+        entryContentUncompressedSizeTable[entryName] = ReadBigEndianUint64(entry + 2 * sizeof(uint64_t));
     }
 }
 
-ReadOnlyArchive ReadOnlyArchive::Open(const std::string &path) {
-    return ReadOnlyArchive(path);
+ReadOnlyArchive ReadOnlyArchive::Open(const std::string &path, ArchiveReadMode readMode) {
+    return ReadOnlyArchive(path, readMode);
 }
 
 const std::map<std::string, uint64_t> &ReadOnlyArchive::getFileContentOffsetTable() const {
@@ -35,20 +74,48 @@ const std::map<std::string, uint64_t> &ReadOnlyArchive::getFileContentOffsetTabl
 }
 
 std::unique_ptr<Stream::DataReadStream> ReadOnlyArchive::getEntryStream(const std::string &entryName) {
+    std::shared_ptr<Stream::AbstractDataReadStream> compressedStream;
+    if (readMode == ArchiveReadMode::DIRECT) {
+        compressedStream = std::make_shared<Stream::DirectFileReadStream>(
+                dataStream->getFilePath(), getEntryOffset(entryName), getCompressedEntrySize(entryName)
+        );
+    } else {
+        compressedStream = getCompressedEntryStream(entryName);
+    }
+    if (getCompressedEntrySize(entryName) >= DPAC_PREFETCH_MIN_COMPRESSED_SIZE) {
+        compressedStream = std::make_shared<Stream::PrefetchingReadStream>(compressedStream);
+    }
+    return std::make_unique<Stream::ZstdInflateStream>(
+            compressedStream,
+            getUncompressedEntrySize(entryName)
+    );
+}
+
+uint64_t ReadOnlyArchive::getEntryOffset(const std::string &entryName) {
     auto iterator = entryContentOffsetTable.find(entryName);
     if (iterator == entryContentOffsetTable.end()) {
         RAISE_EXCEPTION(EntryDoesNotExistException, "No entry named \"" + entryName + "\" exists in the archive");
     }
     uint64_t heapRelativeOffset = iterator->second;
-    uint64_t absoluteOffset = heapStart + heapRelativeOffset;
-    return std::make_unique<Stream::ZstdInflateStream>(
-            std::make_shared<Stream::FileDataReadStream>(
-                      dataStream->getFilePath(), absoluteOffset,
-                    entryContentCompressedSizeTable[entryName]
-            )
+    return heapStart + heapRelativeOffset;
+}
+
+std::unique_ptr<Stream::FileDataReadStream> ReadOnlyArchive::getCompressedEntryStream(const std::string &entryName) {
+    uint64_t absoluteOffset = getEntryOffset(entryName);
+    return std::make_unique<Stream::FileDataReadStream>(
+            dataStream->getFilePath(), absoluteOffset,
+            entryContentCompressedSizeTable[entryName]
     );
 }
 
+uint64_t ReadOnlyArchive::getCompressedEntrySize(const std::string &entryName) {
+    auto iterator = entryContentCompressedSizeTable.find(entryName);
+    if (iterator == entryContentCompressedSizeTable.end()) {
+        RAISE_EXCEPTION(EntryDoesNotExistException, "No entry named \"" + entryName + "\" exists in the archive");
+    }
+    return iterator->second;
+}
+
 uint64_t ReadOnlyArchive::getUncompressedEntrySize(const std::string &entryName) {
     auto iterator = entryContentUncompressedSizeTable.find(entryName);
     if (iterator == entryContentUncompressedSizeTable.end()) {
@@ -57,6 +124,39 @@ uint64_t ReadOnlyArchive::getUncompressedEntrySize(const std::string &entryName)
     return iterator->second;
 }
 
+std::vector<std::vector<uint8_t>> ReadOnlyArchive::readEntries(const std::vector<std::string> &entryNames) {
+    std::vector<std::vector<uint8_t>> compressedContents(entryNames.size());
+    std::vector<Stream::ReadRequest> requests(entryNames.size());
+    for (size_t i = 0; i < entryNames.size(); i++) {
+        auto iterator = entryContentOffsetTable.find(entryNames[i]);
+        if (iterator == entryContentOffsetTable.end()) {
+            RAISE_EXCEPTION(EntryDoesNotExistException,
+                            "No entry named \"" + entryNames[i] + "\" exists in the archive");
+        }
+        compressedContents[i].resize(entryContentCompressedSizeTable[entryNames[i]]);
+        requests[i] = {heapStart + iterator->second, compressedContents[i].size(), compressedContents[i].data()};
+    }
+    if (batchReader == nullptr) {
+        batchReader = Stream::BatchReader::Open(dataStream->getFilePath());
+    }
+    batchReader->read(requests);
+
+    std::vector<std::vector<uint8_t>> contents(entryNames.size());
+    for (size_t i = 0; i < entryNames.size(); i++) {
+        uint64_t uncompressedSize = getUncompressedEntrySize(entryNames[i]);
+        Stream::ZstdInflateStream inflateStream(
+                Stream::MemoryReadStream::Wrap(compressedContents[i].data(), compressedContents[i].size()),
+                uncompressedSize
+        );
+        contents[i].resize(uncompressedSize);
+        if (inflateStream.read(contents[i].data(), uncompressedSize) != uncompressedSize) {
+            RAISE_EXCEPTION(Stream::StreamUnderflowException,
+                            "Entry \"" + entryNames[i] + "\" is shorter than its uncompressed size");
+        }
+    }
+    return contents;
+}
+
 WriteOnlyArchive::WriteOnlyArchive(const std::string &archiveFilePath) :
         dataStream(Stream::FileDataWriteStream::Open(archiveFilePath)) {
     // We will seek back here on entry table finalization, which marks the beginning of the heap,
@@ -71,13 +171,10 @@ WriteOnlyArchive WriteOnlyArchive::Open(const std::string &archiveFilePath) {
 
 uint64_t WriteOnlyArchive::getEntryTableOffset(uint64_t entryIndex) {
     // Skip heap start header (64-bit) + n * entry_size
-    // entry = fixed BYTE string + 64-bit offset, + 64-bit compressed size, + 64-bit uncompressed size
-    return sizeof(uint64_t) + entryIndex * (DPAC_MAX_PATH + sizeof(uint64_t) + sizeof(uint64_t) + sizeof(uint64_t));
+    return sizeof(uint64_t) + entryIndex * DPAC_ENTRY_SIZE;
 }
 
-void WriteOnlyArchive::defineEntryFromUncompressedStream(uint64_t entryIndex, const std::string &entryName,
-                                                         const std::shared_ptr<Stream::DataReadStream> &sourceStream) {
-
+void WriteOnlyArchive::checkEntryDefinable(uint64_t entryIndex) const {
     if (!entryTableFinalized) {
         RAISE_EXCEPTION(ArchiveEntryTableNotYetFinalizedException,
                         "Archive entry table not finalized. Call finalizeEntryTable() before defining entries.");
@@ -89,11 +186,11 @@ void WriteOnlyArchive::defineEntryFromUncompressedStream(uint64_t entryIndex, co
                         std::to_string(numEntries)
         );
     }
-    std::string theEntryName = entryName;
-    if (theEntryName.find_first_of('/') != 0) {
-        theEntryName = "/" + theEntryName;
-    }
-    entryContentOffsetTable[theEntryName] = currentHeapOffset;
+}
+
+void WriteOnlyArchive::defineEntryFromUncompressedStream(uint64_t entryIndex, const std::string &entryName,
+                                                         const std::shared_ptr<Stream::DataReadStream> &sourceStream) {
+    checkEntryDefinable(entryIndex);
 
     dataStream->seek(heapStart + currentHeapOffset);
     auto zstdDataStream = Stream::ZstdDeflateStream(dataStream);
@@ -102,6 +199,28 @@ void WriteOnlyArchive::defineEntryFromUncompressedStream(uint64_t entryIndex, co
     auto nBytesWritten = nWrittenAndRead.first;
     auto nBytesRead = nWrittenAndRead.second;
 
+    writeEntry(entryIndex, entryName, nBytesWritten, nBytesRead);
+}
+
+void WriteOnlyArchive::defineEntryFromCompressedStream(uint64_t entryIndex, const std::string &entryName,
+                                                       const std::shared_ptr<Stream::DataReadStream> &compressedStream,
+                                                       uint64_t uncompressedSize) {
+    checkEntryDefinable(entryIndex);
+
+    dataStream->seek(heapStart + currentHeapOffset);
+    auto nBytesWritten = dataStream->writeStreamContents(compressedStream).first;
+
+    writeEntry(entryIndex, entryName, nBytesWritten, uncompressedSize);
+}
+
+void WriteOnlyArchive::writeEntry(uint64_t entryIndex, const std::string &entryName, uint64_t compressedSize,
+                                  uint64_t uncompressedSize) {
+    std::string theEntryName = entryName;
+    if (theEntryName.find_first_of('/') != 0) {
+        theEntryName = "/" + theEntryName;
+    }
+    entryContentOffsetTable[theEntryName] = currentHeapOffset;
+
     dataStream->seek(getEntryTableOffset(entryIndex));
     dataStream->writeFixedString(entryName, DPAC_MAX_PATH);
 
@@ -109,12 +228,12 @@ void WriteOnlyArchive::defineEntryFromUncompressedStream(uint64_t entryIndex, co
     dataStream->writeUint64(currentHeapOffset);
 
     // Write compressed size of entry content
-    dataStream->writeUint64(nBytesWritten);
+    dataStream->writeUint64(compressedSize);
 
     // Write uncompressed size
-    dataStream->writeUint64(nBytesRead);
+    dataStream->writeUint64(uncompressedSize);
 
-    currentHeapOffset += nBytesWritten;
+    currentHeapOffset += compressedSize;
 }
 
 void WriteOnlyArchive::reserveNEntries(uint64_t nEntries) {
@@ -0,0 +1,190 @@
+#include <Dpac/DpacPatch.hpp>
+#include <Dpac/Dpac.hpp>
+#include <Stream/ZstdDeflateStream.hpp>
+#include <Stream/ZstdInflateStream.hpp>
+#include <Stream/Xxh3.hpp>
+#include <filesystem>
+#include <cstring>
+
+// Patch file layout:
+// 64-bit number of entries in the new archive, followed by one record per entry:
+// fixed BYTE string entry name + 8-bit PatchOperation + 64-bit uncompressed size,
+// followed by the 64-bit XXH3 hash of the content of the old entry for COPY records
+// and by 64-bit payload size + payload for ADD and DELTA records.
+
+#define PATCH_COMPARE_CHUNK_SIZE 65536
+
+using namespace Dpac;
+
+EXCEPTION_TYPE_DEFAULT_IMPL(PatchInvalidException);
+
+static std::vector<uint8_t> ReadEntryContent(ReadOnlyArchive &archive, const std::string &entryName) {
+    uint64_t entrySize = archive.getUncompressedEntrySize(entryName);
+    std::vector<uint8_t> content(entrySize);
+    auto entryStream = archive.getEntryStream(entryName);
+    if (entryStream->read(content.data(), entrySize) != entrySize) {
+        RAISE_EXCEPTION(Stream::StreamUnderflowException,
+                        "Entry \"" + entryName + "\" is shorter than its uncompressed size");
+    }
+    return content;
+}
+
+static uint64_t HashEntryContent(ReadOnlyArchive &archive, const std::string &entryName) {
+    Stream::Xxh3 hash;
+    std::vector<uint8_t> chunk(PATCH_COMPARE_CHUNK_SIZE);
+    auto entryStream = archive.getEntryStream(entryName);
+    size_t nRead;
+    do {
+        nRead = entryStream->read(chunk.data(), chunk.size());
+        hash.update(chunk.data(), nRead);
+    } while (nRead == chunk.size());
+    return hash.digest();
+}
+
+static bool StreamsEqual(Stream::DataReadStream &streamA, Stream::DataReadStream &streamB) {
+    std::vector<uint8_t> chunkA(PATCH_COMPARE_CHUNK_SIZE), chunkB(PATCH_COMPARE_CHUNK_SIZE);
+    while (true) {
+        size_t nReadA = streamA.read(chunkA.data(), chunkA.size());
+        size_t nReadB = streamB.read(chunkB.data(), chunkB.size());
+        if (nReadA != nReadB || memcmp(chunkA.data(), chunkB.data(), nReadA) != 0) {
+            return false;
+        }
+        if (nReadA < chunkA.size()) {
+            return true;
+        }
+    }
+}
+
+static bool EntriesEqual(ReadOnlyArchive &oldArchive, ReadOnlyArchive &newArchive, const std::string &entryName) {
+    if (oldArchive.getUncompressedEntrySize(entryName) != newArchive.getUncompressedEntrySize(entryName)) {
+        return false;
+    }
+    // Identical frames are the common case for untouched entries and are cheaper to compare
+    if (oldArchive.getCompressedEntrySize(entryName) == newArchive.getCompressedEntrySize(entryName) &&
+        StreamsEqual(*oldArchive.getCompressedEntryStream(entryName),
+                     *newArchive.getCompressedEntryStream(entryName))) {
+        return true;
+    }
+    return StreamsEqual(*oldArchive.getEntryStream(entryName), *newArchive.getEntryStream(entryName));
+}
+
+static void WriteRecordHeader(const std::shared_ptr<Stream::FileDataWriteStream> &patchStream,
+                              const std::string &entryName, PatchOperation operation, uint64_t uncompressedSize) {
+    patchStream->writeFixedString(entryName, DPAC_MAX_PATH);
+    patchStream->writeInt8(static_cast<int8_t>(operation));
+    patchStream->writeUint64(uncompressedSize);
+}
+
+static void WriteAddRecord(const std::shared_ptr<Stream::FileDataWriteStream> &patchStream,
+                           ReadOnlyArchive &newArchive, const std::string &entryName) {
+    WriteRecordHeader(patchStream, entryName, PatchOperation::ADD, newArchive.getUncompressedEntrySize(entryName));
+    patchStream->writeUint64(newArchive.getCompressedEntrySize(entryName));
+    std::shared_ptr<Stream::DataReadStream> compressedStream = newArchive.getCompressedEntryStream(entryName);
+    patchStream->writeStreamContents(compressedStream);
+}
+
+static void WriteDeltaRecord(const std::shared_ptr<Stream::FileDataWriteStream> &patchStream,
+                             ReadOnlyArchive &oldArchive, ReadOnlyArchive &newArchive, const std::string &entryName) {
+    uint64_t recordPosition = patchStream->getPosition();
+    WriteRecordHeader(patchStream, entryName, PatchOperation::DELTA, newArchive.getUncompressedEntrySize(entryName));
+
+    // The payload size is only known after compressing
+    uint64_t payloadSizePosition = patchStream->getPosition();
+    patchStream->writeUint64(0);
+
+    size_t deltaSize;
+    {
+        Stream::ZstdDeflateStream deltaStream(patchStream, ReadEntryContent(oldArchive, entryName));
+        std::shared_ptr<Stream::DataReadStream> newEntryStream = newArchive.getEntryStream(entryName);
+        deltaSize = deltaStream.writeStreamContents(newEntryStream).first;
+    }
+
+    if (deltaSize >= newArchive.getCompressedEntrySize(entryName)) {
+        // The entry changed too much for the delta to pay off
+        patchStream->seek(recordPosition);
+        WriteAddRecord(patchStream, newArchive, entryName);
+        return;
+    }
+    uint64_t endPosition = patchStream->getPosition();
+    patchStream->seek(payloadSizePosition);
+    patchStream->writeUint64(deltaSize);
+    patchStream->seek(endPosition);
+}
+
+void Dpac::CreatePatch(const std::string &oldArchivePath, const std::string &newArchivePath,
+                       const std::string &patchFilePath) {
+    ReadOnlyArchive oldArchive = ReadOnlyArchive::Open(oldArchivePath);
+    ReadOnlyArchive newArchive = ReadOnlyArchive::Open(newArchivePath);
+    const auto &oldEntries = oldArchive.getFileContentOffsetTable();
+    const auto &newEntries = newArchive.getFileContentOffsetTable();
+
+    std::shared_ptr<Stream::FileDataWriteStream> patchStream = Stream::FileDataWriteStream::Open(patchFilePath);
+    patchStream->writeUint64(newEntries.size());
+    for (const auto &[entryName, offset]: newEntries) {
+        if (oldEntries.find(entryName) == oldEntries.end()) {
+            WriteAddRecord(patchStream, newArchive, entryName);
+        } else if (EntriesEqual(oldArchive, newArchive, entryName)) {
+            WriteRecordHeader(patchStream, entryName, PatchOperation::COPY,
+                              newArchive.getUncompressedEntrySize(entryName));
+            patchStream->writeUint64(HashEntryContent(oldArchive, entryName));
+        } else {
+            WriteDeltaRecord(patchStream, oldArchive, newArchive, entryName);
+        }
+    }
+    uint64_t patchLength = patchStream->getPosition();
+    patchStream->close();
+
+    // A delta record replaced by a shorter add record can leave stale bytes at the end of the file
+    std::filesystem::resize_file(patchFilePath, patchLength);
+}
+
+void Dpac::ApplyPatch(const std::string &oldArchivePath, const std::string &patchFilePath,
+                      const std::string &newArchivePath) {
+    ReadOnlyArchive oldArchive = ReadOnlyArchive::Open(oldArchivePath);
+    std::unique_ptr<Stream::FileDataReadStream> patchStream = Stream::FileDataReadStream::Open(patchFilePath);
+
+    uint64_t nEntries = patchStream->readUint64();
+    WriteOnlyArchive newArchive = WriteOnlyArchive::Open(newArchivePath);
+    newArchive.reserveNEntries(nEntries);
+    newArchive.finalizeEntryTable();
+
+    for (uint64_t entryIndex = 0; entryIndex < nEntries; entryIndex++) {
+        std::string entryName = patchStream->readFixedString(DPAC_MAX_PATH);
+        auto operation = static_cast<PatchOperation>(patchStream->readInt8());
+        uint64_t uncompressedSize = patchStream->readUint64();
+
+        if (operation == PatchOperation::COPY) {
+            uint64_t contentHash = patchStream->readUint64();
+            // An entry of the same size can still have different content, which the compressed frame is copied with
+            if (oldArchive.getUncompressedEntrySize(entryName) != uncompressedSize ||
+                HashEntryContent(oldArchive, entryName) != contentHash) {
+                RAISE_EXCEPTION(PatchInvalidException,
+                                "Entry \"" + entryName + "\" differs from the archive the patch was created against");
+            }
+            newArchive.defineEntryFromCompressedStream(entryIndex, entryName,
+                                                       oldArchive.getCompressedEntryStream(entryName),
+                                                       uncompressedSize);
+            continue;
+        }
+        if (operation != PatchOperation::ADD && operation != PatchOperation::DELTA) {
+            RAISE_EXCEPTION(PatchInvalidException,
+                            "Unknown patch operation " + std::to_string(static_cast<int8_t>(operation)) +
+                            " for entry \"" + entryName + "\"");
+        }
+
+        uint64_t payloadSize = patchStream->readUint64();
+        uint64_t payloadPosition = patchStream->getPosition();
+        auto payloadStream = std::make_shared<Stream::FileDataReadStream>(patchFilePath, payloadPosition, payloadSize);
+        if (operation == PatchOperation::ADD) {
+            newArchive.defineEntryFromCompressedStream(entryIndex, entryName, payloadStream, uncompressedSize);
+        } else {
+            auto entryStream = std::make_shared<Stream::ZstdInflateStream>(
+                    payloadStream, uncompressedSize,
+                    ReadEntryContent(oldArchive, entryName)
+            );
+            newArchive.defineEntryFromUncompressedStream(entryIndex, entryName, entryStream);
+        }
+        patchStream->seek(payloadPosition + payloadSize);
+    }
+    newArchive.close();
+}
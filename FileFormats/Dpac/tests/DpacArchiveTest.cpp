@@ -65,4 +65,56 @@ TEST(DpacArchive, DpacWriteAndReadTest) {
             EXPECT_EQ(0, memcmp(buffer, memoryContent3, streamSize));
         }
     }
-}
\ No newline at end of file
+}
+
+TEST(DpacArchive, ReadEntries) {
+    std::vector<std::string> entryNames;
+    std::vector<std::vector<uint8_t>> contents;
+    {
+        Dpac::WriteOnlyArchive writeArchive = Dpac::WriteOnlyArchive::Open("DpacArchiveTest.dpac");
+        writeArchive.reserveNEntries(100);
+        writeArchive.finalizeEntryTable();
+        for (uint64_t entryIndex = 0; entryIndex < 100; entryIndex++) {
+            entryNames.push_back("/entry" + std::to_string(entryIndex) + ".bin");
+            contents.emplace_back(entryIndex * 97, static_cast<uint8_t>(entryIndex));
+            std::shared_ptr<Stream::DataReadStream> memoryStream = Stream::MemoryReadStream::CopyOf(
+                    contents.back().data(), contents.back().size());
+            writeArchive.defineEntryFromUncompressedStream(entryIndex, entryNames.back(), memoryStream);
+        }
+        writeArchive.close();
+    }
+
+    Dpac::ReadOnlyArchive readArchive = Dpac::ReadOnlyArchive::Open("DpacArchiveTest.dpac");
+    std::reverse(entryNames.begin(), entryNames.end());
+    std::reverse(contents.begin(), contents.end());
+    EXPECT_EQ(contents, readArchive.readEntries(entryNames));
+    EXPECT_THROW(readArchive.readEntries({"/missing.bin"}), Dpac::EntryDoesNotExistException);
+}
+
+TEST(DpacArchive, DirectReadMode) {
+    std::vector<uint8_t> content(3 * 1048576 + 17);
+    for (size_t i = 0; i < content.size(); i++) {
+        content[i] = static_cast<uint8_t>(i % 251);
+    }
+    {
+        Dpac::WriteOnlyArchive writeArchive = Dpac::WriteOnlyArchive::Open("DpacArchiveTest.dpac");
+        writeArchive.reserveNEntries(2);
+        writeArchive.finalizeEntryTable();
+        std::shared_ptr<Stream::DataReadStream> memoryStream = Stream::MemoryReadStream::CopyOf(content.data(),
+                                                                                                content.size());
+        writeArchive.defineEntryFromUncompressedStream(0, "/large.bin", memoryStream);
+        memoryStream = Stream::MemoryReadStream::CopyOf(content.data(), 10);
+        writeArchive.defineEntryFromUncompressedStream(1, "/small.bin", memoryStream);
+        writeArchive.close();
+    }
+
+    Dpac::ReadOnlyArchive readArchive = Dpac::ReadOnlyArchive::Open("DpacArchiveTest.dpac",
+                                                                    Dpac::ArchiveReadMode::DIRECT);
+    // The large entry is also read ahead on a background thread
+    std::vector<uint8_t> large(content.size());
+    EXPECT_EQ(large.size(), readArchive.getEntryStream("/large.bin")->read(large.data(), large.size()));
+    EXPECT_EQ(content, large);
+    std::vector<uint8_t> small(10);
+    EXPECT_EQ(small.size(), readArchive.getEntryStream("/small.bin")->read(small.data(), small.size()));
+    EXPECT_TRUE(std::equal(small.begin(), small.end(), content.begin()));
+}
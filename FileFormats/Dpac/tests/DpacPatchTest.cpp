@@ -0,0 +1,78 @@
+#include <gtest/gtest.h>
+#include <Dpac/Dpac.hpp>
+#include <Dpac/DpacPatch.hpp>
+#include <Stream/MemoryDataStream.hpp>
+
+static void WriteArchive(const std::string &archivePath, const std::vector<std::pair<std::string, std::string>> &entries) {
+    Dpac::WriteOnlyArchive writeArchive = Dpac::WriteOnlyArchive::Open(archivePath);
+    writeArchive.reserveNEntries(entries.size());
+    writeArchive.finalizeEntryTable();
+    for (size_t entryIndex = 0; entryIndex < entries.size(); entryIndex++) {
+        const auto &[entryName, content] = entries[entryIndex];
+        std::shared_ptr<Stream::DataReadStream> memoryStream = Stream::MemoryReadStream::CopyOf(
+                reinterpret_cast<const uint8_t *>(content.data()),
+                content.size()
+        );
+        writeArchive.defineEntryFromUncompressedStream(entryIndex, entryName, memoryStream);
+    }
+    writeArchive.close();
+}
+
+static std::string ReadEntry(Dpac::ReadOnlyArchive &archive, const std::string &entryName) {
+    std::string content(archive.getUncompressedEntrySize(entryName), '\0');
+    auto stream = archive.getEntryStream(entryName);
+    stream->read(reinterpret_cast<uint8_t *>(content.data()), content.size());
+    return content;
+}
+
+TEST(DpacPatch, CreateAndApplyPatchTest) {
+    std::string unchangedContent = "This entry is the same in both archives";
+    std::string oldModifiedContent;
+    std::string newModifiedContent;
+    for (int i = 0; i < 1000; i++) {
+        oldModifiedContent += "Line " + std::to_string(i) + " of an entry which is modified in the new archive\n";
+        newModifiedContent += "Line " + std::to_string(i) + (i == 500 ? " was changed\n" : " of an entry which is modified in the new archive\n");
+    }
+    std::string addedContent = "This entry only exists in the new archive";
+
+    WriteArchive("DpacPatchTestOld.dpac", {
+            {"/unchanged.txt", unchangedContent},
+            {"/modified.txt",  oldModifiedContent},
+            {"/removed.txt",   "This entry only exists in the old archive"}
+    });
+    WriteArchive("DpacPatchTestNew.dpac", {
+            {"/unchanged.txt", unchangedContent},
+            {"/modified.txt",  newModifiedContent},
+            {"/added.txt",     addedContent}
+    });
+
+    Dpac::CreatePatch("DpacPatchTestOld.dpac", "DpacPatchTestNew.dpac", "DpacPatchTest.dpatch");
+    Dpac::ApplyPatch("DpacPatchTestOld.dpac", "DpacPatchTest.dpatch", "DpacPatchTestPatched.dpac");
+
+    Dpac::ReadOnlyArchive patchedArchive = Dpac::ReadOnlyArchive::Open("DpacPatchTestPatched.dpac");
+    EXPECT_EQ(3, patchedArchive.getFileContentOffsetTable().size());
+    EXPECT_EQ(unchangedContent, ReadEntry(patchedArchive, "/unchanged.txt"));
+    EXPECT_EQ(newModifiedContent, ReadEntry(patchedArchive, "/modified.txt"));
+    EXPECT_EQ(addedContent, ReadEntry(patchedArchive, "/added.txt"));
+    EXPECT_EQ(0, patchedArchive.getFileContentOffsetTable().count("/removed.txt"));
+}
+
+TEST(DpacPatch, ApplyPatchToDifferentArchiveTest) {
+    WriteArchive("DpacPatchTestOriginal.dpac", {{"/unchanged.txt", "Original content"}});
+    WriteArchive("DpacPatchTestTarget.dpac", {
+            {"/unchanged.txt", "Original content"},
+            {"/added.txt",     "Added content"}
+    });
+    // Same entry with the same size but different content
+    WriteArchive("DpacPatchTestDifferent.dpac", {{"/unchanged.txt", "Modified content"}});
+
+    Dpac::CreatePatch("DpacPatchTestOriginal.dpac", "DpacPatchTestTarget.dpac", "DpacPatchTestCopy.dpatch");
+    EXPECT_THROW(Dpac::ApplyPatch("DpacPatchTestDifferent.dpac", "DpacPatchTestCopy.dpatch",
+                                  "DpacPatchTestCopyPatched.dpac"),
+                 Dpac::PatchInvalidException);
+
+    Dpac::ApplyPatch("DpacPatchTestOriginal.dpac", "DpacPatchTestCopy.dpatch", "DpacPatchTestCopyPatched.dpac");
+    Dpac::ReadOnlyArchive patchedArchive = Dpac::ReadOnlyArchive::Open("DpacPatchTestCopyPatched.dpac");
+    EXPECT_EQ("Original content", ReadEntry(patchedArchive, "/unchanged.txt"));
+    EXPECT_EQ("Added content", ReadEntry(patchedArchive, "/added.txt"));
+}
@@ -1,7 +1,9 @@
 #include <iostream>
+#include <iomanip>
 #include <filesystem>
 #include <map>
 #include <Dpac/Dpac.hpp>
+#include <Stream/HashingDataStream.hpp>
 #include <Utils/FileUtils.hpp>
 
 #define DPAC_FILE_SEPARATOR '/'
@@ -43,8 +45,11 @@ static int run(int argc, char **argv) {
         if (relativePath.empty()) {
             continue;
         }
-        std::shared_ptr<Stream::FileDataReadStream> fileStream = Stream::FileDataReadStream::Open(filePath);
-        archive.defineEntryFromUncompressedStream(entryIndex, relativePath, fileStream);
+        // The file is hashed in the same pass that compresses it
+        auto hashingStream = std::make_shared<Stream::HashingReadStream>(Stream::FileDataReadStream::Open(filePath));
+        archive.defineEntryFromUncompressedStream(entryIndex, relativePath, hashingStream);
+        std::cout << std::hex << std::setw(16) << std::setfill('0') << hashingStream->getHash() << std::dec
+                  << "  " << hashingStream->getPosition() << "  " << relativePath << std::endl;
     }
 
     return 0;
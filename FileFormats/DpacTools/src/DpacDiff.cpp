@@ -0,0 +1,25 @@
+#include <iostream>
+#include <Dpac/DpacPatch.hpp>
+
+static int run(int argc, char **argv) {
+    if (argc != 4) {
+        std::cerr << "Usage: dpac_diff <old_dpac_file> <new_dpac_file> <patch_file>" << std::endl;
+        return 1;
+    }
+
+    std::string oldArchivePath = argv[1];
+    std::string newArchivePath = argv[2];
+    std::string patchFilePath = argv[3];
+
+    Dpac::CreatePatch(oldArchivePath, newArchivePath, patchFilePath);
+
+    return 0;
+}
+
+int main(int argc, char **argv) {
+    try {
+        return run(argc, argv);
+    } catch (const std::exception &e) {
+        std::cerr << e.what() << std::endl;
+    }
+}
@@ -0,0 +1,25 @@
+#include <iostream>
+#include <Dpac/DpacPatch.hpp>
+
+static int run(int argc, char **argv) {
+    if (argc != 4) {
+        std::cerr << "Usage: dpac_patch <old_dpac_file> <patch_file> <new_dpac_file>" << std::endl;
+        return 1;
+    }
+
+    std::string oldArchivePath = argv[1];
+    std::string patchFilePath = argv[2];
+    std::string newArchivePath = argv[3];
+
+    Dpac::ApplyPatch(oldArchivePath, patchFilePath, newArchivePath);
+
+    return 0;
+}
+
+int main(int argc, char **argv) {
+    try {
+        return run(argc, argv);
+    } catch (const std::exception &e) {
+        std::cerr << e.what() << std::endl;
+    }
+}
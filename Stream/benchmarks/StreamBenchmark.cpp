@@ -0,0 +1,393 @@
+#include <benchmark/benchmark.h>
+#include <Stream/MemoryDataStream.hpp>
+#include <Stream/FileDataReadStream.hpp>
+#include <Stream/FileDataWriteStream.hpp>
+#include <Stream/ZstdDeflateStream.hpp>
+#include <Stream/ZstdInflateStream.hpp>
+#include <Stream/PrefetchingReadStream.hpp>
+#include <Stream/Record.hpp>
+#include <map>
+#include <random>
+
+// Length of the strings in the string payloads
+#define BENCHMARK_STRING_LENGTH 32
+
+enum class StreamKind {
+    MEMORY,
+    FILE,
+    ZSTD,
+    // Zstd stream, whose compressed source is read ahead on a background thread
+    PREFETCHED_ZSTD
+};
+
+enum class PayloadKind {
+    BYTES,
+    STRINGS
+};
+
+struct Payload {
+    std::vector<uint8_t> content;
+    std::string filePath;
+    std::string compressedFilePath;
+};
+
+static std::vector<uint8_t> MakeContent(PayloadKind kind, size_t size) {
+    std::mt19937 random(42);
+    // A small alphabet, so that the content compresses about as well as typical asset data
+    std::uniform_int_distribution<int> distribution(0, 15);
+    std::vector<uint8_t> content;
+    content.reserve(size);
+    if (kind == PayloadKind::BYTES) {
+        while (content.size() < size) {
+            content.push_back(static_cast<uint8_t>('a' + distribution(random)));
+        }
+        return content;
+    }
+    // Strings as written by DataWriteStream::writeString: 64-bit length followed by the characters
+    while (content.size() + sizeof(uint64_t) + BENCHMARK_STRING_LENGTH <= size) {
+        for (int shift = 56; shift >= 0; shift -= 8) {
+            content.push_back(static_cast<uint8_t>((static_cast<uint64_t>(BENCHMARK_STRING_LENGTH) >> shift) & 0xFF));
+        }
+        for (int i = 0; i < BENCHMARK_STRING_LENGTH; i++) {
+            content.push_back(static_cast<uint8_t>('a' + distribution(random)));
+        }
+    }
+    return content;
+}
+
+// Payloads are generated once per kind and size and shared by all benchmarks
+static const Payload &GetPayload(PayloadKind kind, size_t size) {
+    static std::map<std::pair<PayloadKind, size_t>, Payload> payloads;
+    auto it = payloads.find({kind, size});
+    if (it != payloads.end()) {
+        return it->second;
+    }
+
+    Payload payload;
+    payload.content = MakeContent(kind, size);
+    std::string baseName = std::string("StreamBenchmark_") + (kind == PayloadKind::BYTES ? "bytes_" : "strings_") +
+                           std::to_string(size);
+    payload.filePath = baseName + ".bin";
+    payload.compressedFilePath = baseName + ".zst";
+    {
+        auto fileStream = Stream::FileDataWriteStream::Open(payload.filePath);
+        fileStream->writeBuffer(payload.content.data(), payload.content.size());
+    }
+    {
+        std::shared_ptr<Stream::FileDataWriteStream> compressedFileStream =
+                Stream::FileDataWriteStream::Open(payload.compressedFilePath);
+        std::shared_ptr<Stream::DataReadStream> fileStream = Stream::FileDataReadStream::Open(payload.filePath);
+        Stream::ZstdDeflateStream deflateStream(compressedFileStream);
+        deflateStream.writeStreamContents(fileStream);
+    }
+    return payloads.emplace(std::make_pair(kind, size), std::move(payload)).first->second;
+}
+
+/**
+ * Provides a stream of the given kind over a payload, which is rewound before every benchmark iteration.
+ * Seekable streams are opened once, so that only reading is measured.
+ * Zstd streams can not seek and are reopened every iteration.
+ */
+class PayloadReader {
+
+    StreamKind kind;
+    const Payload &payload;
+    std::unique_ptr<Stream::DataReadStream> stream;
+
+public:
+    PayloadReader(StreamKind kind, const Payload &payload) : kind(kind), payload(payload) {
+    }
+
+    Stream::DataReadStream &rewind() {
+        if (stream != nullptr && kind != StreamKind::ZSTD && kind != StreamKind::PREFETCHED_ZSTD) {
+            stream->seek(0);
+            return *stream;
+        }
+        switch (kind) {
+            case StreamKind::MEMORY:
+                stream = Stream::MemoryReadStream::CopyOf(payload.content.data(), payload.content.size());
+                break;
+            case StreamKind::FILE:
+                stream = Stream::FileDataReadStream::Open(payload.filePath);
+                break;
+            case StreamKind::ZSTD:
+                stream = std::make_unique<Stream::ZstdInflateStream>(
+                        Stream::FileDataReadStream::Open(payload.compressedFilePath),
+                        payload.content.size()
+                );
+                break;
+            case StreamKind::PREFETCHED_ZSTD:
+                stream = std::make_unique<Stream::ZstdInflateStream>(
+                        std::make_shared<Stream::PrefetchingReadStream>(
+                                Stream::FileDataReadStream::Open(payload.compressedFilePath)),
+                        payload.content.size()
+                );
+                break;
+        }
+        return *stream;
+    }
+};
+
+template<StreamKind kind>
+static void BM_ReadUint8(benchmark::State &state) {
+    const Payload &payload = GetPayload(PayloadKind::BYTES, static_cast<size_t>(state.range(0)));
+    PayloadReader reader(kind, payload);
+    size_t nValues = payload.content.size();
+    for (auto _: state) {
+        Stream::DataReadStream &stream = reader.rewind();
+        for (size_t i = 0; i < nValues; i++) {
+            benchmark::DoNotOptimize(stream.readUint8());
+        }
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * payload.content.size()));
+}
+
+template<StreamKind kind>
+static void BM_ReadUint32(benchmark::State &state) {
+    const Payload &payload = GetPayload(PayloadKind::BYTES, static_cast<size_t>(state.range(0)));
+    PayloadReader reader(kind, payload);
+    size_t nValues = payload.content.size() / sizeof(uint32_t);
+    for (auto _: state) {
+        Stream::DataReadStream &stream = reader.rewind();
+        for (size_t i = 0; i < nValues; i++) {
+            benchmark::DoNotOptimize(stream.readUint32());
+        }
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * nValues * sizeof(uint32_t)));
+}
+
+template<StreamKind kind>
+static void BM_ReadFloat32(benchmark::State &state) {
+    const Payload &payload = GetPayload(PayloadKind::BYTES, static_cast<size_t>(state.range(0)));
+    PayloadReader reader(kind, payload);
+    size_t nValues = payload.content.size() / sizeof(float);
+    for (auto _: state) {
+        Stream::DataReadStream &stream = reader.rewind();
+        for (size_t i = 0; i < nValues; i++) {
+            benchmark::DoNotOptimize(stream.readFloat32());
+        }
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * nValues * sizeof(float)));
+}
+
+template<StreamKind kind>
+static void BM_ReadFloat32Array(benchmark::State &state) {
+    const Payload &payload = GetPayload(PayloadKind::BYTES, static_cast<size_t>(state.range(0)));
+    PayloadReader reader(kind, payload);
+    std::vector<float> values(payload.content.size() / sizeof(float));
+    for (auto _: state) {
+        Stream::DataReadStream &stream = reader.rewind();
+        stream.readFloat32Array(values.data(), values.size());
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * values.size() * sizeof(float)));
+}
+
+// Records shaped like a DAsset buffer view
+#define BENCHMARK_RECORD_FIELDS int64_t, int64_t, int64_t, int8_t, int8_t, int64_t
+
+template<StreamKind kind>
+static void BM_ReadRecordFields(benchmark::State &state) {
+    const Payload &payload = GetPayload(PayloadKind::BYTES, static_cast<size_t>(state.range(0)));
+    PayloadReader reader(kind, payload);
+    size_t nRecords = payload.content.size() / Stream::RecordSize<BENCHMARK_RECORD_FIELDS>();
+    for (auto _: state) {
+        Stream::DataReadStream &stream = reader.rewind();
+        for (size_t i = 0; i < nRecords; i++) {
+            benchmark::DoNotOptimize(stream.readInt64());
+            benchmark::DoNotOptimize(stream.readInt64());
+            benchmark::DoNotOptimize(stream.readInt64());
+            benchmark::DoNotOptimize(stream.readInt8());
+            benchmark::DoNotOptimize(stream.readInt8());
+            benchmark::DoNotOptimize(stream.readInt64());
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * nRecords));
+}
+
+template<StreamKind kind>
+static void BM_ReadRecord(benchmark::State &state) {
+    const Payload &payload = GetPayload(PayloadKind::BYTES, static_cast<size_t>(state.range(0)));
+    PayloadReader reader(kind, payload);
+    size_t nRecords = payload.content.size() / Stream::RecordSize<BENCHMARK_RECORD_FIELDS>();
+    for (auto _: state) {
+        Stream::DataReadStream &stream = reader.rewind();
+        for (size_t i = 0; i < nRecords; i++) {
+            benchmark::DoNotOptimize(Stream::ReadRecord<BENCHMARK_RECORD_FIELDS>(stream));
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * nRecords));
+}
+
+template<StreamKind kind>
+static void BM_ReadString(benchmark::State &state) {
+    const Payload &payload = GetPayload(PayloadKind::STRINGS, static_cast<size_t>(state.range(0)));
+    PayloadReader reader(kind, payload);
+    size_t nValues = payload.content.size() / (sizeof(uint64_t) + BENCHMARK_STRING_LENGTH);
+    for (auto _: state) {
+        Stream::DataReadStream &stream = reader.rewind();
+        for (size_t i = 0; i < nValues; i++) {
+            benchmark::DoNotOptimize(stream.readString());
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * nValues));
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * payload.content.size()));
+}
+
+template<StreamKind kind>
+static void BM_Read(benchmark::State &state) {
+    const Payload &payload = GetPayload(PayloadKind::BYTES, static_cast<size_t>(state.range(0)));
+    PayloadReader reader(kind, payload);
+    std::vector<uint8_t> buffer(payload.content.size());
+    for (auto _: state) {
+        Stream::DataReadStream &stream = reader.rewind();
+        benchmark::DoNotOptimize(stream.read(buffer.data(), buffer.size()));
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * payload.content.size()));
+}
+
+static void BM_FileWriteBuffer(benchmark::State &state) {
+    const Payload &payload = GetPayload(PayloadKind::BYTES, static_cast<size_t>(state.range(0)));
+    auto fileStream = Stream::FileDataWriteStream::Open("StreamBenchmark_write.bin");
+    for (auto _: state) {
+        fileStream->seek(0);
+        fileStream->writeBuffer(payload.content.data(), payload.content.size());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * payload.content.size()));
+}
+
+static void BM_FileWriteUint32(benchmark::State &state) {
+    const Payload &payload = GetPayload(PayloadKind::BYTES, static_cast<size_t>(state.range(0)));
+    size_t nValues = payload.content.size() / sizeof(uint32_t);
+    auto fileStream = Stream::FileDataWriteStream::Open("StreamBenchmark_write.bin");
+    for (auto _: state) {
+        fileStream->seek(0);
+        for (size_t i = 0; i < nValues; i++) {
+            fileStream->writeUint32(static_cast<uint32_t>(i));
+        }
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * nValues * sizeof(uint32_t)));
+}
+
+static void BM_MemoryWriteBuffer(benchmark::State &state) {
+    const Payload &payload = GetPayload(PayloadKind::BYTES, static_cast<size_t>(state.range(0)));
+    for (auto _: state) {
+        auto memoryStream = Stream::MemoryWriteStream::Growable();
+        memoryStream->writeBuffer(payload.content.data(), payload.content.size());
+        benchmark::DoNotOptimize(memoryStream->releaseBuffer());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * payload.content.size()));
+}
+
+static void BM_MemoryWriteUint32(benchmark::State &state) {
+    const Payload &payload = GetPayload(PayloadKind::BYTES, static_cast<size_t>(state.range(0)));
+    size_t nValues = payload.content.size() / sizeof(uint32_t);
+    for (auto _: state) {
+        auto memoryStream = Stream::MemoryWriteStream::Growable();
+        for (size_t i = 0; i < nValues; i++) {
+            memoryStream->writeUint32(static_cast<uint32_t>(i));
+        }
+        benchmark::DoNotOptimize(memoryStream->releaseBuffer());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * nValues * sizeof(uint32_t)));
+}
+
+static void BM_MemoryWriteFloat32(benchmark::State &state) {
+    std::vector<float> values(static_cast<size_t>(state.range(0)) / sizeof(float), 1.5f);
+    for (auto _: state) {
+        auto memoryStream = Stream::MemoryWriteStream::Growable(values.size() * sizeof(float));
+        for (float value: values) {
+            memoryStream->writeFloat32(value);
+        }
+        benchmark::DoNotOptimize(memoryStream->releaseBuffer());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * values.size() * sizeof(float)));
+}
+
+static void BM_MemoryWriteFloat32Array(benchmark::State &state) {
+    std::vector<float> values(static_cast<size_t>(state.range(0)) / sizeof(float), 1.5f);
+    for (auto _: state) {
+        auto memoryStream = Stream::MemoryWriteStream::Growable(values.size() * sizeof(float));
+        memoryStream->writeFloat32Array(values.data(), values.size());
+        benchmark::DoNotOptimize(memoryStream->releaseBuffer());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * values.size() * sizeof(float)));
+}
+
+static void BM_FileWriteFloat32Array(benchmark::State &state) {
+    std::vector<float> values(static_cast<size_t>(state.range(0)) / sizeof(float), 1.5f);
+    auto fileStream = Stream::FileDataWriteStream::Open("StreamBenchmark_write.bin");
+    for (auto _: state) {
+        fileStream->seek(0);
+        fileStream->writeFloat32Array(values.data(), values.size());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * values.size() * sizeof(float)));
+}
+
+static void BM_ZstdDeflateWriteStreamContents(benchmark::State &state) {
+    const Payload &payload = GetPayload(PayloadKind::BYTES, static_cast<size_t>(state.range(0)));
+    std::shared_ptr<Stream::FileDataWriteStream> compressedFileStream =
+            Stream::FileDataWriteStream::Open("StreamBenchmark_write.zst");
+    for (auto _: state) {
+        compressedFileStream->seek(0);
+        std::shared_ptr<Stream::DataReadStream> fileStream = Stream::FileDataReadStream::Open(payload.filePath);
+        Stream::ZstdDeflateStream deflateStream(compressedFileStream);
+        benchmark::DoNotOptimize(deflateStream.writeStreamContents(fileStream));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * payload.content.size()));
+}
+
+// 4 KiB, 64 KiB, 1 MiB and 16 MiB payloads
+static void PayloadSizes(benchmark::internal::Benchmark *benchmark) {
+    benchmark->RangeMultiplier(16)->Range(1 << 12, 1 << 24)->Unit(benchmark::kMicrosecond);
+}
+
+BENCHMARK_TEMPLATE(BM_ReadUint8, StreamKind::MEMORY)->Apply(PayloadSizes);
+BENCHMARK_TEMPLATE(BM_ReadUint8, StreamKind::FILE)->Apply(PayloadSizes);
+BENCHMARK_TEMPLATE(BM_ReadUint8, StreamKind::ZSTD)->Apply(PayloadSizes);
+
+BENCHMARK_TEMPLATE(BM_ReadUint32, StreamKind::MEMORY)->Apply(PayloadSizes);
+BENCHMARK_TEMPLATE(BM_ReadUint32, StreamKind::FILE)->Apply(PayloadSizes);
+BENCHMARK_TEMPLATE(BM_ReadUint32, StreamKind::ZSTD)->Apply(PayloadSizes);
+
+BENCHMARK_TEMPLATE(BM_ReadFloat32, StreamKind::MEMORY)->Apply(PayloadSizes);
+BENCHMARK_TEMPLATE(BM_ReadFloat32, StreamKind::FILE)->Apply(PayloadSizes);
+BENCHMARK_TEMPLATE(BM_ReadFloat32, StreamKind::ZSTD)->Apply(PayloadSizes);
+
+BENCHMARK_TEMPLATE(BM_ReadFloat32Array, StreamKind::MEMORY)->Apply(PayloadSizes);
+BENCHMARK_TEMPLATE(BM_ReadFloat32Array, StreamKind::FILE)->Apply(PayloadSizes);
+BENCHMARK_TEMPLATE(BM_ReadFloat32Array, StreamKind::ZSTD)->Apply(PayloadSizes);
+
+BENCHMARK_TEMPLATE(BM_ReadRecordFields, StreamKind::MEMORY)->Apply(PayloadSizes);
+BENCHMARK_TEMPLATE(BM_ReadRecordFields, StreamKind::FILE)->Apply(PayloadSizes);
+BENCHMARK_TEMPLATE(BM_ReadRecord, StreamKind::MEMORY)->Apply(PayloadSizes);
+BENCHMARK_TEMPLATE(BM_ReadRecord, StreamKind::FILE)->Apply(PayloadSizes);
+
+BENCHMARK_TEMPLATE(BM_ReadString, StreamKind::MEMORY)->Apply(PayloadSizes);
+BENCHMARK_TEMPLATE(BM_ReadString, StreamKind::FILE)->Apply(PayloadSizes);
+BENCHMARK_TEMPLATE(BM_ReadString, StreamKind::ZSTD)->Apply(PayloadSizes);
+BENCHMARK_TEMPLATE(BM_ReadString, StreamKind::PREFETCHED_ZSTD)->Apply(PayloadSizes);
+
+BENCHMARK_TEMPLATE(BM_Read, StreamKind::MEMORY)->Apply(PayloadSizes);
+BENCHMARK_TEMPLATE(BM_Read, StreamKind::FILE)->Apply(PayloadSizes);
+BENCHMARK_TEMPLATE(BM_Read, StreamKind::ZSTD)->Apply(PayloadSizes);
+BENCHMARK_TEMPLATE(BM_Read, StreamKind::PREFETCHED_ZSTD)->Apply(PayloadSizes);
+
+BENCHMARK(BM_FileWriteBuffer)->Apply(PayloadSizes);
+BENCHMARK(BM_FileWriteUint32)->Apply(PayloadSizes);
+BENCHMARK(BM_MemoryWriteBuffer)->Apply(PayloadSizes);
+BENCHMARK(BM_MemoryWriteUint32)->Apply(PayloadSizes);
+BENCHMARK(BM_MemoryWriteFloat32)->Apply(PayloadSizes);
+BENCHMARK(BM_MemoryWriteFloat32Array)->Apply(PayloadSizes);
+BENCHMARK(BM_FileWriteFloat32Array)->Apply(PayloadSizes);
+BENCHMARK(BM_ZstdDeflateWriteStreamContents)->Apply(PayloadSizes);
+
+// 10M floats, one value at a time versus as array
+static const int64_t TEN_MILLION_FLOATS = 10000000 * sizeof(float);
+BENCHMARK_TEMPLATE(BM_ReadFloat32, StreamKind::MEMORY)->Arg(TEN_MILLION_FLOATS)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_ReadFloat32Array, StreamKind::MEMORY)->Arg(TEN_MILLION_FLOATS)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_ReadFloat32, StreamKind::FILE)->Arg(TEN_MILLION_FLOATS)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_ReadFloat32Array, StreamKind::FILE)->Arg(TEN_MILLION_FLOATS)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_MemoryWriteFloat32)->Arg(TEN_MILLION_FLOATS)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_MemoryWriteFloat32Array)->Arg(TEN_MILLION_FLOATS)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <Stream/ByteOrder.hpp>
+#include <cstdint>
+#include <cstddef>
+
+namespace Stream {
+
+    /**
+     * Reverses the bytes of 16-bit values.
+     * Uses AVX2 or SSSE3 byte shuffles if the CPU supports them.
+     * @param source the values to convert
+     * @param destination the memory to write the converted values to, may be the same as source
+     * @param n the number of values
+     */
+    void SwapBytes16(const uint8_t *source, uint8_t *destination, size_t n);
+
+    /**
+     * Reverses the bytes of 32-bit values.
+     * Uses AVX2 or SSSE3 byte shuffles if the CPU supports them.
+     * @param source the values to convert
+     * @param destination the memory to write the converted values to, may be the same as source
+     * @param n the number of values
+     */
+    void SwapBytes32(const uint8_t *source, uint8_t *destination, size_t n);
+
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <Stream/BatchReader.hpp>
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#define DYNGINE_STREAM_IO_URING 1
+#endif
+
+#ifdef DYNGINE_STREAM_IO_URING
+
+struct io_uring_sqe;
+struct io_uring_cqe;
+
+namespace Stream {
+
+    /**
+     * Submits all reads of a batch to the kernel at once with io_uring.
+     * Talks to the kernel through the raw system calls, so that it does not depend on liburing.
+     */
+    class IoUringBatchReader : public BatchReader {
+
+    private:
+        std::string filePath;
+        int fileDescriptor = -1;
+        int ringFileDescriptor = -1;
+
+        void *submissionRing = nullptr;
+        size_t submissionRingSize{};
+        void *completionRing = nullptr;
+        size_t completionRingSize{};
+        io_uring_sqe *submissionEntries = nullptr;
+        size_t submissionEntriesSize{};
+
+        unsigned *submissionHead{};
+        unsigned *submissionTail{};
+        unsigned *submissionMask{};
+        unsigned *submissionArray{};
+        unsigned *completionHead{};
+        unsigned *completionTail{};
+        unsigned *completionMask{};
+        io_uring_cqe *completionEntries{};
+        unsigned nEntries{};
+
+        IoUringBatchReader() = default;
+
+        /**
+         * Also called when reads in flight can't be waited for, after which the reader raises on every read
+         */
+        void close();
+
+    public:
+        ~IoUringBatchReader() override;
+
+        /**
+         * @return the reader, or nullptr if the kernel does not support io_uring or it is not permitted
+         * @throws BatchReaderOpenFailedException if the file can not be opened
+         */
+        static std::unique_ptr<IoUringBatchReader> TryOpen(const std::string &filePath);
+
+        void read(const std::vector<ReadRequest> &requests) override;
+
+        [[nodiscard]] BatchReaderBackend getBackend() const override;
+    };
+
+}
+
+#endif
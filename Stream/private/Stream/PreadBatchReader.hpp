@@ -0,0 +1,33 @@
+#pragma once
+
+#include <Stream/BatchReader.hpp>
+
+namespace Stream {
+
+    /**
+     * Spreads the reads of a batch over the workers of ParallelJobs, which each issue blocking positional reads
+     * (pread, or ReadFile with an offset on Windows)
+     */
+    class PreadBatchReader : public BatchReader {
+
+    private:
+        std::string filePath;
+#ifdef _WIN32
+        void *fileHandle; // HANDLE
+#else
+        int fileDescriptor;
+#endif
+
+        void readRange(const ReadRequest &request);
+
+    public:
+        explicit PreadBatchReader(const std::string &filePath);
+
+        ~PreadBatchReader() override;
+
+        void read(const std::vector<ReadRequest> &requests) override;
+
+        [[nodiscard]] BatchReaderBackend getBackend() const override;
+    };
+
+}
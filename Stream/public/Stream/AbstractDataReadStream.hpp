@@ -1,6 +1,7 @@
 #pragma once
 
 #include <Stream/DataReadStream.hpp>
+#include <Stream/StreamStatistics.hpp>
 #include <ErrorHandling/ErrorHandling.hpp>
 
 namespace Stream {
@@ -13,6 +14,11 @@ namespace Stream {
         uint64_t size;
         uint64_t startPosition;
         uint64_t position;
+        ByteOrder byteOrder = ByteOrder::BIG;
+        /**
+         * Counters of this stream, or nullptr if it is not instrumented
+         */
+        std::shared_ptr<StreamStatistics> statistics;
 
         explicit AbstractDataReadStream(uint64_t size, uint64_t position);
 
@@ -40,11 +46,44 @@ namespace Stream {
 
         size_t read(uint8_t *buffer, size_t bufferLength) override;
 
+        bool tryReadUint8(uint8_t &value) override;
+
+        bool tryReadInt8(int8_t &value) override;
+
+        bool tryReadUint16(uint16_t &value) override;
+
+        bool tryReadInt16(int16_t &value) override;
+
+        bool tryReadUint32(uint32_t &value) override;
+
+        bool tryReadInt32(int32_t &value) override;
+
+        bool tryReadUint64(uint64_t &value) override;
+
+        bool tryReadInt64(int64_t &value) override;
+
+        bool tryReadFloat32(float &value) override;
+
+        void readUint16Array(uint16_t *values, size_t n) override;
+
+        void readUint32Array(uint32_t *values, size_t n) override;
+
+        void readFloat32Array(float *values, size_t n) override;
+
         [[nodiscard]] bool hasRemaining() const override;
 
         [[nodiscard]] virtual uint64_t getLength() const override;
 
         [[nodiscard]] virtual uint64_t getPosition() const override;
+
+        void setByteOrder(ByteOrder newByteOrder) override;
+
+        [[nodiscard]] ByteOrder getByteOrder() const override;
+
+        /**
+         * @return the statistics of this stream, or nullptr if it is not instrumented
+         */
+        [[nodiscard]] const std::shared_ptr<StreamStatistics> &getStatistics() const;
     };
 
 }
\ No newline at end of file
@@ -13,9 +13,15 @@ namespace Stream {
         uint64_t size;
         uint64_t position;
         uint64_t startPosition;
+        ByteOrder byteOrder = ByteOrder::BIG;
 
         AbstractDataWriteStream(uint64_t size, uint64_t position);
 
+        /**
+         * Implements writeStreamContents by reading the stream in blocks, which are written with writeBuffer
+         */
+        std::pair<size_t, size_t> copyStreamContents(const std::shared_ptr<DataReadStream> &stream);
+
     public:
 
         void writeInt8(int8_t int8) override;
@@ -40,9 +46,19 @@ namespace Stream {
 
         void writeBuffer(const uint8_t *buffer, size_t size) override;
 
+        void writeUint16Array(const uint16_t *values, size_t n) override;
+
+        void writeUint32Array(const uint32_t *values, size_t n) override;
+
+        void writeFloat32Array(const float *values, size_t n) override;
+
         [[nodiscard]] uint64_t getPosition() const;
 
         [[nodiscard]] uint64_t getSize() const;
+
+        void setByteOrder(ByteOrder newByteOrder) override;
+
+        [[nodiscard]] ByteOrder getByteOrder() const override;
     };
 
 }
\ No newline at end of file
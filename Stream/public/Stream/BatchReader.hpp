@@ -0,0 +1,67 @@
+#pragma once
+
+#include <ErrorHandling/ErrorHandling.hpp>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Stream {
+
+    NEW_EXCEPTION_TYPE(BatchReaderOpenFailedException);
+
+    NEW_EXCEPTION_TYPE(BatchReadFailedException);
+
+    /**
+     * A range of a file, which is read into a buffer supplied by the caller
+     */
+    struct ReadRequest {
+        uint64_t offset;
+        size_t length;
+        uint8_t *buffer;
+    };
+
+    enum class BatchReaderBackend {
+        /**
+         * io_uring where the platform and kernel support it, PREAD otherwise
+         */
+        AUTO,
+        /**
+         * All reads of a batch are submitted to the kernel at once with io_uring (Linux only)
+         */
+        IO_URING,
+        /**
+         * The reads of a batch are spread over worker threads issuing blocking positional reads
+         */
+        PREAD
+    };
+
+    /**
+     * Reads many ranges of one file at once.
+     * Instead of issuing one blocking read after another, all reads of a batch are in flight at the same time,
+     * which lets the OS and the drive reorder and overlap them.
+     */
+    class BatchReader {
+
+    public:
+        virtual ~BatchReader() = default;
+
+        /**
+         * Reads all ranges into their buffers and returns once all of them are filled
+         * @throws BatchReadFailedException if a range could not be read completely
+         */
+        virtual void read(const std::vector<ReadRequest> &requests) = 0;
+
+        [[nodiscard]] virtual BatchReaderBackend getBackend() const = 0;
+
+        /**
+         * @param filePath the file to read from
+         * @param backend the backend to read with
+         * @throws BatchReaderOpenFailedException if the file can not be opened,
+         * or if the backend requested is not available
+         */
+        static std::unique_ptr<BatchReader> Open(const std::string &filePath,
+                                                 BatchReaderBackend backend = BatchReaderBackend::AUTO);
+    };
+
+}
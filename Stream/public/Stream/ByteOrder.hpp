@@ -0,0 +1,83 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+namespace Stream {
+
+    /**
+     * The order in which the bytes of multi-byte values are serialized.
+     * The values are stored in file headers and must not change.
+     */
+    enum class ByteOrder : uint8_t {
+        BIG = 0,
+        LITTLE = 1
+    };
+
+    /**
+     * @return the byte order of the host, which values are serialized in without conversion
+     */
+    constexpr ByteOrder HostByteOrder() {
+#if defined(__BYTE_ORDER__) && defined(__ORDER_BIG_ENDIAN__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        return ByteOrder::BIG;
+#else
+        // MSVC only targets little-endian platforms
+        return ByteOrder::LITTLE;
+#endif
+    }
+
+    /**
+     * Serializes a value in the specified byte order
+     */
+    template<typename T>
+    inline void StoreValue(uint8_t *destination, T value, ByteOrder byteOrder) {
+        memcpy(destination, &value, sizeof(T));
+        if (byteOrder != HostByteOrder()) {
+            std::reverse(destination, destination + sizeof(T));
+        }
+    }
+
+    /**
+     * Deserializes a value stored in the specified byte order
+     */
+    template<typename T>
+    inline T LoadValue(const uint8_t *source, ByteOrder byteOrder) {
+        uint8_t bytes[sizeof(T)];
+        memcpy(bytes, source, sizeof(T));
+        if (byteOrder != HostByteOrder()) {
+            std::reverse(bytes, bytes + sizeof(T));
+        }
+        T value;
+        memcpy(&value, bytes, sizeof(T));
+        return value;
+    }
+
+    /**
+     * Restores the byte order a stream had when the scope was entered once it is left, also when leaving by exception.
+     * Used by readers and writers of formats which switch the stream to the byte order stored in their header.
+     */
+    template<typename TStream>
+    class ByteOrderScope {
+
+    private:
+        TStream &stream;
+        ByteOrder previousByteOrder;
+
+    public:
+        explicit ByteOrderScope(TStream &stream) : stream(stream), previousByteOrder(stream.getByteOrder()) {}
+
+        ByteOrderScope(TStream &stream, ByteOrder byteOrder) : ByteOrderScope(stream) {
+            stream.setByteOrder(byteOrder);
+        }
+
+        ~ByteOrderScope() {
+            stream.setByteOrder(previousByteOrder);
+        }
+
+        ByteOrderScope(const ByteOrderScope &) = delete;
+
+        ByteOrderScope &operator=(const ByteOrderScope &) = delete;
+    };
+
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <Stream/AbstractDataReadStream.hpp>
+#include <memory>
+
+namespace Stream {
+
+    /**
+     * Counts the bytes read from its source while passing them on.
+     * Seeks are passed on to the source, they don't change the count.
+     */
+    class CountingReadStream : public AbstractDataReadStream {
+
+    private:
+        std::shared_ptr<DataReadStream> source;
+        uint64_t nBytesRead{};
+
+    public:
+        explicit CountingReadStream(std::shared_ptr<DataReadStream> source);
+
+        uint8_t readUint8() override;
+
+        size_t read(uint8_t *buffer, size_t bufferLength) override;
+
+        void seek(uint64_t position) override;
+
+        void skip(uint64_t offset) override;
+
+        [[nodiscard]] bool hasRemaining() const override;
+
+        /**
+         * @return the number of bytes read, regardless of seeks in between
+         */
+        [[nodiscard]] uint64_t getBytesRead() const;
+    };
+
+}
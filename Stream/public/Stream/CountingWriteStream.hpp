@@ -0,0 +1,40 @@
+#pragma once
+
+#include <Stream/AbstractDataWriteStream.hpp>
+#include <memory>
+
+namespace Stream {
+
+    /**
+     * Counts the bytes written to its sink while passing them on.
+     * Without a sink, the bytes are only counted, which measures the size of an output without producing it.
+     */
+    class CountingWriteStream : public AbstractDataWriteStream {
+
+    private:
+        std::shared_ptr<DataWriteStream> sink;
+        uint64_t nBytesWritten{};
+
+    public:
+        /**
+         * @param sink the stream to pass the bytes on to, or nullptr to discard them
+         */
+        explicit CountingWriteStream(std::shared_ptr<DataWriteStream> sink = nullptr);
+
+        void seek(uint64_t position) override;
+
+        void skip(uint64_t offset) override;
+
+        void writeUint8(uint8_t uint8) override;
+
+        void writeBuffer(const uint8_t *buffer, size_t size) override;
+
+        std::pair<size_t, size_t> writeStreamContents(const std::shared_ptr<Stream::DataReadStream> &stream) override;
+
+        /**
+         * @return the number of bytes written, regardless of seeks in between
+         */
+        [[nodiscard]] uint64_t getBytesWritten() const;
+    };
+
+}
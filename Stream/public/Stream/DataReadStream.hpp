@@ -1,5 +1,6 @@
 #pragma once
 
+#include <Stream/ByteOrder.hpp>
 #include <cstdint>
 #include <string>
 
@@ -38,6 +39,45 @@ namespace Stream {
 
         virtual size_t read(uint8_t *buffer, size_t bufferLength) = 0;
 
+        // Non-throwing read functions.
+        // They return false instead of raising when the stream ends before the value or fails to read it, like a
+        // decorated stream whose source is corrupt, and leave the value untouched in that case.
+        // The position of a stream that failed is unspecified.
+        [[nodiscard]] virtual bool tryReadUint8(uint8_t &value) = 0;
+
+        [[nodiscard]] virtual bool tryReadInt8(int8_t &value) = 0;
+
+        [[nodiscard]] virtual bool tryReadUint16(uint16_t &value) = 0;
+
+        [[nodiscard]] virtual bool tryReadInt16(int16_t &value) = 0;
+
+        [[nodiscard]] virtual bool tryReadUint32(uint32_t &value) = 0;
+
+        [[nodiscard]] virtual bool tryReadInt32(int32_t &value) = 0;
+
+        [[nodiscard]] virtual bool tryReadUint64(uint64_t &value) = 0;
+
+        [[nodiscard]] virtual bool tryReadInt64(int64_t &value) = 0;
+
+        [[nodiscard]] virtual bool tryReadFloat32(float &value) = 0;
+
+        /**
+         * Reads an array of big-endian values in bulk, converting them to host byte order.
+         * Equivalent to, but much faster than, calling readUint16 n times.
+         * @throws StreamUnderflowException if the stream ends before n values are read
+         */
+        virtual void readUint16Array(uint16_t *values, size_t n) = 0;
+
+        /**
+         * @copydoc readUint16Array
+         */
+        virtual void readUint32Array(uint32_t *values, size_t n) = 0;
+
+        /**
+         * @copydoc readUint16Array
+         */
+        virtual void readFloat32Array(float *values, size_t n) = 0;
+
         [[nodiscard]] virtual bool hasRemaining() const = 0;
 
         // Seek functions
@@ -48,6 +88,14 @@ namespace Stream {
         virtual uint64_t getPosition() const = 0;
 
         virtual uint64_t getLength() const = 0;
+
+        /**
+         * Sets the byte order multi-byte values are read in. Streams read big-endian by default.
+         * Reading in the byte order of the host needs no conversion.
+         */
+        virtual void setByteOrder(ByteOrder byteOrder) = 0;
+
+        [[nodiscard]] virtual ByteOrder getByteOrder() const = 0;
     };
 
 }
\ No newline at end of file
@@ -6,11 +6,13 @@
 
 namespace Stream {
 
+#define WRITE_BUFFER_SIZE 1048576
+
     class DataWriteStream {
 
     public:
 
-        ~DataWriteStream() = default;
+        virtual ~DataWriteStream() = default;
 
         virtual void seek(uint64_t position) = 0;
 
@@ -44,10 +46,34 @@ namespace Stream {
 
         virtual void writeBuffer(const uint8_t *buffer, size_t size) = 0;
 
+        /**
+         * Writes an array of values in big-endian byte order in bulk.
+         * Equivalent to, but much faster than, calling writeUint16 n times.
+         */
+        virtual void writeUint16Array(const uint16_t *values, size_t n) = 0;
+
+        /**
+         * @copydoc writeUint16Array
+         */
+        virtual void writeUint32Array(const uint32_t *values, size_t n) = 0;
+
+        /**
+         * @copydoc writeUint16Array
+         */
+        virtual void writeFloat32Array(const float *values, size_t n) = 0;
+
         virtual void writeString(const std::string &string) = 0;
 
         virtual void writeFixedString(const std::string &string, size_t fixedLength) = 0;
 
+        /**
+         * Sets the byte order multi-byte values are written in. Streams write big-endian by default.
+         * Writing in the byte order of the host needs no conversion.
+         */
+        virtual void setByteOrder(ByteOrder byteOrder) = 0;
+
+        [[nodiscard]] virtual ByteOrder getByteOrder() const = 0;
+
     };
 
 }
\ No newline at end of file
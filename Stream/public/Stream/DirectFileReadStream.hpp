@@ -0,0 +1,85 @@
+#pragma once
+
+#include <Stream/AbstractDataReadStream.hpp>
+#include <ErrorHandling/ErrorHandling.hpp>
+#include <string>
+
+namespace Stream {
+
+// O_DIRECT needs the file offset, the length and the memory of a read aligned to the logical block size
+// of the device, which is at most 4096 bytes on the drives we read from
+#define DIRECT_READ_ALIGNMENT 4096
+#define DIRECT_READ_BUFFER_SIZE 1048576
+
+    NEW_EXCEPTION_TYPE(DirectFileReadStreamOpenFailedException);
+
+    NEW_EXCEPTION_TYPE(DirectFileReadFailedException);
+
+    /**
+     * Reads a file once from front to back without filling the page cache, so that ingesting large archives
+     * does not evict everything else the process has cached.
+     * The file is opened with O_DIRECT (FILE_FLAG_NO_BUFFERING on Windows, F_NOCACHE on macOS) and read through
+     * an aligned buffer, so that any position and length can be read.
+     * Where the file system does not support direct I/O, the file is read buffered instead,
+     * and the pages already read are dropped from the cache with POSIX_FADV_DONTNEED.
+     */
+    class DirectFileReadStream : public AbstractDataReadStream {
+
+    private:
+        std::string filePath;
+#ifdef _WIN32
+        void *fileHandle; // HANDLE
+#else
+        int fileDescriptor;
+#endif
+        bool direct{};
+        uint8_t *buffer;
+        /**
+         * The aligned file offset the buffer starts at
+         */
+        uint64_t bufferOffset{};
+        size_t bufferLength{};
+
+        /**
+         * Reads the aligned block of the file containing the current position into the buffer
+         */
+        void fillBuffer();
+
+        /**
+         * Drops the file content in the buffer from the page cache, if it was read buffered
+         */
+        void releaseBufferedPages();
+
+    public:
+        /**
+         * @param filePath the file to read
+         * @param position the offset in the file the stream starts at
+         * @param size the length of the stream
+         */
+        DirectFileReadStream(const std::string &filePath, uint64_t position, uint64_t size);
+
+        explicit DirectFileReadStream(const std::string &filePath);
+
+        ~DirectFileReadStream() override;
+
+        static std::unique_ptr<DirectFileReadStream> Open(const std::string &filePath);
+
+        uint8_t readUint8() override;
+
+        size_t read(uint8_t *buffer, size_t bufferLength) override;
+
+        void seek(uint64_t position) override;
+
+        void skip(uint64_t offset) override;
+
+        [[nodiscard]] bool hasRemaining() const override;
+
+        [[nodiscard]] const std::string &getFilePath() const;
+
+        /**
+         * @return whether the file is read without the page cache, or buffered as a fallback
+         */
+        [[nodiscard]] bool isDirect() const;
+    };
+
+}
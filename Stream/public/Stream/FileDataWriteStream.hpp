@@ -3,6 +3,7 @@
 #include <Stream/AbstractDataWriteStream.hpp>
 #include <fstream>
 #include <string>
+#include <vector>
 
 namespace Stream {
 
@@ -13,6 +14,11 @@ namespace Stream {
     private:
         std::ofstream stream;
         std::string filePath;
+        /**
+         * Written data, which has not been passed to the ofstream yet
+         */
+        std::vector<uint8_t> buffer;
+        size_t bufferLength{};
 
     public:
 
@@ -43,6 +49,17 @@ namespace Stream {
          */
         void writeUint8(uint8_t uint8) override;
 
+        /**
+         * Passes the buffered data to the file.
+         * This happens automatically when the buffer is full, on seek, skip and close.
+         * @throws StreamWriteException if writing to the file fails
+         */
+        void flush();
+
+        /**
+         * Flushes and closes the file.
+         * Errors during the final flush can only be reported by calling this before the stream is destroyed.
+         */
         void close();
 
         std::pair<size_t, size_t> writeStreamContents(const std::shared_ptr<DataReadStream> &stream) override;
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <Stream/AbstractDataReadStream.hpp>
+#include <Stream/AbstractDataWriteStream.hpp>
+#include <Stream/Xxh3.hpp>
+#include <memory>
+
+namespace Stream {
+
+    /**
+     * Hashes the bytes read from its source with XXH3 while passing them on,
+     * so that the content of a stream can be hashed in the same pass that consumes it.
+     * Seeking is not supported, as the hash covers the bytes in the order they were read.
+     */
+    class HashingReadStream : public AbstractDataReadStream {
+
+    private:
+        std::shared_ptr<DataReadStream> source;
+        Xxh3 hash;
+
+    public:
+        explicit HashingReadStream(std::shared_ptr<DataReadStream> source);
+
+        uint8_t readUint8() override;
+
+        size_t read(uint8_t *buffer, size_t bufferLength) override;
+
+        void seek(uint64_t position) override;
+
+        void skip(uint64_t offset) override;
+
+        [[nodiscard]] bool hasRemaining() const override;
+
+        /**
+         * @return the XXH3 hash of all bytes read so far
+         */
+        [[nodiscard]] uint64_t getHash() const;
+    };
+
+    /**
+     * Hashes the bytes written to its sink with XXH3 while passing them on.
+     * Seeking is not supported, as the hash covers the bytes in the order they were written.
+     */
+    class HashingWriteStream : public AbstractDataWriteStream {
+
+    private:
+        std::shared_ptr<DataWriteStream> sink;
+        Xxh3 hash;
+
+    public:
+        explicit HashingWriteStream(std::shared_ptr<DataWriteStream> sink);
+
+        void seek(uint64_t position) override;
+
+        void skip(uint64_t offset) override;
+
+        void writeUint8(uint8_t uint8) override;
+
+        void writeBuffer(const uint8_t *buffer, size_t size) override;
+
+        std::pair<size_t, size_t> writeStreamContents(const std::shared_ptr<Stream::DataReadStream> &stream) override;
+
+        /**
+         * @return the XXH3 hash of all bytes written so far
+         */
+        [[nodiscard]] uint64_t getHash() const;
+    };
+
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <Stream/AbstractDataReadStream.hpp>
+#include <Stream/AbstractDataWriteStream.hpp>
 #include <vector>
 #include <memory>
 
@@ -9,6 +10,7 @@ namespace Stream {
     class MemoryReadStream : public AbstractDataReadStream {
 
         const uint8_t *memory;
+        bool ownsMemory;
 
     public:
         /**
@@ -40,10 +42,129 @@ namespace Stream {
 
         uint8_t readUint8() override;
 
+        size_t read(uint8_t *buffer, size_t bufferLength) override;
+
+        void seek(uint64_t newPosition) override;
+
+        void skip(uint64_t offset) override;
+
+    };
+
+    /**
+     * Writes to memory, either to a buffer owned by the stream, which grows as needed,
+     * or to a fixed span of memory supplied by the caller.
+     * Multi-byte values and buffers are written directly to memory,
+     * without going through #writeUint8 for every byte.
+     */
+    class MemoryWriteStream : public AbstractDataWriteStream {
+
+        /**
+         * The owned buffer, unused if the stream writes to a fixed span.
+         * Its size is the capacity of the stream, not the number of bytes written.
+         */
+        std::vector<uint8_t> buffer;
+        uint8_t *memory;
+        size_t capacity;
+        bool fixed;
+        /**
+         * The number of bytes written, which is the highest position written to
+         */
+        uint64_t length{};
+
+        /**
+         * Makes room for the specified number of bytes at the current position,
+         * advances the position past them and returns a pointer to them.
+         * @throws StreamOverflowException if the stream writes to a fixed span, which is too small
+         */
+        uint8_t *allocate(size_t nBytes);
+
+        void ensureCapacity(uint64_t neededCapacity);
+
+    public:
+        /**
+         * Creates a stream, which writes to a buffer owned by the stream
+         * @param initialCapacity the number of bytes to reserve up front
+         */
+        explicit MemoryWriteStream(size_t initialCapacity = 0);
+
+        /**
+         * Creates a stream, which writes to the specified memory
+         * @param memory the memory to write to. It must be valid for the lifetime of the stream.
+         * @param size the size of the memory. Writing past it raises a StreamOverflowException.
+         */
+        MemoryWriteStream(uint8_t *memory, size_t size);
+
+        /**
+         * @param initialCapacity the number of bytes to reserve up front.
+         * The buffer grows geometrically once this is exceeded.
+         */
+        static std::unique_ptr<MemoryWriteStream> Growable(size_t initialCapacity = 0);
+
+        /**
+         * @param memory the memory to write to. The stream will use the memory directly.
+         * The memory must be valid for the lifetime of the stream.
+         * You are responsible for freeing the memory.
+         * @param size the size of the memory
+         */
+        static std::unique_ptr<MemoryWriteStream> Wrap(uint8_t *memory, size_t size);
+
+        /**
+         * Makes sure that the specified number of bytes can be written in total without reallocating
+         * @throws StreamOverflowException if the stream writes to a fixed span smaller than the capacity
+         */
+        void reserve(size_t newCapacity);
+
+        /**
+         * Moves the written bytes out of the stream. The stream is empty afterwards and can be reused.
+         * @throws errorhandling::IllegalStateException if the stream writes to a fixed span
+         */
+        std::vector<uint8_t> releaseBuffer();
+
+        /**
+         * @return the written bytes. The pointer is invalidated by writing to a growable stream.
+         */
+        [[nodiscard]] const uint8_t *getData() const;
+
+        /**
+         * @return the number of bytes written
+         */
+        [[nodiscard]] uint64_t getLength() const;
+
         void seek(uint64_t newPosition) override;
 
         void skip(uint64_t offset) override;
 
+        void writeUint8(uint8_t uint8) override;
+
+        void writeInt8(int8_t int8) override;
+
+        void writeUint16(uint16_t uint16) override;
+
+        void writeInt16(int16_t int16) override;
+
+        void writeUint32(uint32_t uint32) override;
+
+        void writeInt32(int32_t int32) override;
+
+        void writeUint64(uint64_t uint64) override;
+
+        void writeInt64(int64_t int64) override;
+
+        void writeFloat32(float f32) override;
+
+        void writeString(const std::string &string) override;
+
+        void writeFixedString(const std::string &string, size_t fixedLength) override;
+
+        void writeBuffer(const uint8_t *buffer, size_t size) override;
+
+        void writeUint16Array(const uint16_t *values, size_t n) override;
+
+        void writeUint32Array(const uint32_t *values, size_t n) override;
+
+        void writeFloat32Array(const float *values, size_t n) override;
+
+        std::pair<size_t, size_t> writeStreamContents(const std::shared_ptr<DataReadStream> &stream) override;
     };
 
 }
\ No newline at end of file
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <Stream/AbstractDataReadStream.hpp>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Stream {
+
+#define PREFETCH_DEFAULT_DEPTH 4
+#define PREFETCH_DEFAULT_CHUNK_SIZE 262144
+
+    /**
+     * Reads ahead of its consumer: a background thread reads the next chunks of the source into a ring of buffers,
+     * so that the latency of the source overlaps with the work done on the data read.
+     * The source must not be used by anyone else while it is wrapped.
+     */
+    class PrefetchingReadStream : public AbstractDataReadStream {
+
+    private:
+        std::shared_ptr<DataReadStream> source;
+        size_t chunkSize;
+        std::vector<std::vector<uint8_t>> chunks;
+        std::vector<size_t> chunkLengths;
+
+        // Owned by the consumer
+        size_t readChunkIndex{};
+        size_t readOffset{};
+
+        // Owned by the prefetching thread
+        size_t writeChunkIndex{};
+
+        // Guarded by mutex
+        size_t nFilledChunks{};
+        bool sourceExhausted{};
+        bool cancelled{};
+        std::exception_ptr sourceException;
+
+        mutable std::mutex mutex;
+        mutable std::condition_variable chunkFilled;
+        std::condition_variable chunkReleased;
+        std::thread prefetchThread;
+
+        void prefetch();
+
+        void start();
+
+        void stop();
+
+        /**
+         * Waits until the chunk at readChunkIndex is filled
+         * @return false, if the source ended instead
+         */
+        bool waitForChunk() const;
+
+        void releaseChunk();
+
+    public:
+        /**
+         * @param source the stream to read ahead of
+         * @param depth the number of chunks read ahead
+         * @param chunkSize the size of a single read from the source
+         */
+        explicit PrefetchingReadStream(std::shared_ptr<DataReadStream> source,
+                                       size_t depth = PREFETCH_DEFAULT_DEPTH,
+                                       size_t chunkSize = PREFETCH_DEFAULT_CHUNK_SIZE);
+
+        /**
+         * Cancels reading ahead and waits for the read of the source in progress, if any
+         */
+        ~PrefetchingReadStream() override;
+
+        uint8_t readUint8() override;
+
+        size_t read(uint8_t *buffer, size_t bufferLength) override;
+
+        /**
+         * Discards the chunks read ahead and continues reading ahead from the new position
+         */
+        void seek(uint64_t position) override;
+
+        void skip(uint64_t offset) override;
+
+        [[nodiscard]] bool hasRemaining() const override;
+
+    };
+
+}
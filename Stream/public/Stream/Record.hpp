@@ -0,0 +1,62 @@
+#pragma once
+
+#include <Stream/AbstractDataReadStream.hpp>
+#include <optional>
+#include <tuple>
+
+namespace Stream {
+
+    /**
+     * The size of a record of the given fields, which are stored back to back without padding
+     */
+    template<typename... Fields>
+    constexpr size_t RecordSize() {
+        return (sizeof(Fields) + ... + 0);
+    }
+
+    template<typename T>
+    inline T DecodeRecordField(const uint8_t *&field, ByteOrder byteOrder) {
+        T value = LoadValue<T>(field, byteOrder);
+        field += sizeof(T);
+        return value;
+    }
+
+    /**
+     * Decodes a record of the given fields from memory, without any checks
+     */
+    template<typename... Fields>
+    inline std::tuple<Fields...> DecodeRecord(const uint8_t *record, ByteOrder byteOrder) {
+        const uint8_t *field = record;
+        // The elements of a braced initializer list are evaluated in order
+        return std::tuple<Fields...>{DecodeRecordField<Fields>(field, byteOrder)...};
+    }
+
+    /**
+     * Reads a record of fixed size fields in the byte order of the stream.
+     * The remaining size of the stream is checked once for the whole record, with a single read call,
+     * after which the fields are decoded without any further checks.
+     * @return the fields, or std::nullopt if the stream ends before the end of the record
+     */
+    template<typename... Fields>
+    inline std::optional<std::tuple<Fields...>> TryReadRecord(DataReadStream &stream) {
+        uint8_t record[RecordSize<Fields...>()];
+        if (stream.read(record, sizeof(record)) != sizeof(record)) {
+            return std::nullopt;
+        }
+        return DecodeRecord<Fields...>(record, stream.getByteOrder());
+    }
+
+    /**
+     * Like #TryReadRecord, but raises instead
+     * @throws StreamUnderflowException if the stream ends before the end of the record
+     */
+    template<typename... Fields>
+    inline std::tuple<Fields...> ReadRecord(DataReadStream &stream) {
+        uint8_t record[RecordSize<Fields...>()];
+        if (stream.read(record, sizeof(record)) != sizeof(record)) {
+            RAISE_EXCEPTION(StreamUnderflowException, "Tried to read a record from an exhausted stream");
+        }
+        return DecodeRecord<Fields...>(record, stream.getByteOrder());
+    }
+
+}
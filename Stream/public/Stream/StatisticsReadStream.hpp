@@ -0,0 +1,88 @@
+#pragma once
+
+#include <Stream/AbstractDataReadStream.hpp>
+#include <memory>
+
+namespace Stream {
+
+    /**
+     * Counts the operations on its source and the bytes read through it into a registered StreamStatistics.
+     * Unlike the instrumentation of the DYNGINE_STREAM_STATISTICS option, it is always available,
+     * so that a single stream can be measured without rebuilding.
+     */
+    class StatisticsReadStream : public AbstractDataReadStream {
+
+    private:
+        std::shared_ptr<DataReadStream> source;
+
+    public:
+        /**
+         * @param source the stream to measure
+         * @param name the name the statistics are registered under
+         */
+        StatisticsReadStream(std::shared_ptr<DataReadStream> source, const std::string &name);
+
+        uint8_t readUint8() override;
+
+        int8_t readInt8() override;
+
+        uint16_t readUint16() override;
+
+        int16_t readInt16() override;
+
+        uint32_t readUint32() override;
+
+        int32_t readInt32() override;
+
+        uint64_t readUint64() override;
+
+        int64_t readInt64() override;
+
+        float readFloat32() override;
+
+        std::string readString() override;
+
+        std::string readFixedString(size_t length) override;
+
+        size_t read(uint8_t *buffer, size_t bufferLength) override;
+
+        bool tryReadUint8(uint8_t &value) override;
+
+        bool tryReadInt8(int8_t &value) override;
+
+        bool tryReadUint16(uint16_t &value) override;
+
+        bool tryReadInt16(int16_t &value) override;
+
+        bool tryReadUint32(uint32_t &value) override;
+
+        bool tryReadInt32(int32_t &value) override;
+
+        bool tryReadUint64(uint64_t &value) override;
+
+        bool tryReadInt64(int64_t &value) override;
+
+        bool tryReadFloat32(float &value) override;
+
+        void readUint16Array(uint16_t *values, size_t n) override;
+
+        void readUint32Array(uint32_t *values, size_t n) override;
+
+        void readFloat32Array(float *values, size_t n) override;
+
+        [[nodiscard]] bool hasRemaining() const override;
+
+        void seek(uint64_t position) override;
+
+        void skip(uint64_t offset) override;
+
+        [[nodiscard]] uint64_t getLength() const override;
+
+        [[nodiscard]] uint64_t getPosition() const override;
+
+        void setByteOrder(ByteOrder newByteOrder) override;
+
+        [[nodiscard]] ByteOrder getByteOrder() const override;
+    };
+
+}
@@ -0,0 +1,157 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace Stream {
+
+    /**
+     * The read operations counted by StreamStatistics
+     */
+    enum class StreamOperation : uint8_t {
+        UINT8,
+        INT8,
+        UINT16,
+        INT16,
+        UINT32,
+        INT32,
+        UINT64,
+        INT64,
+        FLOAT32,
+        STRING,
+        FIXED_STRING,
+        ARRAY,
+        READ,
+        COUNT
+    };
+
+    /**
+     * Counters of a single stream instance.
+     * They are atomic, so that the registry can be dumped while streams are in use on other threads.
+     */
+    struct StreamStatistics {
+        const std::string name;
+        std::atomic<uint64_t> bytesRead{};
+        std::array<std::atomic<uint64_t>, static_cast<size_t>(StreamOperation::COUNT)> calls{};
+        /**
+         * Reads from the underlying source, a file or the stream decompressed from
+         */
+        std::atomic<uint64_t> refills{};
+        std::atomic<uint64_t> seeks{};
+        std::atomic<uint64_t> sourceNanoseconds{};
+        std::atomic<uint64_t> decompressionNanoseconds{};
+
+        explicit StreamStatistics(std::string name);
+
+        /**
+         * Adds the counters to the totals the registry keeps for destroyed streams
+         */
+        ~StreamStatistics();
+
+        StreamStatistics(const StreamStatistics &) = delete;
+
+        StreamStatistics &operator=(const StreamStatistics &) = delete;
+
+        void count(StreamOperation operation) {
+            calls[static_cast<size_t>(operation)].fetch_add(1, std::memory_order_relaxed);
+        }
+
+        void countBytes(uint64_t nBytes) {
+            bytesRead.fetch_add(nBytes, std::memory_order_relaxed);
+        }
+    };
+
+    /**
+     * Keeps the statistics of all live instrumented streams and the totals of the destroyed ones,
+     * so that the totals of a whole load can be inspected at its end.
+     * Destroyed streams only add to the totals of their name, so short-lived streams don't grow the registry.
+     */
+    class StreamStatisticsRegistry {
+
+    public:
+        /**
+         * Creates the statistics for a new stream instance
+         * @param name the name the statistics are grouped by, usually the kind of stream
+         */
+        static std::shared_ptr<StreamStatistics> Register(const std::string &name);
+
+        /**
+         * @return the statistics of the streams that are still alive
+         */
+        static std::vector<std::shared_ptr<StreamStatistics>> GetAll();
+
+        /**
+         * Writes the totals of every group of streams with the same name, destroyed streams included
+         */
+        static void Dump(std::ostream &out);
+
+        /**
+         * Forgets all statistics registered so far
+         */
+        static void Reset();
+    };
+
+    /**
+     * Adds the time from its construction to its destruction to a counter in nanoseconds
+     */
+    class ScopedStreamTimer {
+
+    private:
+        std::atomic<uint64_t> *nanoseconds;
+        std::chrono::steady_clock::time_point start;
+
+    public:
+        /**
+         * @param nanoseconds the counter to add to, or nullptr to not measure anything
+         */
+        explicit ScopedStreamTimer(std::atomic<uint64_t> *nanoseconds) : nanoseconds(nanoseconds) {
+            if (nanoseconds != nullptr) {
+                start = std::chrono::steady_clock::now();
+            }
+        }
+
+        ~ScopedStreamTimer() {
+            if (nanoseconds != nullptr) {
+                auto elapsed = std::chrono::steady_clock::now() - start;
+                nanoseconds->fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count(),
+                                       std::memory_order_relaxed);
+            }
+        }
+
+        ScopedStreamTimer(const ScopedStreamTimer &) = delete;
+
+        ScopedStreamTimer &operator=(const ScopedStreamTimer &) = delete;
+    };
+
+}
+
+// Instrumentation compiled into the streams with the DYNGINE_STREAM_STATISTICS option.
+// The macros are used in the members of AbstractDataReadStream subclasses and count into their statistics,
+// if they registered any. Without the option, they expand to nothing.
+#ifdef DYNGINE_STREAM_STATISTICS
+#define STREAM_STATISTICS_REGISTER(name) statistics = Stream::StreamStatisticsRegistry::Register(name)
+#define STREAM_STATISTICS_COUNT(operation) \
+if (statistics) statistics->count(Stream::StreamOperation::operation)
+#define STREAM_STATISTICS_BYTES(nBytes) \
+if (statistics) statistics->countBytes(nBytes)
+// Counts a read of a single value with one check, for the per-byte reads
+#define STREAM_STATISTICS_COUNT_BYTES(operation, nBytes) \
+if (statistics) { statistics->count(Stream::StreamOperation::operation); statistics->countBytes(nBytes); }
+#define STREAM_STATISTICS_ADD(counter, n) \
+if (statistics) statistics->counter.fetch_add(n, std::memory_order_relaxed)
+#define STREAM_STATISTICS_TIME(counter) \
+Stream::ScopedStreamTimer counter##Timer(statistics ? &statistics->counter : nullptr)
+#else
+#define STREAM_STATISTICS_REGISTER(name)
+#define STREAM_STATISTICS_COUNT(operation)
+#define STREAM_STATISTICS_BYTES(nBytes)
+#define STREAM_STATISTICS_COUNT_BYTES(operation, nBytes)
+#define STREAM_STATISTICS_ADD(counter, n)
+#define STREAM_STATISTICS_TIME(counter)
+#endif
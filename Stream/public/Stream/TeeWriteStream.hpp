@@ -0,0 +1,32 @@
+#pragma once
+
+#include <Stream/AbstractDataWriteStream.hpp>
+#include <memory>
+
+namespace Stream {
+
+    /**
+     * Writes everything written to it to two sinks, eg. a file and a HashingWriteStream,
+     * so that the data is produced once instead of once per consumer.
+     */
+    class TeeWriteStream : public AbstractDataWriteStream {
+
+    private:
+        std::shared_ptr<DataWriteStream> first;
+        std::shared_ptr<DataWriteStream> second;
+
+    public:
+        TeeWriteStream(std::shared_ptr<DataWriteStream> first, std::shared_ptr<DataWriteStream> second);
+
+        void seek(uint64_t position) override;
+
+        void skip(uint64_t offset) override;
+
+        void writeUint8(uint8_t uint8) override;
+
+        void writeBuffer(const uint8_t *buffer, size_t size) override;
+
+        std::pair<size_t, size_t> writeStreamContents(const std::shared_ptr<Stream::DataReadStream> &stream) override;
+    };
+
+}
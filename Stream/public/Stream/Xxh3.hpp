@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Stream {
+
+#define XXH3_STRIPE_LENGTH 64
+#define XXH3_BUFFER_SIZE 256
+
+    /**
+     * Computes the 64-bit XXH3 hash of data passed to it in pieces of any size.
+     * The result is the one of XXH3_64bits from xxHash (default secret, seed 0) over all the data at once,
+     * so that hashes can be compared with ones computed by other tools.
+     */
+    class Xxh3 {
+
+    private:
+        alignas(XXH3_STRIPE_LENGTH) uint64_t accumulators[8]{};
+        alignas(XXH3_STRIPE_LENGTH) uint8_t buffer[XXH3_BUFFER_SIZE]{};
+        size_t bufferedSize{};
+        size_t nStripesAccumulated{};
+        uint64_t totalLength{};
+
+    public:
+        Xxh3();
+
+        void reset();
+
+        void update(const uint8_t *data, size_t length);
+
+        /**
+         * @return the hash of all the data passed to update since construction or the last reset
+         */
+        [[nodiscard]] uint64_t digest() const;
+
+        /**
+         * @return the hash of the data, all at once
+         */
+        static uint64_t Hash(const uint8_t *data, size_t length);
+    };
+
+}
@@ -2,6 +2,7 @@
 
 #include <Stream/AbstractDataWriteStream.hpp>
 #include <memory>
+#include <vector>
 
 namespace Stream {
 
@@ -17,9 +18,23 @@ namespace Stream {
         size_t outputBufferLength{};
         size_t outputBufferReadIndex{};
 
+        /**
+         * Content the compressed frame may reference, but which is not part of it.
+         * Must stay alive until the frame is finished, as zstd only references it.
+         */
+        std::vector<uint8_t> prefix;
+
     public:
         explicit ZstdDeflateStream(std::shared_ptr<AbstractDataWriteStream> sink);
 
+        /**
+         * Creates a deflate stream, which compresses against the specified prefix (like zstd --patch-from).
+         * The frame can only be inflated by a ZstdInflateStream that is given the same prefix.
+         * @param sink the stream to write the compressed data to
+         * @param prefix the content to compress against, eg. the previous version of the data
+         */
+        ZstdDeflateStream(std::shared_ptr<AbstractDataWriteStream> sink, std::vector<uint8_t> prefix);
+
     public:
         void seek(uint64_t position) override;
 
@@ -2,6 +2,7 @@
 
 #include <Stream/AbstractDataReadStream.hpp>
 #include <memory>
+#include <vector>
 
 namespace Stream {
 
@@ -20,12 +21,28 @@ namespace Stream {
         size_t outputBufferLength{};
         size_t outputBufferReadIndex{};
 
+        /**
+         * The prefix the frame was compressed against. Empty, if it was compressed without one.
+         */
+        std::vector<uint8_t> prefix;
+
     public:
         explicit ZstdInflateStream(std::shared_ptr<AbstractDataReadStream> source);
 
+        /**
+         * @param source the stream to read the compressed data from
+         * @param uncompressedSize the size of the decompressed content, or -1 if unknown.
+         * When known, the stream ends after this many bytes, which allows bulk reads up to the end of the stream.
+         * @param prefix the prefix the data was compressed against by ZstdDeflateStream, or empty if none was used.
+         */
+        ZstdInflateStream(std::shared_ptr<AbstractDataReadStream> source, uint64_t uncompressedSize,
+                          std::vector<uint8_t> prefix = {});
+
     public:
         uint8_t readUint8() override;
 
+        size_t read(uint8_t *buffer, size_t bufferLength) override;
+
         void seek(uint64_t position) override;
 
         void skip(uint64_t offset) override;
@@ -1,85 +1,81 @@
 #include <Stream/AbstractDataReadStream.hpp>
-#include <vector>
+#include <Stream/ByteSwap.hpp>
+#include <algorithm>
 
 using namespace Stream;
 
+// Compared against the remaining size, so that a huge capacity read from a corrupt stream can't wrap around
+#define HAS_CAPACITY(neededCapacity) \
+(size == -1 || ((position - startPosition) <= size && (neededCapacity) <= size - (position - startPosition)))
+
 #define CHECK_POSITION(neededCapacity) \
-if (size != -1 && (position - startPosition) + (neededCapacity) > size)  \
+if (!HAS_CAPACITY(neededCapacity))  \
 RAISE_EXCEPTION(StreamUnderflowException, "Tried to read from an exhausted stream")
 
+#define CHECK_ARRAY_POSITION(n, valueSize) \
+if ((n) > UINT64_MAX / (valueSize))  \
+RAISE_EXCEPTION(StreamUnderflowException, "Tried to read from an exhausted stream"); \
+CHECK_POSITION((n) * (valueSize))
+
 EXCEPTION_TYPE_DEFAULT_IMPL(StreamUnderflowException);
 
+// Multi-byte values are read with a single read call and converted,
+// which is only a copy if the byte order of the stream is the one of the host
+template<typename T>
+static T ReadValue(DataReadStream &stream, ByteOrder byteOrder) {
+    uint8_t bytes[sizeof(T)];
+    if (stream.read(bytes, sizeof(T)) != sizeof(T)) {
+        RAISE_EXCEPTION(StreamUnderflowException, "Tried to read from an exhausted stream");
+    }
+    return LoadValue<T>(bytes, byteOrder);
+}
+
 int8_t AbstractDataReadStream::readInt8() {
+    // Counted as uint8 by readUint8
     return static_cast<int8_t>(readUint8());
 }
 
 uint16_t AbstractDataReadStream::readUint16() {
+    STREAM_STATISTICS_COUNT(UINT16);
     CHECK_POSITION(2);
-    auto b1 = readUint8();
-    auto b2 = readUint8();
-    return static_cast<uint16_t>(b1 << 8 | b2);
+    return ReadValue<uint16_t>(*this, byteOrder);
 }
 
 int16_t AbstractDataReadStream::readInt16() {
+    STREAM_STATISTICS_COUNT(INT16);
     CHECK_POSITION(2);
-    auto b1 = readUint8();
-    auto b2 = readUint8();
-    return static_cast<int16_t>(b1 << 8 | b2);
+    return ReadValue<int16_t>(*this, byteOrder);
 }
 
 uint32_t AbstractDataReadStream::readUint32() {
+    STREAM_STATISTICS_COUNT(UINT32);
     CHECK_POSITION(4);
-    auto b1 = readUint8();
-    auto b2 = readUint8();
-    auto b3 = readUint8();
-    auto b4 = readUint8();
-    return static_cast<uint32_t>(b1 << 24 | b2 << 16 | b3 << 8 | b4);
+    return ReadValue<uint32_t>(*this, byteOrder);
 }
 
 int32_t AbstractDataReadStream::readInt32() {
+    STREAM_STATISTICS_COUNT(INT32);
     CHECK_POSITION(4);
-    auto b1 = readUint8();
-    auto b2 = readUint8();
-    auto b3 = readUint8();
-    auto b4 = readUint8();
-    return static_cast<int32_t>(b1 << 24 | b2 << 16 | b3 << 8 | b4);
+    return ReadValue<int32_t>(*this, byteOrder);
 }
 
 uint64_t AbstractDataReadStream::readUint64() {
+    STREAM_STATISTICS_COUNT(UINT64);
     CHECK_POSITION(8);
-    auto b1 = static_cast<uint64_t>(readUint8());
-    auto b2 = static_cast<uint64_t>(readUint8());
-    auto b3 = static_cast<uint64_t>(readUint8());
-    auto b4 = static_cast<uint64_t>(readUint8());
-    auto b5 = static_cast<uint64_t>(readUint8());
-    auto b6 = static_cast<uint64_t>(readUint8());
-    auto b7 = static_cast<uint64_t>(readUint8());
-    auto b8 = static_cast<uint64_t>(readUint8());
-    return b1 << 56 | b2 << 48 | b3 << 40 | b4 << 32 | b5 << 24 | b6 << 16 | b7 << 8 | b8;
+    return ReadValue<uint64_t>(*this, byteOrder);
 }
 
 int64_t AbstractDataReadStream::readInt64() {
+    STREAM_STATISTICS_COUNT(INT64);
     CHECK_POSITION(8);
-    auto b1 = static_cast<uint64_t>(readUint8());
-    auto b2 = static_cast<uint64_t>(readUint8());
-    auto b3 = static_cast<uint64_t>(readUint8());
-    auto b4 = static_cast<uint64_t>(readUint8());
-    auto b5 = static_cast<uint64_t>(readUint8());
-    auto b6 = static_cast<uint64_t>(readUint8());
-    auto b7 = static_cast<uint64_t>(readUint8());
-    auto b8 = static_cast<uint64_t>(readUint8());
-    return static_cast<int64_t>(b1 << 56 | b2 << 48 | b3 << 40 | b4 << 32 | b5 << 24 | b6 << 16 | b7 << 8 | b8);
+    return ReadValue<int64_t>(*this, byteOrder);
 }
 
 float AbstractDataReadStream::readFloat32() {
+    STREAM_STATISTICS_COUNT(FLOAT32);
     static_assert(sizeof(float) == 4, "float is not 4 bytes");
     CHECK_POSITION(4);
-    auto b1 = readUint8();
-    auto b2 = readUint8();
-    auto b3 = readUint8();
-    auto b4 = readUint8();
-    auto value = b1 << 24 | b2 << 16 | b3 << 8 | b4;
-    return reinterpret_cast<float &>(value);
+    return ReadValue<float>(*this, byteOrder);
 }
 
 size_t AbstractDataReadStream::read(uint8_t *buffer, size_t bufferLength) {
@@ -92,26 +88,120 @@ size_t AbstractDataReadStream::read(uint8_t *buffer, size_t bufferLength) {
     return bufferLength;
 }
 
+// The non-throwing reads check the capacity the same way as CHECK_POSITION, but return false instead of raising
+// Decorated streams raise from read() when their source fails, e.g. on corrupt compressed data, which is reported
+// as a failed read as well. Entering the try block costs nothing as long as nothing is raised.
+template<typename T>
+static bool TryReadValue(DataReadStream &stream, ByteOrder byteOrder, T &value) {
+    uint8_t bytes[sizeof(T)];
+    try {
+        if (stream.read(bytes, sizeof(T)) != sizeof(T)) {
+            return false;
+        }
+    } catch (const errorhandling::Exception &) {
+        return false;
+    }
+    value = LoadValue<T>(bytes, byteOrder);
+    return true;
+}
+
+bool AbstractDataReadStream::tryReadUint8(uint8_t &value) {
+    return HAS_CAPACITY(1) && TryReadValue(*this, byteOrder, value);
+}
+
+bool AbstractDataReadStream::tryReadInt8(int8_t &value) {
+    return HAS_CAPACITY(1) && TryReadValue(*this, byteOrder, value);
+}
+
+bool AbstractDataReadStream::tryReadUint16(uint16_t &value) {
+    return HAS_CAPACITY(2) && TryReadValue(*this, byteOrder, value);
+}
+
+bool AbstractDataReadStream::tryReadInt16(int16_t &value) {
+    return HAS_CAPACITY(2) && TryReadValue(*this, byteOrder, value);
+}
+
+bool AbstractDataReadStream::tryReadUint32(uint32_t &value) {
+    return HAS_CAPACITY(4) && TryReadValue(*this, byteOrder, value);
+}
+
+bool AbstractDataReadStream::tryReadInt32(int32_t &value) {
+    return HAS_CAPACITY(4) && TryReadValue(*this, byteOrder, value);
+}
+
+bool AbstractDataReadStream::tryReadUint64(uint64_t &value) {
+    return HAS_CAPACITY(8) && TryReadValue(*this, byteOrder, value);
+}
+
+bool AbstractDataReadStream::tryReadInt64(int64_t &value) {
+    return HAS_CAPACITY(8) && TryReadValue(*this, byteOrder, value);
+}
+
+bool AbstractDataReadStream::tryReadFloat32(float &value) {
+    return HAS_CAPACITY(4) && TryReadValue(*this, byteOrder, value);
+}
+
+// Arrays which need byte swapping are read and swapped in blocks, so that the data is still in cache when it is swapped
+#define ARRAY_BLOCK_SIZE 65536
+
+static void ReadArray(DataReadStream &stream, uint8_t *destination, size_t n, size_t valueSize,
+                      void (*swap)(const uint8_t *, uint8_t *, size_t), bool swapBytes) {
+    size_t valuesPerBlock = swapBytes ? ARRAY_BLOCK_SIZE / valueSize : n;
+    for (size_t i = 0; i < n; i += valuesPerBlock) {
+        size_t nValues = std::min(valuesPerBlock, n - i);
+        uint8_t *block = destination + i * valueSize;
+        if (stream.read(block, nValues * valueSize) != nValues * valueSize) {
+            RAISE_EXCEPTION(StreamUnderflowException, "Tried to read from an exhausted stream");
+        }
+        if (swapBytes) {
+            swap(block, block, nValues);
+        }
+    }
+}
+
+void AbstractDataReadStream::readUint16Array(uint16_t *values, size_t n) {
+    STREAM_STATISTICS_COUNT(ARRAY);
+    CHECK_ARRAY_POSITION(n, sizeof(uint16_t));
+    ReadArray(*this, reinterpret_cast<uint8_t *>(values), n, sizeof(uint16_t), SwapBytes16,
+              byteOrder != HostByteOrder());
+}
+
+void AbstractDataReadStream::readUint32Array(uint32_t *values, size_t n) {
+    STREAM_STATISTICS_COUNT(ARRAY);
+    CHECK_ARRAY_POSITION(n, sizeof(uint32_t));
+    ReadArray(*this, reinterpret_cast<uint8_t *>(values), n, sizeof(uint32_t), SwapBytes32,
+              byteOrder != HostByteOrder());
+}
+
+void AbstractDataReadStream::readFloat32Array(float *values, size_t n) {
+    STREAM_STATISTICS_COUNT(ARRAY);
+    static_assert(sizeof(float) == 4, "float is not 4 bytes");
+    CHECK_ARRAY_POSITION(n, sizeof(float));
+    ReadArray(*this, reinterpret_cast<uint8_t *>(values), n, sizeof(float), SwapBytes32,
+              byteOrder != HostByteOrder());
+}
+
 
 std::string AbstractDataReadStream::readString() {
-    uint64_t length = readInt64();
-    std::vector<char> buffer;
-    buffer.reserve(length);
-    for (uint64_t i = 0; i < length; i++) {
-        char character = static_cast<char>(readUint8());
-        buffer.push_back(character);
+    STREAM_STATISTICS_COUNT(STRING);
+    uint64_t length = readUint64();
+    // Checked before allocating, so that a corrupt length can't allocate more than the stream holds
+    CHECK_POSITION(length);
+    std::string string(length, '\0');
+    if (read(reinterpret_cast<uint8_t *>(string.data()), length) != length) {
+        RAISE_EXCEPTION(StreamUnderflowException, "Tried to read from an exhausted stream");
     }
-    buffer.push_back('\0');
-    return {buffer.data()};
+    return string;
 }
 
 
 std::string AbstractDataReadStream::readFixedString(size_t length) {
-    std::string str;
-    str.resize(length);
-    read(reinterpret_cast<uint8_t *>(&str[0]), length);
-    str = str.substr(0, str.find_first_of('\0'));
-    return str;
+    STREAM_STATISTICS_COUNT(FIXED_STRING);
+    std::string string(length, '\0');
+    size_t nRead = read(reinterpret_cast<uint8_t *>(string.data()), length);
+    // Fixed strings are padded with NULs, which are cut off in place
+    string.resize(std::min(nRead, string.find('\0')));
+    return string;
 }
 
 AbstractDataReadStream::AbstractDataReadStream(uint64_t size, uint64_t position) : size(size), position(position),
@@ -126,6 +216,18 @@ uint64_t AbstractDataReadStream::getPosition() const {
     return position;
 }
 
+void AbstractDataReadStream::setByteOrder(ByteOrder newByteOrder) {
+    byteOrder = newByteOrder;
+}
+
+ByteOrder AbstractDataReadStream::getByteOrder() const {
+    return byteOrder;
+}
+
 bool AbstractDataReadStream::hasRemaining() const {
     return size == -1 || (position - startPosition) < size;
 }
+
+const std::shared_ptr<StreamStatistics> &AbstractDataReadStream::getStatistics() const {
+    return statistics;
+}
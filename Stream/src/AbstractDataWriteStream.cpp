@@ -1,5 +1,8 @@
 #include <Stream/AbstractDataWriteStream.hpp>
 #include <Stream/AbstractDataReadStream.hpp>
+#include <Stream/ByteSwap.hpp>
+#include <algorithm>
+#include <vector>
 
 using namespace Stream;
 
@@ -14,71 +17,56 @@ void AbstractDataWriteStream::writeInt8(int8_t int8) {
     writeUint8(static_cast<uint8_t>(int8));
 }
 
+// Multi-byte values are encoded up front and passed to writeBuffer as a whole,
+// so that streams with a bulk writeBuffer don't pay for a virtual writeUint8 call per byte
+template<typename T>
+static void WriteValue(DataWriteStream &stream, T value, ByteOrder byteOrder) {
+    uint8_t bytes[sizeof(T)];
+    StoreValue(bytes, value, byteOrder);
+    stream.writeBuffer(bytes, sizeof(T));
+}
+
 void AbstractDataWriteStream::writeUint16(uint16_t uint16) {
     CHECK_POSITION(2);
-    writeUint8(uint16 >> 8);
-    writeUint8(uint16);
+    WriteValue(*this, uint16, byteOrder);
 }
 
 void AbstractDataWriteStream::writeInt16(int16_t int16) {
     CHECK_POSITION(2);
-    writeUint8(int16 >> 8);
-    writeUint8(int16);
+    WriteValue(*this, int16, byteOrder);
 }
 
 
 void AbstractDataWriteStream::writeUint32(uint32_t uint32) {
     CHECK_POSITION(4);
-    writeUint8(uint32 >> 24);
-    writeUint8(uint32 >> 16);
-    writeUint8(uint32 >> 8);
-    writeUint8(uint32);
+    WriteValue(*this, uint32, byteOrder);
 }
 
 void AbstractDataWriteStream::writeInt32(int32_t int32) {
     CHECK_POSITION(4);
-    writeUint8(int32 >> 24);
-    writeUint8(int32 >> 16);
-    writeUint8(int32 >> 8);
-    writeUint8(int32);
+    WriteValue(*this, int32, byteOrder);
 }
 
 void AbstractDataWriteStream::writeUint64(uint64_t uint64) {
     CHECK_POSITION(8);
-    writeUint8(uint64 >> 54);
-    writeUint8(uint64 >> 48);
-    writeUint8(uint64 >> 40);
-    writeUint8(uint64 >> 32);
-    writeUint8(uint64 >> 24);
-    writeUint8(uint64 >> 16);
-    writeUint8(uint64 >> 8);
-    writeUint8(uint64);
+    WriteValue(*this, uint64, byteOrder);
 }
 
 void AbstractDataWriteStream::writeInt64(int64_t int64) {
     CHECK_POSITION(8);
-    writeUint8(int64 >> 54);
-    writeUint8(int64 >> 48);
-    writeUint8(int64 >> 40);
-    writeUint8(int64 >> 32);
-    writeUint8(int64 >> 24);
-    writeUint8(int64 >> 16);
-    writeUint8(int64 >> 8);
-    writeUint8(int64);
+    WriteValue(*this, int64, byteOrder);
 }
 
 void AbstractDataWriteStream::writeFloat32(float f32) {
     static_assert(sizeof(float) == 4, "float is not 4 bytes");
     CHECK_POSITION(4);
-    writeUint32(reinterpret_cast<uint32_t &>(f32));
+    WriteValue(*this, f32, byteOrder);
 }
 
 void AbstractDataWriteStream::writeString(const std::string &string) {
     size_t strSize = string.length();
     writeUint64(strSize);
-    for (char character: string) {
-        writeUint8(character);
-    }
+    writeBuffer(reinterpret_cast<const uint8_t *>(string.data()), strSize);
 }
 
 void AbstractDataWriteStream::writeFixedString(const std::string &string, size_t fixedLength) {
@@ -86,9 +74,7 @@ void AbstractDataWriteStream::writeFixedString(const std::string &string, size_t
     if (strSize > fixedLength) {
         RAISE_EXCEPTION(StreamOverflowException, "Tried to write a string with more characters than the fixed length");
     }
-    for (char character: string) {
-        writeUint8(character);
-    }
+    writeBuffer(reinterpret_cast<const uint8_t *>(string.data()), strSize);
     for (size_t i = 0; i < fixedLength - strSize; i++) {
         writeUint8(0);
     }
@@ -101,6 +87,57 @@ void AbstractDataWriteStream::writeBuffer(const uint8_t *buffer, size_t size) {
     }
 }
 
+// Arrays which need byte swapping are swapped into a block on the stack, which is then written as a whole
+#define ARRAY_BLOCK_SIZE 4096
+
+static void WriteArray(DataWriteStream &stream, const uint8_t *source, size_t n, size_t valueSize,
+                       void (*swap)(const uint8_t *, uint8_t *, size_t), bool swapBytes) {
+    if (!swapBytes) {
+        stream.writeBuffer(source, n * valueSize);
+        return;
+    }
+    uint8_t block[ARRAY_BLOCK_SIZE];
+    size_t valuesPerBlock = ARRAY_BLOCK_SIZE / valueSize;
+    for (size_t i = 0; i < n; i += valuesPerBlock) {
+        size_t nValues = std::min(valuesPerBlock, n - i);
+        swap(source + i * valueSize, block, nValues);
+        stream.writeBuffer(block, nValues * valueSize);
+    }
+}
+
+void AbstractDataWriteStream::writeUint16Array(const uint16_t *values, size_t n) {
+    CHECK_POSITION(n * sizeof(uint16_t));
+    WriteArray(*this, reinterpret_cast<const uint8_t *>(values), n, sizeof(uint16_t), SwapBytes16,
+               byteOrder != HostByteOrder());
+}
+
+void AbstractDataWriteStream::writeUint32Array(const uint32_t *values, size_t n) {
+    CHECK_POSITION(n * sizeof(uint32_t));
+    WriteArray(*this, reinterpret_cast<const uint8_t *>(values), n, sizeof(uint32_t), SwapBytes32,
+               byteOrder != HostByteOrder());
+}
+
+void AbstractDataWriteStream::writeFloat32Array(const float *values, size_t n) {
+    static_assert(sizeof(float) == 4, "float is not 4 bytes");
+    CHECK_POSITION(n * sizeof(float));
+    WriteArray(*this, reinterpret_cast<const uint8_t *>(values), n, sizeof(float), SwapBytes32,
+               byteOrder != HostByteOrder());
+}
+
+std::pair<size_t, size_t> AbstractDataWriteStream::copyStreamContents(const std::shared_ptr<DataReadStream> &stream) {
+    std::vector<uint8_t> block(WRITE_BUFFER_SIZE);
+    size_t nWritten = 0;
+    while (stream->hasRemaining()) {
+        size_t nRead = stream->read(block.data(), block.size());
+        if (nRead == 0) {
+            break;
+        }
+        writeBuffer(block.data(), nRead);
+        nWritten += nRead;
+    }
+    return {nWritten, nWritten};
+}
+
 AbstractDataWriteStream::AbstractDataWriteStream(uint64_t size, uint64_t position) : size(size),
                                                                                      position(position),
                                                                                      startPosition(position) {}
@@ -112,3 +149,11 @@ uint64_t AbstractDataWriteStream::getPosition() const {
 uint64_t AbstractDataWriteStream::getSize() const {
     return size;
 }
+
+void AbstractDataWriteStream::setByteOrder(ByteOrder newByteOrder) {
+    byteOrder = newByteOrder;
+}
+
+ByteOrder AbstractDataWriteStream::getByteOrder() const {
+    return byteOrder;
+}
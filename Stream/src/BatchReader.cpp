@@ -0,0 +1,25 @@
+#include <Stream/BatchReader.hpp>
+#include <Stream/PreadBatchReader.hpp>
+#include <Stream/IoUringBatchReader.hpp>
+
+using namespace Stream;
+
+EXCEPTION_TYPE_DEFAULT_IMPL(BatchReaderOpenFailedException);
+EXCEPTION_TYPE_DEFAULT_IMPL(BatchReadFailedException);
+
+std::unique_ptr<BatchReader> BatchReader::Open(const std::string &filePath, BatchReaderBackend backend) {
+    if (backend == BatchReaderBackend::PREAD) {
+        return std::make_unique<PreadBatchReader>(filePath);
+    }
+#ifdef DYNGINE_STREAM_IO_URING
+    auto ioUringReader = IoUringBatchReader::TryOpen(filePath);
+    if (ioUringReader != nullptr) {
+        return ioUringReader;
+    }
+#endif
+    if (backend == BatchReaderBackend::IO_URING) {
+        RAISE_EXCEPTION(BatchReaderOpenFailedException,
+                        "Failed to open BatchReader for path: \"" + filePath + "\": io_uring is not available");
+    }
+    return std::make_unique<PreadBatchReader>(filePath);
+}
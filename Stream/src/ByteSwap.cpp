@@ -0,0 +1,132 @@
+#include <Stream/ByteSwap.hpp>
+#include <cstring>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define BYTE_SWAP_X86
+
+#include <immintrin.h>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+// MSVC allows intrinsics of any instruction set without compiler flags
+#define BYTE_SWAP_TARGET(instructionSet)
+#else
+#define BYTE_SWAP_TARGET(instructionSet) __attribute__((target(instructionSet)))
+#endif
+
+#endif
+
+using namespace Stream;
+
+enum class SimdLevel {
+    SCALAR,
+    SSSE3,
+    AVX2
+};
+
+static SimdLevel DetectSimdLevel() {
+#ifdef BYTE_SWAP_X86
+#ifdef _MSC_VER
+    int cpuInfo[4];
+    __cpuid(cpuInfo, 1);
+    bool ssse3 = (cpuInfo[2] & (1 << 9)) != 0;
+    // AVX registers are only usable if the OS saves them on context switches
+    bool osAvx = (cpuInfo[2] & (1 << 27)) != 0 && (_xgetbv(0) & 0x6) == 0x6;
+    __cpuidex(cpuInfo, 7, 0);
+    bool avx2 = osAvx && (cpuInfo[1] & (1 << 5)) != 0;
+#else
+    __builtin_cpu_init();
+    bool ssse3 = __builtin_cpu_supports("ssse3");
+    bool avx2 = __builtin_cpu_supports("avx2");
+#endif
+    if (avx2) {
+        return SimdLevel::AVX2;
+    }
+    if (ssse3) {
+        return SimdLevel::SSSE3;
+    }
+#endif
+    return SimdLevel::SCALAR;
+}
+
+static SimdLevel GetSimdLevel() {
+    static const SimdLevel simdLevel = DetectSimdLevel();
+    return simdLevel;
+}
+
+static void SwapBytes16Scalar(const uint8_t *source, uint8_t *destination, size_t n) {
+    for (size_t i = 0; i < n * 2; i += 2) {
+        uint8_t b0 = source[i];
+        uint8_t b1 = source[i + 1];
+        destination[i] = b1;
+        destination[i + 1] = b0;
+    }
+}
+
+static void SwapBytes32Scalar(const uint8_t *source, uint8_t *destination, size_t n) {
+    for (size_t i = 0; i < n * 4; i += 4) {
+        uint8_t b0 = source[i];
+        uint8_t b1 = source[i + 1];
+        uint8_t b2 = source[i + 2];
+        uint8_t b3 = source[i + 3];
+        destination[i] = b3;
+        destination[i + 1] = b2;
+        destination[i + 2] = b1;
+        destination[i + 3] = b0;
+    }
+}
+
+#ifdef BYTE_SWAP_X86
+
+BYTE_SWAP_TARGET("ssse3")
+static size_t SwapSsse3(const uint8_t *source, uint8_t *destination, size_t nBytes, __m128i shuffle) {
+    size_t i = 0;
+    for (; i + 16 <= nBytes; i += 16) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(source + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(destination + i), _mm_shuffle_epi8(block, shuffle));
+    }
+    return i;
+}
+
+BYTE_SWAP_TARGET("avx2")
+static size_t SwapAvx2(const uint8_t *source, uint8_t *destination, size_t nBytes, __m128i laneShuffle) {
+    // vpshufb shuffles within 128-bit lanes, so both lanes use the same shuffle
+    __m256i shuffle = _mm256_broadcastsi128_si256(laneShuffle);
+    size_t i = 0;
+    for (; i + 32 <= nBytes; i += 32) {
+        __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(source + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(destination + i), _mm256_shuffle_epi8(block, shuffle));
+    }
+    return i;
+}
+
+static size_t SwapSimd(const uint8_t *source, uint8_t *destination, size_t nBytes, __m128i shuffle) {
+    switch (GetSimdLevel()) {
+        case SimdLevel::AVX2:
+            return SwapAvx2(source, destination, nBytes, shuffle);
+        case SimdLevel::SSSE3:
+            return SwapSsse3(source, destination, nBytes, shuffle);
+        default:
+            return 0;
+    }
+}
+
+#endif
+
+void Stream::SwapBytes16(const uint8_t *source, uint8_t *destination, size_t n) {
+    size_t nSwapped = 0;
+#ifdef BYTE_SWAP_X86
+    __m128i shuffle = _mm_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14);
+    nSwapped = SwapSimd(source, destination, n * 2, shuffle) / 2;
+#endif
+    SwapBytes16Scalar(source + nSwapped * 2, destination + nSwapped * 2, n - nSwapped);
+}
+
+void Stream::SwapBytes32(const uint8_t *source, uint8_t *destination, size_t n) {
+    size_t nSwapped = 0;
+#ifdef BYTE_SWAP_X86
+    __m128i shuffle = _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+    nSwapped = SwapSimd(source, destination, n * 4, shuffle) / 4;
+#endif
+    SwapBytes32Scalar(source + nSwapped * 4, destination + nSwapped * 4, n - nSwapped);
+}
@@ -0,0 +1,39 @@
+#include <Stream/CountingReadStream.hpp>
+
+using namespace Stream;
+
+CountingReadStream::CountingReadStream(std::shared_ptr<DataReadStream> source)
+        : AbstractDataReadStream(source->getLength(), source->getPosition()), source(std::move(source)) {
+}
+
+uint8_t CountingReadStream::readUint8() {
+    uint8_t uint8 = source->readUint8();
+    position++;
+    nBytesRead++;
+    return uint8;
+}
+
+size_t CountingReadStream::read(uint8_t *buffer, size_t bufferLength) {
+    size_t nRead = source->read(buffer, bufferLength);
+    position += nRead;
+    nBytesRead += nRead;
+    return nRead;
+}
+
+void CountingReadStream::seek(uint64_t newPosition) {
+    source->seek(newPosition);
+    position = newPosition;
+}
+
+void CountingReadStream::skip(uint64_t offset) {
+    source->skip(offset);
+    position += offset;
+}
+
+bool CountingReadStream::hasRemaining() const {
+    return source->hasRemaining();
+}
+
+uint64_t CountingReadStream::getBytesRead() const {
+    return nBytesRead;
+}
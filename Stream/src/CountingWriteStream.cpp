@@ -0,0 +1,45 @@
+#include <Stream/CountingWriteStream.hpp>
+
+using namespace Stream;
+
+CountingWriteStream::CountingWriteStream(std::shared_ptr<DataWriteStream> sink)
+        : AbstractDataWriteStream(-1, 0), sink(std::move(sink)) {
+}
+
+void CountingWriteStream::seek(uint64_t newPosition) {
+    if (sink != nullptr) {
+        sink->seek(newPosition);
+    }
+    position = newPosition;
+}
+
+void CountingWriteStream::skip(uint64_t offset) {
+    if (sink != nullptr) {
+        sink->skip(offset);
+    }
+    position += offset;
+}
+
+void CountingWriteStream::writeUint8(uint8_t uint8) {
+    if (sink != nullptr) {
+        sink->writeUint8(uint8);
+    }
+    position++;
+    nBytesWritten++;
+}
+
+void CountingWriteStream::writeBuffer(const uint8_t *buffer, size_t bufferSize) {
+    if (sink != nullptr) {
+        sink->writeBuffer(buffer, bufferSize);
+    }
+    position += bufferSize;
+    nBytesWritten += bufferSize;
+}
+
+std::pair<size_t, size_t> CountingWriteStream::writeStreamContents(const std::shared_ptr<DataReadStream> &stream) {
+    return copyStreamContents(stream);
+}
+
+uint64_t CountingWriteStream::getBytesWritten() const {
+    return nBytesWritten;
+}
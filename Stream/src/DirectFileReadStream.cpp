@@ -0,0 +1,200 @@
+#include <Stream/DirectFileReadStream.hpp>
+#include <Stream/StreamExcept.hpp>
+#include <Utils/FileUtils.hpp>
+#include <ErrorHandling/FileExcept.hpp>
+#include <algorithm>
+#include <cstring>
+#include <new>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+using namespace Stream;
+
+#define CHECK_POSITION(neededCapacity) \
+if ((position - startPosition) + (neededCapacity) > size)  \
+RAISE_EXCEPTION(StreamUnderflowException, "Tried to read from an exhausted stream")
+
+EXCEPTION_TYPE_DEFAULT_IMPL(DirectFileReadStreamOpenFailedException);
+EXCEPTION_TYPE_DEFAULT_IMPL(DirectFileReadFailedException);
+
+static uint64_t DirectFileReadStreamGetFileSize(const std::string &filePath) {
+    uint64_t fileSize;
+    try {
+        fileSize = FileUtils::GetFileSize(filePath);
+    } catch (const errorhandling::FileException &e) {
+        RAISE_EXCEPTION_CAUSED_BY(DirectFileReadStreamOpenFailedException,
+                                  "Failed to open DirectFileReadStream for path: \"" + filePath + "\"", e);
+    }
+    return fileSize;
+}
+
+DirectFileReadStream::DirectFileReadStream(const std::string &filePath, uint64_t position, uint64_t size) :
+        AbstractDataReadStream(size, position),
+        filePath(filePath) {
+    STREAM_STATISTICS_REGISTER("DirectFileReadStream");
+#ifdef _WIN32
+    fileHandle = CreateFileA(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                             FILE_FLAG_NO_BUFFERING | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    direct = fileHandle != INVALID_HANDLE_VALUE;
+    if (!direct) {
+        fileHandle = CreateFileA(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                 FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    }
+    if (fileHandle == INVALID_HANDLE_VALUE) {
+        RAISE_EXCEPTION(DirectFileReadStreamOpenFailedException,
+                        "Failed to open DirectFileReadStream for path: \"" + filePath + "\": CreateFile failed");
+    }
+#else
+    fileDescriptor = -1;
+#ifdef O_DIRECT
+    // Fails with EINVAL on file systems without direct I/O, like tmpfs
+    fileDescriptor = open(filePath.c_str(), O_RDONLY | O_CLOEXEC | O_DIRECT);
+    direct = fileDescriptor >= 0;
+#endif
+    if (!direct) {
+        fileDescriptor = open(filePath.c_str(), O_RDONLY | O_CLOEXEC);
+    }
+    if (fileDescriptor < 0) {
+        RAISE_EXCEPTION(DirectFileReadStreamOpenFailedException,
+                        "Failed to open DirectFileReadStream for path: \"" + filePath + "\": open failed");
+    }
+#ifdef F_NOCACHE
+    if (!direct) {
+        direct = fcntl(fileDescriptor, F_NOCACHE, 1) != -1;
+    }
+#endif
+#ifdef POSIX_FADV_SEQUENTIAL
+    posix_fadvise(fileDescriptor, static_cast<off_t>(position), static_cast<off_t>(size), POSIX_FADV_SEQUENTIAL);
+#endif
+#endif
+    buffer = static_cast<uint8_t *>(operator new[](DIRECT_READ_BUFFER_SIZE,
+                                                   std::align_val_t(DIRECT_READ_ALIGNMENT)));
+}
+
+DirectFileReadStream::DirectFileReadStream(const std::string &filePath) :
+        DirectFileReadStream(filePath, 0, DirectFileReadStreamGetFileSize(filePath)) {
+}
+
+DirectFileReadStream::~DirectFileReadStream() {
+    releaseBufferedPages();
+    operator delete[](buffer, std::align_val_t(DIRECT_READ_ALIGNMENT));
+#ifdef _WIN32
+    CloseHandle(fileHandle);
+#else
+    ::close(fileDescriptor);
+#endif
+}
+
+std::unique_ptr<DirectFileReadStream> DirectFileReadStream::Open(const std::string &filePath) {
+    return std::make_unique<DirectFileReadStream>(filePath);
+}
+
+void DirectFileReadStream::releaseBufferedPages() {
+#ifdef POSIX_FADV_DONTNEED
+    if (!direct && bufferLength > 0) {
+        posix_fadvise(fileDescriptor, static_cast<off_t>(bufferOffset), static_cast<off_t>(bufferLength),
+                      POSIX_FADV_DONTNEED);
+    }
+#endif
+}
+
+void DirectFileReadStream::fillBuffer() {
+    STREAM_STATISTICS_ADD(refills, 1);
+    STREAM_STATISTICS_TIME(sourceNanoseconds);
+    releaseBufferedPages();
+    bufferOffset = position - position % DIRECT_READ_ALIGNMENT;
+    bufferLength = 0;
+#ifdef _WIN32
+    OVERLAPPED overlapped{};
+    overlapped.Offset = static_cast<DWORD>(bufferOffset);
+    overlapped.OffsetHigh = static_cast<DWORD>(bufferOffset >> 32);
+    DWORD nRead = 0;
+    if (!ReadFile(fileHandle, buffer, DIRECT_READ_BUFFER_SIZE, &nRead, &overlapped) &&
+        GetLastError() != ERROR_HANDLE_EOF) {
+        RAISE_EXCEPTION(DirectFileReadFailedException, "Failed to read from \"" + filePath + "\": ReadFile failed");
+    }
+#else
+    // A direct read is a single aligned read, which is only short at the end of the file
+    ssize_t nRead;
+    while ((nRead = pread(fileDescriptor, buffer, DIRECT_READ_BUFFER_SIZE, static_cast<off_t>(bufferOffset))) < 0) {
+        if (errno == EINTR) {
+            continue;
+        }
+#ifdef O_DIRECT
+        // Some file systems accept O_DIRECT on open, but not on read
+        if (errno == EINVAL && direct) {
+            fcntl(fileDescriptor, F_SETFL, fcntl(fileDescriptor, F_GETFL) & ~O_DIRECT);
+            direct = false;
+            continue;
+        }
+#endif
+        RAISE_EXCEPTION(DirectFileReadFailedException, "Failed to read from \"" + filePath + "\": pread failed");
+    }
+#endif
+    bufferLength = static_cast<size_t>(nRead);
+}
+
+uint8_t DirectFileReadStream::readUint8() {
+    CHECK_POSITION(1);
+    if (position < bufferOffset || position >= bufferOffset + bufferLength) {
+        fillBuffer();
+        if (position >= bufferOffset + bufferLength) {
+            RAISE_EXCEPTION(StreamUnderflowException, "Tried to read past the end of \"" + filePath + "\"");
+        }
+    }
+    STREAM_STATISTICS_COUNT_BYTES(UINT8, 1);
+    return buffer[position++ - bufferOffset];
+}
+
+size_t DirectFileReadStream::read(uint8_t *destination, size_t length) {
+    // Never read past the end of the stream, which is not necessarily the end of the file
+    length = std::min<uint64_t>(length, size - (position - startPosition));
+    size_t nRead = 0;
+    while (nRead < length) {
+        if (position < bufferOffset || position >= bufferOffset + bufferLength) {
+            fillBuffer();
+            if (position >= bufferOffset + bufferLength) {
+                break;
+            }
+        }
+        size_t nCopy = std::min<uint64_t>(length - nRead, bufferOffset + bufferLength - position);
+        memcpy(destination + nRead, buffer + (position - bufferOffset), nCopy);
+        position += nCopy;
+        nRead += nCopy;
+    }
+    STREAM_STATISTICS_BYTES(nRead);
+    return nRead;
+}
+
+void DirectFileReadStream::seek(uint64_t newPosition) {
+    if ((newPosition - startPosition) > size) {
+        RAISE_EXCEPTION(StreamSeekException, "Tried to seek to position " + std::to_string(newPosition) +
+                                             " in a stream of size " + std::to_string(size));
+    }
+    STREAM_STATISTICS_ADD(seeks, 1);
+    // The buffer is kept, it is refilled by the next read outside of it
+    position = newPosition;
+}
+
+void DirectFileReadStream::skip(uint64_t offset) {
+    seek(position + offset);
+}
+
+bool DirectFileReadStream::hasRemaining() const {
+    return (position - startPosition) < size;
+}
+
+const std::string &DirectFileReadStream::getFilePath() const {
+    return filePath;
+}
+
+bool DirectFileReadStream::isDirect() const {
+    return direct;
+}
@@ -26,6 +26,7 @@ static uint64_t FileDataStreamGetFileSize(const std::string &filePath) {
 FileDataReadStream::FileDataReadStream(const std::string &filePath, uint64_t position, uint64_t size) :
         AbstractDataReadStream(size, position),
         filePath(filePath) {
+    STREAM_STATISTICS_REGISTER("FileDataReadStream");
     stream = std::ifstream(filePath, std::ios::binary | std::ios::in);
     if (!stream) {
         RAISE_EXCEPTION(FileDataReadStreamOpenFailedException,
@@ -44,6 +45,8 @@ std::unique_ptr<FileDataReadStream> FileDataReadStream::Open(const std::string &
 
 uint8_t FileDataReadStream::readUint8() {
     CHECK_POSITION(1);
+    // Refills of the ifstream's buffer are not visible here, only the bulk reads count as refills
+    STREAM_STATISTICS_COUNT_BYTES(UINT8, 1);
     char byte{};
     stream.read(&byte, 1);
     position++;
@@ -58,6 +61,7 @@ void FileDataReadStream::seek(uint64_t newPosition) {
         RAISE_EXCEPTION(StreamSeekException, "Tried to seek to position " + std::to_string(newPosition) +
                                              " in a stream of size " + std::to_string(size));
     }
+    STREAM_STATISTICS_ADD(seeks, 1);
     stream.seekg(static_cast<std::ifstream::pos_type>(newPosition));
     if (stream.bad()) {
         RAISE_EXCEPTION(StreamSeekException, "Failed to seek to " + std::to_string(newPosition) + " bytes in ofstream");
@@ -68,12 +72,13 @@ void FileDataReadStream::seek(uint64_t newPosition) {
 void FileDataReadStream::skip(uint64_t offset) {
     // This must be met, or we can only open 4 GB files, which would be terrible
     uint64_t newPosition = position + offset;
-    if ((newPosition - startPosition) >= size) {
+    if ((newPosition - startPosition) > size) {
         RAISE_EXCEPTION(StreamSeekException, "Tried to seek to position " + std::to_string(newPosition) +
                                                   " in a stream of size " + std::to_string(size));
     }
     static_assert(sizeof(uint64_t) <= sizeof(std::ifstream::pos_type));
-    stream.seekg(static_cast<std::ifstream::pos_type>(offset), std::ios::end);
+    STREAM_STATISTICS_ADD(seeks, 1);
+    stream.seekg(static_cast<std::ifstream::off_type>(offset), std::ios::cur);
     if (stream.bad()) {
         RAISE_EXCEPTION(StreamSeekException, "Failed to seek " + std::to_string(offset) + " bytes in ofstream");
     }
@@ -99,7 +104,15 @@ bool FileDataReadStream::hasRemaining() const {
 }
 
 size_t FileDataReadStream::read(uint8_t *buffer, size_t bufferLength) {
-    stream.read(reinterpret_cast<char *>(buffer), bufferLength);
-    position += bufferLength;
-    return stream.gcount();
+    // Never read past the end of the stream, which is not necessarily the end of the file
+    if (size != -1 && (position - startPosition) + bufferLength > size) {
+        bufferLength = size - (position - startPosition);
+    }
+    STREAM_STATISTICS_ADD(refills, 1);
+    STREAM_STATISTICS_TIME(sourceNanoseconds);
+    stream.read(reinterpret_cast<char *>(buffer), static_cast<std::streamsize>(bufferLength));
+    auto nRead = static_cast<size_t>(stream.gcount());
+    STREAM_STATISTICS_BYTES(nRead);
+    position += nRead;
+    return nRead;
 }
@@ -1,5 +1,6 @@
 #include <Stream/FileDataWriteStream.hpp>
 #include <Stream/StreamExcept.hpp>
+#include <cstring>
 
 namespace Stream {
 
@@ -15,17 +16,28 @@ namespace Stream {
     }
 
     void FileDataWriteStream::writeUint8(uint8_t uint8) {
-        stream.write(reinterpret_cast<const char *>(&uint8), 1);
-        if (stream.bad()) {
-            RAISE_EXCEPTION(StreamWriteException, "Failed to write to ofstream");
+        if (bufferLength == buffer.size()) {
+            flush();
         }
+        buffer[bufferLength++] = uint8;
         position++;
     }
 
+    void FileDataWriteStream::flush() {
+        if (bufferLength == 0) {
+            return;
+        }
+        stream.write(reinterpret_cast<const char *>(buffer.data()), static_cast<std::streamsize>(bufferLength));
+        bufferLength = 0;
+        if (stream.bad()) {
+            RAISE_EXCEPTION(StreamWriteException, "Failed to write to ofstream");
+        }
+    }
 
     void FileDataWriteStream::seek(uint64_t newPosition) {
         // This must be met, or we can only open 4 GB files, which would be terrible
         static_assert(sizeof(uint64_t) <= sizeof(std::ofstream::pos_type));
+        flush();
         stream.seekp(newPosition);
         position = newPosition;
         if (stream.bad()) {
@@ -37,6 +49,7 @@ namespace Stream {
     void FileDataWriteStream::skip(uint64_t offset) {
         // This must be met, or we can only open 4 GB files, which would be terrible
         static_assert(sizeof(uint64_t) <= sizeof(std::ofstream::pos_type));
+        flush();
         stream.seekp(static_cast<std::ofstream::pos_type>(offset), std::ios::end);
         position += offset;
         if (stream.bad()) {
@@ -47,7 +60,8 @@ namespace Stream {
 
     FileDataWriteStream::FileDataWriteStream(const std::string &filePath) : AbstractDataWriteStream(-1, 0),
                                                                             stream(OpenStream(filePath)),
-                                                                            filePath(filePath) {
+                                                                            filePath(filePath),
+                                                                            buffer(WRITE_BUFFER_SIZE) {
     }
 
     std::unique_ptr<FileDataWriteStream> FileDataWriteStream::Open(const std::string &filePath) {
@@ -55,32 +69,56 @@ namespace Stream {
     }
 
     std::pair<size_t, size_t> FileDataWriteStream::writeStreamContents(const std::shared_ptr<DataReadStream> &inputStream) {
+        // Read straight into the write buffer, so that the data is copied in large chunks
         size_t nWritten = 0;
         while (inputStream->hasRemaining()) {
-            writeUint8(inputStream->readUint8());
-            nWritten++;
+            if (bufferLength == buffer.size()) {
+                flush();
+            }
+            size_t nRead = inputStream->read(buffer.data() + bufferLength, buffer.size() - bufferLength);
+            if (nRead == 0) {
+                break;
+            }
+            bufferLength += nRead;
+            position += nRead;
+            nWritten += nRead;
         }
         return {nWritten, nWritten};
     }
 
-    void FileDataWriteStream::writeBuffer(const uint8_t *buffer, size_t size) {
-        // This must be met, or we can only open 4 GB files, which would be terrible
-        static_assert(sizeof(uint64_t) <= sizeof(std::ofstream::pos_type));
-        stream.write(reinterpret_cast<const char *>(buffer), static_cast<std::streamsize>(size));
-        if (stream.bad()) {
-            RAISE_EXCEPTION(StreamWriteException, "Failed to write to ofstream");
+    void FileDataWriteStream::writeBuffer(const uint8_t *sourceBuffer, size_t size) {
+        if (size >= buffer.size()) {
+            // Buffering would only add a copy
+            flush();
+            stream.write(reinterpret_cast<const char *>(sourceBuffer), static_cast<std::streamsize>(size));
+            if (stream.bad()) {
+                RAISE_EXCEPTION(StreamWriteException, "Failed to write to ofstream");
+            }
+            position += size;
+            return;
         }
+        if (bufferLength + size > buffer.size()) {
+            flush();
+        }
+        memcpy(buffer.data() + bufferLength, sourceBuffer, size);
+        bufferLength += size;
         position += size;
     }
 
     void FileDataWriteStream::close() {
-        if (stream.is_open())
+        if (stream.is_open()) {
+            flush();
             stream.close();
+        }
         position = 0;
     }
 
     FileDataWriteStream::~FileDataWriteStream() {
-        close();
+        try {
+            close();
+        } catch (const StreamWriteException &) {
+            // Destructors must not throw, call close() explicitly to handle failing writes
+        }
     }
 
     const std::string &FileDataWriteStream::getFilePath() const {
@@ -0,0 +1,74 @@
+#include <Stream/HashingDataStream.hpp>
+#include <ErrorHandling/IllegalStateException.hpp>
+
+using namespace Stream;
+
+HashingReadStream::HashingReadStream(std::shared_ptr<DataReadStream> source)
+        : AbstractDataReadStream(source->getLength(), source->getPosition()), source(std::move(source)) {
+}
+
+uint8_t HashingReadStream::readUint8() {
+    uint8_t uint8 = source->readUint8();
+    hash.update(&uint8, 1);
+    position++;
+    return uint8;
+}
+
+size_t HashingReadStream::read(uint8_t *buffer, size_t bufferLength) {
+    size_t nRead = source->read(buffer, bufferLength);
+    hash.update(buffer, nRead);
+    position += nRead;
+    return nRead;
+}
+
+void HashingReadStream::seek(uint64_t newPosition) {
+    RAISE_EXCEPTION(errorhandling::IllegalStateException,
+                    "Failed to seek in HashingReadStream: seek is not supported");
+}
+
+void HashingReadStream::skip(uint64_t offset) {
+    RAISE_EXCEPTION(errorhandling::IllegalStateException,
+                    "Failed to skip in HashingReadStream: skip is not supported");
+}
+
+bool HashingReadStream::hasRemaining() const {
+    return source->hasRemaining();
+}
+
+uint64_t HashingReadStream::getHash() const {
+    return hash.digest();
+}
+
+HashingWriteStream::HashingWriteStream(std::shared_ptr<DataWriteStream> sink)
+        : AbstractDataWriteStream(-1, 0), sink(std::move(sink)) {
+}
+
+void HashingWriteStream::seek(uint64_t newPosition) {
+    RAISE_EXCEPTION(errorhandling::IllegalStateException,
+                    "Failed to seek in HashingWriteStream: seek is not supported");
+}
+
+void HashingWriteStream::skip(uint64_t offset) {
+    RAISE_EXCEPTION(errorhandling::IllegalStateException,
+                    "Failed to skip in HashingWriteStream: skip is not supported");
+}
+
+void HashingWriteStream::writeUint8(uint8_t uint8) {
+    sink->writeUint8(uint8);
+    hash.update(&uint8, 1);
+    position++;
+}
+
+void HashingWriteStream::writeBuffer(const uint8_t *buffer, size_t bufferSize) {
+    sink->writeBuffer(buffer, bufferSize);
+    hash.update(buffer, bufferSize);
+    position += bufferSize;
+}
+
+std::pair<size_t, size_t> HashingWriteStream::writeStreamContents(const std::shared_ptr<DataReadStream> &stream) {
+    return copyStreamContents(stream);
+}
+
+uint64_t HashingWriteStream::getHash() const {
+    return hash.digest();
+}
@@ -0,0 +1,240 @@
+#include <Stream/IoUringBatchReader.hpp>
+
+#ifdef DYNGINE_STREAM_IO_URING
+
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+using namespace Stream;
+
+// Number of submission queue entries, which bounds the number of reads in flight
+#define IO_URING_ENTRIES 256
+
+static int IoUringSetup(unsigned entries, io_uring_params *params) {
+    return static_cast<int>(syscall(__NR_io_uring_setup, entries, params));
+}
+
+static int IoUringEnter(int ringFileDescriptor, unsigned toSubmit, unsigned minComplete, unsigned flags) {
+    return static_cast<int>(syscall(__NR_io_uring_enter, ringFileDescriptor, toSubmit, minComplete, flags, nullptr,
+                                    0));
+}
+
+static void *MapRing(int ringFileDescriptor, size_t size, off_t offset) {
+    void *ring = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFileDescriptor, offset);
+    return ring == MAP_FAILED ? nullptr : ring;
+}
+
+std::unique_ptr<IoUringBatchReader> IoUringBatchReader::TryOpen(const std::string &filePath) {
+    std::unique_ptr<IoUringBatchReader> reader(new IoUringBatchReader());
+    reader->filePath = filePath;
+
+    io_uring_params params{};
+    reader->ringFileDescriptor = IoUringSetup(IO_URING_ENTRIES, &params);
+    if (reader->ringFileDescriptor < 0) {
+        // Not supported by the kernel, or forbidden by a seccomp policy
+        return nullptr;
+    }
+    reader->nEntries = params.sq_entries;
+
+    reader->submissionRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    reader->completionRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    bool singleMap = false;
+#ifdef IORING_FEAT_SINGLE_MMAP
+    singleMap = params.features & IORING_FEAT_SINGLE_MMAP;
+#endif
+    if (singleMap) {
+        reader->submissionRingSize = std::max(reader->submissionRingSize, reader->completionRingSize);
+    }
+    reader->submissionRing = MapRing(reader->ringFileDescriptor, reader->submissionRingSize, IORING_OFF_SQ_RING);
+    if (reader->submissionRing == nullptr) {
+        return nullptr;
+    }
+    if (singleMap) {
+        reader->completionRing = reader->submissionRing;
+    } else {
+        reader->completionRing = MapRing(reader->ringFileDescriptor, reader->completionRingSize, IORING_OFF_CQ_RING);
+        if (reader->completionRing == nullptr) {
+            return nullptr;
+        }
+    }
+    reader->submissionEntriesSize = params.sq_entries * sizeof(io_uring_sqe);
+    reader->submissionEntries = reinterpret_cast<io_uring_sqe *>(
+            MapRing(reader->ringFileDescriptor, reader->submissionEntriesSize, IORING_OFF_SQES));
+    if (reader->submissionEntries == nullptr) {
+        return nullptr;
+    }
+
+    auto *submissionBase = reinterpret_cast<uint8_t *>(reader->submissionRing);
+    reader->submissionHead = reinterpret_cast<unsigned *>(submissionBase + params.sq_off.head);
+    reader->submissionTail = reinterpret_cast<unsigned *>(submissionBase + params.sq_off.tail);
+    reader->submissionMask = reinterpret_cast<unsigned *>(submissionBase + params.sq_off.ring_mask);
+    reader->submissionArray = reinterpret_cast<unsigned *>(submissionBase + params.sq_off.array);
+    auto *completionBase = reinterpret_cast<uint8_t *>(reader->completionRing);
+    reader->completionHead = reinterpret_cast<unsigned *>(completionBase + params.cq_off.head);
+    reader->completionTail = reinterpret_cast<unsigned *>(completionBase + params.cq_off.tail);
+    reader->completionMask = reinterpret_cast<unsigned *>(completionBase + params.cq_off.ring_mask);
+    reader->completionEntries = reinterpret_cast<io_uring_cqe *>(completionBase + params.cq_off.cqes);
+
+    reader->fileDescriptor = open(filePath.c_str(), O_RDONLY | O_CLOEXEC);
+    if (reader->fileDescriptor < 0) {
+        RAISE_EXCEPTION(BatchReaderOpenFailedException,
+                        "Failed to open BatchReader for path: \"" + filePath + "\": open failed");
+    }
+    return reader;
+}
+
+void IoUringBatchReader::close() {
+    if (submissionEntries != nullptr) {
+        munmap(submissionEntries, submissionEntriesSize);
+        submissionEntries = nullptr;
+    }
+    if (completionRing != nullptr && completionRing != submissionRing) {
+        munmap(completionRing, completionRingSize);
+    }
+    completionRing = nullptr;
+    if (submissionRing != nullptr) {
+        munmap(submissionRing, submissionRingSize);
+        submissionRing = nullptr;
+    }
+    if (ringFileDescriptor >= 0) {
+        ::close(ringFileDescriptor);
+        ringFileDescriptor = -1;
+    }
+    if (fileDescriptor >= 0) {
+        ::close(fileDescriptor);
+        fileDescriptor = -1;
+    }
+}
+
+IoUringBatchReader::~IoUringBatchReader() {
+    close();
+}
+
+void IoUringBatchReader::read(const std::vector<ReadRequest> &requests) {
+    if (ringFileDescriptor < 0) {
+        RAISE_EXCEPTION(BatchReadFailedException,
+                        "Failed to read from \"" + filePath + "\": the ring was closed after an earlier failure");
+    }
+    // A request can complete with a short read, in which case the rest of it is submitted again
+    std::vector<iovec> remainingRanges(requests.size());
+    for (size_t i = 0; i < requests.size(); i++) {
+        remainingRanges[i] = {requests[i].buffer, requests[i].length};
+    }
+
+    size_t nextRequest = 0;
+    size_t nInFlight = 0;
+    // Queued behind the tail but not yet consumed by the kernel, submitted again if io_uring_enter is interrupted
+    unsigned nUnsubmitted = 0;
+    std::vector<size_t> resubmit;
+    bool failed = false;
+    std::string failure;
+    while (nextRequest < requests.size() || !resubmit.empty() || nInFlight > 0) {
+        // Fill the submission queue. Only this thread writes the tail.
+        unsigned tail = *submissionTail;
+        while (!failed && nInFlight < nEntries && (!resubmit.empty() || nextRequest < requests.size())) {
+            size_t requestIndex;
+            if (!resubmit.empty()) {
+                requestIndex = resubmit.back();
+                resubmit.pop_back();
+            } else {
+                requestIndex = nextRequest++;
+            }
+            const iovec &range = remainingRanges[requestIndex];
+            if (range.iov_len == 0) {
+                continue;
+            }
+            size_t nRead = requests[requestIndex].length - range.iov_len;
+            unsigned index = tail & *submissionMask;
+            io_uring_sqe &entry = submissionEntries[index];
+            memset(&entry, 0, sizeof(entry));
+            // READV is supported since io_uring was introduced, unlike READ
+            entry.opcode = IORING_OP_READV;
+            entry.fd = fileDescriptor;
+            entry.off = requests[requestIndex].offset + nRead;
+            entry.addr = reinterpret_cast<uint64_t>(&remainingRanges[requestIndex]);
+            entry.len = 1;
+            entry.user_data = requestIndex;
+            submissionArray[index] = index;
+            tail++;
+            nUnsubmitted++;
+            nInFlight++;
+        }
+        __atomic_store_n(submissionTail, tail, __ATOMIC_RELEASE);
+        if (nInFlight == 0) {
+            break;
+        }
+
+        int nSubmitted = IoUringEnter(ringFileDescriptor, nUnsubmitted, 1, IORING_ENTER_GETEVENTS);
+        if (nSubmitted >= 0) {
+            nUnsubmitted -= std::min(nUnsubmitted, static_cast<unsigned>(nSubmitted));
+        } else if (errno != EINTR && errno != EAGAIN && errno != EBUSY) {
+            int error = errno;
+            if (!failed) {
+                failed = true;
+                failure = "Failed to read from \"" + filePath + "\": io_uring_enter failed with errno " +
+                          std::to_string(error);
+            }
+            if (nUnsubmitted == 0) {
+                // Only waiting for reads in flight failed, so they can't be drained. Closing the ring leaves them
+                // to the kernel to cancel, and keeps later calls from taking their completions.
+                close();
+                RAISE_EXCEPTION(BatchReadFailedException, failure);
+            }
+            // The entries the kernel did not consume point into remainingRanges, which is freed once this call
+            // returns, so they are taken back instead of being submitted by the next call. Afterwards only the reads
+            // in flight are waited for.
+            tail -= nUnsubmitted;
+            __atomic_store_n(submissionTail, tail, __ATOMIC_RELEASE);
+            nInFlight -= nUnsubmitted;
+            nUnsubmitted = 0;
+            resubmit.clear();
+            nextRequest = requests.size();
+            continue;
+        }
+
+        unsigned head = *completionHead;
+        while (head != __atomic_load_n(completionTail, __ATOMIC_ACQUIRE)) {
+            const io_uring_cqe &completion = completionEntries[head & *completionMask];
+            auto requestIndex = static_cast<size_t>(completion.user_data);
+            nInFlight--;
+            head++;
+            if (completion.res == -EINTR || completion.res == -EAGAIN) {
+                resubmit.push_back(requestIndex);
+            } else if (completion.res <= 0 && !failed) {
+                // Reads in flight still write to the buffers, so wait for them before raising
+                failed = true;
+                failure = completion.res == 0 ? "end of file" : "errno " + std::to_string(-completion.res);
+                failure = "Failed to read " + std::to_string(requests[requestIndex].length) + " bytes at offset " +
+                          std::to_string(requests[requestIndex].offset) + " from \"" + filePath + "\": " + failure;
+            } else if (completion.res > 0) {
+                iovec &range = remainingRanges[requestIndex];
+                range.iov_base = reinterpret_cast<uint8_t *>(range.iov_base) + completion.res;
+                range.iov_len -= completion.res;
+                if (range.iov_len > 0) {
+                    resubmit.push_back(requestIndex);
+                }
+            }
+        }
+        __atomic_store_n(completionHead, head, __ATOMIC_RELEASE);
+        if (failed) {
+            resubmit.clear();
+            nextRequest = requests.size();
+        }
+    }
+    if (failed) {
+        RAISE_EXCEPTION(BatchReadFailedException, failure);
+    }
+}
+
+BatchReaderBackend IoUringBatchReader::getBackend() const {
+    return BatchReaderBackend::IO_URING;
+}
+
+#endif
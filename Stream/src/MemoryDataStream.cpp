@@ -1,10 +1,16 @@
 #include <Stream/MemoryDataStream.hpp>
+#include <Stream/StreamExcept.hpp>
+#include <Stream/ByteSwap.hpp>
+#include <ErrorHandling/IllegalStateException.hpp>
+#include <algorithm>
+#include <cstring>
 #include <string>
 
 using namespace Stream;
 
 MemoryReadStream::MemoryReadStream(const uint8_t *memory, size_t size, bool copyMemory)
-        : AbstractDataReadStream(size, 0) {
+        : AbstractDataReadStream(size, 0), ownsMemory(copyMemory) {
+    STREAM_STATISTICS_REGISTER("MemoryReadStream");
     if (copyMemory) {
         this->memory = new uint8_t[size];
         memcpy(const_cast<uint8_t *>(this->memory), memory, size);
@@ -22,16 +28,25 @@ std::unique_ptr<MemoryReadStream> MemoryReadStream::Wrap(const uint8_t *memory,
 }
 
 #define CHECK_POSITION(neededCapacity) \
-if (position + (neededCapacity) > size)  \
+if ((neededCapacity) > size - position)  \
 RAISE_EXCEPTION(StreamUnderflowException, "Tried to read from an exhausted buffer")
 
 uint8_t MemoryReadStream::readUint8() {
     CHECK_POSITION(1);
+    STREAM_STATISTICS_COUNT_BYTES(UINT8, 1);
     uint8_t uint8 = memory[position];
     position++;
     return uint8;
 }
 
+size_t MemoryReadStream::read(uint8_t *buffer, size_t bufferLength) {
+    size_t nRead = std::min<uint64_t>(bufferLength, size - position);
+    memcpy(buffer, memory + position, nRead);
+    STREAM_STATISTICS_BYTES(nRead);
+    position += nRead;
+    return nRead;
+}
+
 void MemoryReadStream::seek(uint64_t newPosition) {
     if (newPosition >= size) {
         RAISE_EXCEPTION(StreamUnderflowException,
@@ -39,6 +54,7 @@ void MemoryReadStream::seek(uint64_t newPosition) {
                         std::to_string(size)
         );
     }
+    STREAM_STATISTICS_ADD(seeks, 1);
     position = newPosition;
 }
 
@@ -51,9 +67,219 @@ void MemoryReadStream::skip(uint64_t offset) {
                         std::to_string(size)
         );
     }
+    STREAM_STATISTICS_ADD(seeks, 1);
     position = newPosition;
 }
 
 MemoryReadStream::~MemoryReadStream() {
-    delete[] memory;
-}
\ No newline at end of file
+    if (ownsMemory) {
+        delete[] memory;
+    }
+}
+
+// Smallest capacity a growable MemoryWriteStream allocates
+#define MEMORY_WRITE_STREAM_MIN_CAPACITY 64
+
+// Size of the chunks MemoryWriteStream::writeStreamContents reads into a growable stream
+#define MEMORY_WRITE_STREAM_CHUNK_SIZE 65536
+
+MemoryWriteStream::MemoryWriteStream(size_t initialCapacity) : AbstractDataWriteStream(-1, 0),
+                                                               buffer(initialCapacity),
+                                                               memory(buffer.data()),
+                                                               capacity(initialCapacity),
+                                                               fixed(false) {
+}
+
+MemoryWriteStream::MemoryWriteStream(uint8_t *memory, size_t size) : AbstractDataWriteStream(size, 0),
+                                                                     memory(memory),
+                                                                     capacity(size),
+                                                                     fixed(true) {
+}
+
+std::unique_ptr<MemoryWriteStream> MemoryWriteStream::Growable(size_t initialCapacity) {
+    return std::make_unique<MemoryWriteStream>(initialCapacity);
+}
+
+std::unique_ptr<MemoryWriteStream> MemoryWriteStream::Wrap(uint8_t *memory, size_t size) {
+    return std::make_unique<MemoryWriteStream>(memory, size);
+}
+
+void MemoryWriteStream::ensureCapacity(uint64_t neededCapacity) {
+    if (neededCapacity <= capacity) {
+        return;
+    }
+    if (fixed) {
+        RAISE_EXCEPTION(StreamOverflowException,
+                        "Tried to write " + std::to_string(neededCapacity) + " bytes to memory of size " +
+                        std::to_string(capacity));
+    }
+    // Grow geometrically, so that writing n bytes takes amortized O(n)
+    size_t newCapacity = std::max<size_t>(capacity * 2, MEMORY_WRITE_STREAM_MIN_CAPACITY);
+    newCapacity = std::max<size_t>(newCapacity, neededCapacity);
+    buffer.resize(newCapacity);
+    memory = buffer.data();
+    capacity = newCapacity;
+}
+
+uint8_t *MemoryWriteStream::allocate(size_t nBytes) {
+    ensureCapacity(position + nBytes);
+    uint8_t *destination = memory + position;
+    position += nBytes;
+    length = std::max(length, position);
+    return destination;
+}
+
+void MemoryWriteStream::reserve(size_t newCapacity) {
+    if (fixed && newCapacity > capacity) {
+        RAISE_EXCEPTION(StreamOverflowException,
+                        "Tried to reserve " + std::to_string(newCapacity) + " bytes in memory of size " +
+                        std::to_string(capacity));
+    }
+    if (newCapacity > capacity) {
+        buffer.resize(newCapacity);
+        memory = buffer.data();
+        capacity = newCapacity;
+    }
+}
+
+std::vector<uint8_t> MemoryWriteStream::releaseBuffer() {
+    if (fixed) {
+        RAISE_EXCEPTION(errorhandling::IllegalStateException,
+                        "Can not release the buffer of a MemoryWriteStream writing to caller supplied memory");
+    }
+    buffer.resize(length);
+    std::vector<uint8_t> released = std::move(buffer);
+    buffer = {};
+    memory = nullptr;
+    capacity = 0;
+    position = 0;
+    length = 0;
+    return released;
+}
+
+const uint8_t *MemoryWriteStream::getData() const {
+    return memory;
+}
+
+uint64_t MemoryWriteStream::getLength() const {
+    return length;
+}
+
+void MemoryWriteStream::seek(uint64_t newPosition) {
+    if (fixed && newPosition > capacity) {
+        RAISE_EXCEPTION(StreamSeekException,
+                        "Failed to seek to position " + std::to_string(newPosition) + ", which exceeds memory size " +
+                        std::to_string(capacity)
+        );
+    }
+    position = newPosition;
+}
+
+void MemoryWriteStream::skip(uint64_t offset) {
+    seek(position + offset);
+}
+
+void MemoryWriteStream::writeUint8(uint8_t uint8) {
+    *allocate(1) = uint8;
+}
+
+void MemoryWriteStream::writeInt8(int8_t int8) {
+    *allocate(1) = static_cast<uint8_t>(int8);
+}
+
+void MemoryWriteStream::writeUint16(uint16_t uint16) {
+    StoreValue(allocate(sizeof(uint16)), uint16, byteOrder);
+}
+
+void MemoryWriteStream::writeInt16(int16_t int16) {
+    StoreValue(allocate(sizeof(int16)), int16, byteOrder);
+}
+
+void MemoryWriteStream::writeUint32(uint32_t uint32) {
+    StoreValue(allocate(sizeof(uint32)), uint32, byteOrder);
+}
+
+void MemoryWriteStream::writeInt32(int32_t int32) {
+    StoreValue(allocate(sizeof(int32)), int32, byteOrder);
+}
+
+void MemoryWriteStream::writeUint64(uint64_t uint64) {
+    StoreValue(allocate(sizeof(uint64)), uint64, byteOrder);
+}
+
+void MemoryWriteStream::writeInt64(int64_t int64) {
+    StoreValue(allocate(sizeof(int64)), int64, byteOrder);
+}
+
+void MemoryWriteStream::writeFloat32(float f32) {
+    static_assert(sizeof(float) == 4, "float is not 4 bytes");
+    StoreValue(allocate(sizeof(f32)), f32, byteOrder);
+}
+
+void MemoryWriteStream::writeString(const std::string &string) {
+    writeUint64(string.length());
+    writeBuffer(reinterpret_cast<const uint8_t *>(string.data()), string.length());
+}
+
+void MemoryWriteStream::writeFixedString(const std::string &string, size_t fixedLength) {
+    size_t strSize = string.length();
+    if (strSize > fixedLength) {
+        RAISE_EXCEPTION(StreamOverflowException, "Tried to write a string with more characters than the fixed length");
+    }
+    uint8_t *destination = allocate(fixedLength);
+    memcpy(destination, string.data(), strSize);
+    memset(destination + strSize, 0, fixedLength - strSize);
+}
+
+void MemoryWriteStream::writeBuffer(const uint8_t *sourceBuffer, size_t sourceSize) {
+    if (sourceSize == 0) {
+        return;
+    }
+    memcpy(allocate(sourceSize), sourceBuffer, sourceSize);
+}
+
+// Arrays are swapped straight into the memory of the stream
+
+void MemoryWriteStream::writeUint16Array(const uint16_t *values, size_t n) {
+    if (byteOrder == HostByteOrder()) {
+        writeBuffer(reinterpret_cast<const uint8_t *>(values), n * sizeof(uint16_t));
+        return;
+    }
+    SwapBytes16(reinterpret_cast<const uint8_t *>(values), allocate(n * sizeof(uint16_t)), n);
+}
+
+void MemoryWriteStream::writeUint32Array(const uint32_t *values, size_t n) {
+    if (byteOrder == HostByteOrder()) {
+        writeBuffer(reinterpret_cast<const uint8_t *>(values), n * sizeof(uint32_t));
+        return;
+    }
+    SwapBytes32(reinterpret_cast<const uint8_t *>(values), allocate(n * sizeof(uint32_t)), n);
+}
+
+void MemoryWriteStream::writeFloat32Array(const float *values, size_t n) {
+    if (byteOrder == HostByteOrder()) {
+        writeBuffer(reinterpret_cast<const uint8_t *>(values), n * sizeof(float));
+        return;
+    }
+    SwapBytes32(reinterpret_cast<const uint8_t *>(values), allocate(n * sizeof(float)), n);
+}
+
+std::pair<size_t, size_t> MemoryWriteStream::writeStreamContents(const std::shared_ptr<DataReadStream> &stream) {
+    size_t nWritten = 0;
+    while (stream->hasRemaining()) {
+        size_t chunkSize = fixed ? capacity - position : MEMORY_WRITE_STREAM_CHUNK_SIZE;
+        if (chunkSize == 0) {
+            RAISE_EXCEPTION(StreamOverflowException,
+                            "Tried to write a stream exceeding the memory size " + std::to_string(capacity));
+        }
+        ensureCapacity(position + chunkSize);
+        size_t nRead = stream->read(memory + position, chunkSize);
+        if (nRead == 0) {
+            break;
+        }
+        position += nRead;
+        length = std::max(length, position);
+        nWritten += nRead;
+    }
+    return {nWritten, nWritten};
+}
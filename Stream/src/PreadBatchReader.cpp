@@ -0,0 +1,82 @@
+#include <Stream/PreadBatchReader.hpp>
+#include <Utils/ParallelJobs.hpp>
+#include <algorithm>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+using namespace Stream;
+
+PreadBatchReader::PreadBatchReader(const std::string &filePath) : filePath(filePath) {
+#ifdef _WIN32
+    fileHandle = CreateFileA(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                             FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (fileHandle == INVALID_HANDLE_VALUE) {
+        RAISE_EXCEPTION(BatchReaderOpenFailedException,
+                        "Failed to open BatchReader for path: \"" + filePath + "\": CreateFile failed");
+    }
+#else
+    fileDescriptor = open(filePath.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fileDescriptor < 0) {
+        RAISE_EXCEPTION(BatchReaderOpenFailedException,
+                        "Failed to open BatchReader for path: \"" + filePath + "\": open failed");
+    }
+#endif
+}
+
+PreadBatchReader::~PreadBatchReader() {
+#ifdef _WIN32
+    CloseHandle(fileHandle);
+#else
+    ::close(fileDescriptor);
+#endif
+}
+
+void PreadBatchReader::readRange(const ReadRequest &request) {
+    size_t nRead = 0;
+    while (nRead < request.length) {
+        size_t remaining = request.length - nRead;
+        uint64_t offset = request.offset + nRead;
+#ifdef _WIN32
+        OVERLAPPED overlapped{};
+        overlapped.Offset = static_cast<DWORD>(offset);
+        overlapped.OffsetHigh = static_cast<DWORD>(offset >> 32);
+        DWORD nReadNow = 0;
+        auto nToRead = static_cast<DWORD>(std::min<size_t>(remaining, MAXDWORD));
+        if (!ReadFile(fileHandle, request.buffer + nRead, nToRead, &nReadNow, &overlapped) &&
+            GetLastError() != ERROR_HANDLE_EOF) {
+            RAISE_EXCEPTION(BatchReadFailedException, "Failed to read from \"" + filePath + "\": ReadFile failed");
+        }
+#else
+        ssize_t nReadNow = pread(fileDescriptor, request.buffer + nRead, remaining, static_cast<off_t>(offset));
+        if (nReadNow < 0 && errno == EINTR) {
+            continue;
+        }
+        if (nReadNow < 0) {
+            RAISE_EXCEPTION(BatchReadFailedException, "Failed to read from \"" + filePath + "\": pread failed");
+        }
+#endif
+        if (nReadNow == 0) {
+            RAISE_EXCEPTION(BatchReadFailedException,
+                            "Failed to read " + std::to_string(request.length) + " bytes at offset " +
+                            std::to_string(request.offset) + " from \"" + filePath + "\": end of file");
+        }
+        nRead += nReadNow;
+    }
+}
+
+void PreadBatchReader::read(const std::vector<ReadRequest> &requests) {
+    ParallelJobs::Run(requests.size(), [&](size_t i) {
+        readRange(requests[i]);
+    });
+}
+
+BatchReaderBackend PreadBatchReader::getBackend() const {
+    return BatchReaderBackend::PREAD;
+}
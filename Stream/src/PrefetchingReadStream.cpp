@@ -0,0 +1,154 @@
+#include <Stream/PrefetchingReadStream.hpp>
+#include <ErrorHandling/IllegalArgumentException.hpp>
+#include <algorithm>
+#include <cstring>
+
+using namespace Stream;
+
+PrefetchingReadStream::PrefetchingReadStream(std::shared_ptr<DataReadStream> source, size_t depth, size_t chunkSize)
+        : AbstractDataReadStream(source->getLength(), source->getPosition()),
+          source(std::move(source)),
+          chunkSize(chunkSize),
+          chunks(depth, std::vector<uint8_t>(chunkSize)),
+          chunkLengths(depth) {
+    if (depth == 0 || chunkSize == 0) {
+        RAISE_EXCEPTION(errorhandling::IllegalArgumentException,
+                        "PrefetchingReadStream needs a depth and chunk size of at least 1");
+    }
+    STREAM_STATISTICS_REGISTER("PrefetchingReadStream");
+    start();
+}
+
+PrefetchingReadStream::~PrefetchingReadStream() {
+    stop();
+}
+
+void PrefetchingReadStream::start() {
+    readChunkIndex = 0;
+    readOffset = 0;
+    writeChunkIndex = 0;
+    nFilledChunks = 0;
+    sourceExhausted = false;
+    cancelled = false;
+    sourceException = nullptr;
+    prefetchThread = std::thread(&PrefetchingReadStream::prefetch, this);
+}
+
+void PrefetchingReadStream::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        cancelled = true;
+    }
+    chunkReleased.notify_all();
+    if (prefetchThread.joinable()) {
+        prefetchThread.join();
+    }
+}
+
+void PrefetchingReadStream::prefetch() {
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            chunkReleased.wait(lock, [this] { return cancelled || nFilledChunks < chunks.size(); });
+            if (cancelled) {
+                return;
+            }
+        }
+
+        // The chunk at writeChunkIndex is not visible to the consumer until it is counted as filled
+        size_t nRead;
+        try {
+            STREAM_STATISTICS_ADD(refills, 1);
+            STREAM_STATISTICS_TIME(sourceNanoseconds);
+            nRead = source->read(chunks[writeChunkIndex].data(), chunkSize);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(mutex);
+            sourceException = std::current_exception();
+            sourceExhausted = true;
+            chunkFilled.notify_all();
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (nRead == 0) {
+            sourceExhausted = true;
+            chunkFilled.notify_all();
+            return;
+        }
+        chunkLengths[writeChunkIndex] = nRead;
+        writeChunkIndex = (writeChunkIndex + 1) % chunks.size();
+        nFilledChunks++;
+        chunkFilled.notify_all();
+    }
+}
+
+bool PrefetchingReadStream::waitForChunk() const {
+    std::unique_lock<std::mutex> lock(mutex);
+    chunkFilled.wait(lock, [this] { return nFilledChunks > 0 || sourceExhausted; });
+    if (nFilledChunks > 0) {
+        return true;
+    }
+    if (sourceException) {
+        std::rethrow_exception(sourceException);
+    }
+    return false;
+}
+
+void PrefetchingReadStream::releaseChunk() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        nFilledChunks--;
+    }
+    chunkReleased.notify_all();
+    readChunkIndex = (readChunkIndex + 1) % chunks.size();
+    readOffset = 0;
+}
+
+uint8_t PrefetchingReadStream::readUint8() {
+    // A partially read chunk is still filled, so only the first byte of a chunk needs to wait
+    if (readOffset == 0 && !waitForChunk()) {
+        RAISE_EXCEPTION(StreamUnderflowException, "Tried to read from an exhausted stream");
+    }
+    uint8_t uint8 = chunks[readChunkIndex][readOffset++];
+    if (readOffset == chunkLengths[readChunkIndex]) {
+        releaseChunk();
+    }
+    position++;
+    STREAM_STATISTICS_COUNT_BYTES(UINT8, 1);
+    return uint8;
+}
+
+size_t PrefetchingReadStream::read(uint8_t *buffer, size_t bufferLength) {
+    size_t nRead = 0;
+    while (nRead < bufferLength && (readOffset != 0 || waitForChunk())) {
+        size_t nCopied = std::min(chunkLengths[readChunkIndex] - readOffset, bufferLength - nRead);
+        memcpy(buffer + nRead, chunks[readChunkIndex].data() + readOffset, nCopied);
+        readOffset += nCopied;
+        nRead += nCopied;
+        if (readOffset == chunkLengths[readChunkIndex]) {
+            releaseChunk();
+        }
+    }
+    position += nRead;
+    STREAM_STATISTICS_BYTES(nRead);
+    return nRead;
+}
+
+void PrefetchingReadStream::seek(uint64_t newPosition) {
+    stop();
+    STREAM_STATISTICS_ADD(seeks, 1);
+    source->seek(newPosition);
+    position = newPosition;
+    start();
+}
+
+void PrefetchingReadStream::skip(uint64_t offset) {
+    seek(position + offset);
+}
+
+bool PrefetchingReadStream::hasRemaining() const {
+    if (size != -1) {
+        return (position - startPosition) < size;
+    }
+    return readOffset != 0 || waitForChunk();
+}
@@ -0,0 +1,173 @@
+#include <Stream/StatisticsReadStream.hpp>
+
+using namespace Stream;
+
+StatisticsReadStream::StatisticsReadStream(std::shared_ptr<DataReadStream> source, const std::string &name)
+        : AbstractDataReadStream(source->getLength(), source->getPosition()), source(std::move(source)) {
+    statistics = StreamStatisticsRegistry::Register(name);
+}
+
+template<typename T>
+static T CountValue(StreamStatistics &statistics, StreamOperation operation, T value) {
+    statistics.count(operation);
+    statistics.countBytes(sizeof(T));
+    return value;
+}
+
+template<typename T>
+static bool CountTryRead(StreamStatistics &statistics, StreamOperation operation, bool success) {
+    statistics.count(operation);
+    if (success) {
+        statistics.countBytes(sizeof(T));
+    }
+    return success;
+}
+
+uint8_t StatisticsReadStream::readUint8() {
+    return CountValue(*statistics, StreamOperation::UINT8, source->readUint8());
+}
+
+int8_t StatisticsReadStream::readInt8() {
+    return CountValue(*statistics, StreamOperation::INT8, source->readInt8());
+}
+
+uint16_t StatisticsReadStream::readUint16() {
+    return CountValue(*statistics, StreamOperation::UINT16, source->readUint16());
+}
+
+int16_t StatisticsReadStream::readInt16() {
+    return CountValue(*statistics, StreamOperation::INT16, source->readInt16());
+}
+
+uint32_t StatisticsReadStream::readUint32() {
+    return CountValue(*statistics, StreamOperation::UINT32, source->readUint32());
+}
+
+int32_t StatisticsReadStream::readInt32() {
+    return CountValue(*statistics, StreamOperation::INT32, source->readInt32());
+}
+
+uint64_t StatisticsReadStream::readUint64() {
+    return CountValue(*statistics, StreamOperation::UINT64, source->readUint64());
+}
+
+int64_t StatisticsReadStream::readInt64() {
+    return CountValue(*statistics, StreamOperation::INT64, source->readInt64());
+}
+
+float StatisticsReadStream::readFloat32() {
+    return CountValue(*statistics, StreamOperation::FLOAT32, source->readFloat32());
+}
+
+std::string StatisticsReadStream::readString() {
+    statistics->count(StreamOperation::STRING);
+    uint64_t start = source->getPosition();
+    std::string string = source->readString();
+    statistics->countBytes(source->getPosition() - start);
+    return string;
+}
+
+std::string StatisticsReadStream::readFixedString(size_t length) {
+    statistics->count(StreamOperation::FIXED_STRING);
+    uint64_t start = source->getPosition();
+    std::string string = source->readFixedString(length);
+    statistics->countBytes(source->getPosition() - start);
+    return string;
+}
+
+size_t StatisticsReadStream::read(uint8_t *buffer, size_t bufferLength) {
+    statistics->count(StreamOperation::READ);
+    ScopedStreamTimer timer(&statistics->sourceNanoseconds);
+    size_t nRead = source->read(buffer, bufferLength);
+    statistics->countBytes(nRead);
+    return nRead;
+}
+
+bool StatisticsReadStream::tryReadUint8(uint8_t &value) {
+    return CountTryRead<uint8_t>(*statistics, StreamOperation::UINT8, source->tryReadUint8(value));
+}
+
+bool StatisticsReadStream::tryReadInt8(int8_t &value) {
+    return CountTryRead<int8_t>(*statistics, StreamOperation::INT8, source->tryReadInt8(value));
+}
+
+bool StatisticsReadStream::tryReadUint16(uint16_t &value) {
+    return CountTryRead<uint16_t>(*statistics, StreamOperation::UINT16, source->tryReadUint16(value));
+}
+
+bool StatisticsReadStream::tryReadInt16(int16_t &value) {
+    return CountTryRead<int16_t>(*statistics, StreamOperation::INT16, source->tryReadInt16(value));
+}
+
+bool StatisticsReadStream::tryReadUint32(uint32_t &value) {
+    return CountTryRead<uint32_t>(*statistics, StreamOperation::UINT32, source->tryReadUint32(value));
+}
+
+bool StatisticsReadStream::tryReadInt32(int32_t &value) {
+    return CountTryRead<int32_t>(*statistics, StreamOperation::INT32, source->tryReadInt32(value));
+}
+
+bool StatisticsReadStream::tryReadUint64(uint64_t &value) {
+    return CountTryRead<uint64_t>(*statistics, StreamOperation::UINT64, source->tryReadUint64(value));
+}
+
+bool StatisticsReadStream::tryReadInt64(int64_t &value) {
+    return CountTryRead<int64_t>(*statistics, StreamOperation::INT64, source->tryReadInt64(value));
+}
+
+bool StatisticsReadStream::tryReadFloat32(float &value) {
+    return CountTryRead<float>(*statistics, StreamOperation::FLOAT32, source->tryReadFloat32(value));
+}
+
+void StatisticsReadStream::readUint16Array(uint16_t *values, size_t n) {
+    statistics->count(StreamOperation::ARRAY);
+    ScopedStreamTimer timer(&statistics->sourceNanoseconds);
+    source->readUint16Array(values, n);
+    statistics->countBytes(n * sizeof(uint16_t));
+}
+
+void StatisticsReadStream::readUint32Array(uint32_t *values, size_t n) {
+    statistics->count(StreamOperation::ARRAY);
+    ScopedStreamTimer timer(&statistics->sourceNanoseconds);
+    source->readUint32Array(values, n);
+    statistics->countBytes(n * sizeof(uint32_t));
+}
+
+void StatisticsReadStream::readFloat32Array(float *values, size_t n) {
+    statistics->count(StreamOperation::ARRAY);
+    ScopedStreamTimer timer(&statistics->sourceNanoseconds);
+    source->readFloat32Array(values, n);
+    statistics->countBytes(n * sizeof(float));
+}
+
+bool StatisticsReadStream::hasRemaining() const {
+    return source->hasRemaining();
+}
+
+void StatisticsReadStream::seek(uint64_t newPosition) {
+    statistics->seeks.fetch_add(1, std::memory_order_relaxed);
+    ScopedStreamTimer timer(&statistics->sourceNanoseconds);
+    source->seek(newPosition);
+}
+
+void StatisticsReadStream::skip(uint64_t offset) {
+    statistics->seeks.fetch_add(1, std::memory_order_relaxed);
+    ScopedStreamTimer timer(&statistics->sourceNanoseconds);
+    source->skip(offset);
+}
+
+uint64_t StatisticsReadStream::getLength() const {
+    return source->getLength();
+}
+
+uint64_t StatisticsReadStream::getPosition() const {
+    return source->getPosition();
+}
+
+void StatisticsReadStream::setByteOrder(ByteOrder newByteOrder) {
+    source->setByteOrder(newByteOrder);
+}
+
+ByteOrder StatisticsReadStream::getByteOrder() const {
+    return source->getByteOrder();
+}
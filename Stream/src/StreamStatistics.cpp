@@ -0,0 +1,116 @@
+#include <Stream/StreamStatistics.hpp>
+#include <map>
+#include <mutex>
+
+using namespace Stream;
+
+static const char *const OPERATION_NAMES[] = {
+        "uint8", "int8", "uint16", "int16", "uint32", "int32", "uint64", "int64", "float32", "string",
+        "fixedString", "array", "read"
+};
+static_assert(sizeof(OPERATION_NAMES) / sizeof(OPERATION_NAMES[0]) == static_cast<size_t>(StreamOperation::COUNT));
+
+struct StreamStatisticsTotals {
+    uint64_t nStreams{};
+    uint64_t bytesRead{};
+    std::array<uint64_t, static_cast<size_t>(StreamOperation::COUNT)> calls{};
+    uint64_t refills{};
+    uint64_t seeks{};
+    uint64_t sourceNanoseconds{};
+    uint64_t decompressionNanoseconds{};
+
+    void add(const StreamStatistics &statistics) {
+        nStreams++;
+        bytesRead += statistics.bytesRead.load(std::memory_order_relaxed);
+        for (size_t i = 0; i < calls.size(); i++) {
+            calls[i] += statistics.calls[i].load(std::memory_order_relaxed);
+        }
+        refills += statistics.refills.load(std::memory_order_relaxed);
+        seeks += statistics.seeks.load(std::memory_order_relaxed);
+        sourceNanoseconds += statistics.sourceNanoseconds.load(std::memory_order_relaxed);
+        decompressionNanoseconds += statistics.decompressionNanoseconds.load(std::memory_order_relaxed);
+    }
+};
+
+struct Registry {
+    std::mutex mutex;
+    // Statistics of the live streams, they are removed when they are destroyed
+    std::map<const StreamStatistics *, std::weak_ptr<StreamStatistics>> liveStatistics;
+    // Totals of the destroyed streams by name
+    std::map<std::string, StreamStatisticsTotals> destroyedTotals;
+};
+
+// Never destroyed, so that streams destroyed during static destruction can still add their totals
+static Registry &GetRegistry() {
+    static auto *registry = new Registry();
+    return *registry;
+}
+
+StreamStatistics::StreamStatistics(std::string name) : name(std::move(name)) {
+}
+
+StreamStatistics::~StreamStatistics() {
+    auto &registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    // Statistics registered before the last reset don't count anymore
+    if (registry.liveStatistics.erase(this) != 0) {
+        registry.destroyedTotals[name].add(*this);
+    }
+}
+
+std::shared_ptr<StreamStatistics> StreamStatisticsRegistry::Register(const std::string &name) {
+    auto statistics = std::make_shared<StreamStatistics>(name);
+    auto &registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    registry.liveStatistics.emplace(statistics.get(), statistics);
+    return statistics;
+}
+
+std::vector<std::shared_ptr<StreamStatistics>> StreamStatisticsRegistry::GetAll() {
+    std::vector<std::shared_ptr<StreamStatistics>> all{};
+    auto &registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    for (const auto &[pointer, statistics]: registry.liveStatistics) {
+        // Expired statistics are waiting for the lock in their destructor
+        if (auto liveStatistics = statistics.lock()) {
+            all.push_back(std::move(liveStatistics));
+        }
+    }
+    return all;
+}
+
+void StreamStatisticsRegistry::Reset() {
+    auto &registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    registry.liveStatistics.clear();
+    registry.destroyedTotals.clear();
+}
+
+void StreamStatisticsRegistry::Dump(std::ostream &out) {
+    std::map<std::string, StreamStatisticsTotals> totalsByName;
+    {
+        auto &registry = GetRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        totalsByName = registry.destroyedTotals;
+    }
+    for (const auto &statistics: GetAll()) {
+        totalsByName[statistics->name].add(*statistics);
+    }
+
+    out << "Stream statistics:" << std::endl;
+    for (const auto &[name, totals]: totalsByName) {
+        out << name << " (" << totals.nStreams << " streams): "
+            << totals.bytesRead << " bytes read, "
+            << totals.refills << " refills, "
+            << totals.seeks << " seeks, "
+            << static_cast<double>(totals.sourceNanoseconds) / 1e6 << " ms in source, "
+            << static_cast<double>(totals.decompressionNanoseconds) / 1e6 << " ms decompressing" << std::endl;
+        out << "    calls:";
+        for (size_t i = 0; i < totals.calls.size(); i++) {
+            if (totals.calls[i] != 0) {
+                out << " " << OPERATION_NAMES[i] << "=" << totals.calls[i];
+            }
+        }
+        out << std::endl;
+    }
+}
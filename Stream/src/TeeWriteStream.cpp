@@ -0,0 +1,35 @@
+#include <Stream/TeeWriteStream.hpp>
+
+using namespace Stream;
+
+TeeWriteStream::TeeWriteStream(std::shared_ptr<DataWriteStream> first, std::shared_ptr<DataWriteStream> second)
+        : AbstractDataWriteStream(-1, 0), first(std::move(first)), second(std::move(second)) {
+}
+
+void TeeWriteStream::seek(uint64_t newPosition) {
+    first->seek(newPosition);
+    second->seek(newPosition);
+    position = newPosition;
+}
+
+void TeeWriteStream::skip(uint64_t offset) {
+    first->skip(offset);
+    second->skip(offset);
+    position += offset;
+}
+
+void TeeWriteStream::writeUint8(uint8_t uint8) {
+    first->writeUint8(uint8);
+    second->writeUint8(uint8);
+    position++;
+}
+
+void TeeWriteStream::writeBuffer(const uint8_t *buffer, size_t bufferSize) {
+    first->writeBuffer(buffer, bufferSize);
+    second->writeBuffer(buffer, bufferSize);
+    position += bufferSize;
+}
+
+std::pair<size_t, size_t> TeeWriteStream::writeStreamContents(const std::shared_ptr<DataReadStream> &stream) {
+    return copyStreamContents(stream);
+}
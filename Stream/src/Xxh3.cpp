@@ -0,0 +1,301 @@
+#include <Stream/Xxh3.hpp>
+#include <Stream/ByteOrder.hpp>
+#include <cstring>
+
+using namespace Stream;
+
+// The constants and the structure of the algorithm follow the reference implementation of xxHash 0.8.
+// Only the scalar code path is implemented, which compilers vectorize well enough for our inputs.
+
+#define PRIME32_1 0x9E3779B1U
+#define PRIME32_2 0x85EBCA77U
+#define PRIME32_3 0xC2B2AE3DU
+#define PRIME64_1 0x9E3779B185EBCA87ULL
+#define PRIME64_2 0xC2B2AE3D27D4EB4FULL
+#define PRIME64_3 0x165667B19E3779F9ULL
+#define PRIME64_4 0x85EBCA77C2B2AE63ULL
+#define PRIME64_5 0x27D4EB2F165667C5ULL
+
+#define SECRET_SIZE 192
+#define SECRET_SIZE_MIN 136
+#define SECRET_CONSUME_RATE 8
+#define SECRET_MERGEACCS_START 11
+#define SECRET_LASTACC_START 7
+#define STRIPES_PER_BLOCK ((SECRET_SIZE - XXH3_STRIPE_LENGTH) / SECRET_CONSUME_RATE)
+#define MID_SIZE_MAX 240
+
+alignas(XXH3_STRIPE_LENGTH) static const uint8_t SECRET[SECRET_SIZE] = {
+        0xb8, 0xfe, 0x6c, 0x39, 0x23, 0xa4, 0x4b, 0xbe, 0x7c, 0x01, 0x81, 0x2c, 0xf7, 0x21, 0xad, 0x1c,
+        0xde, 0xd4, 0x6d, 0xe9, 0x83, 0x90, 0x97, 0xdb, 0x72, 0x40, 0xa4, 0xa4, 0xb7, 0xb3, 0x67, 0x1f,
+        0xcb, 0x79, 0xe6, 0x4e, 0xcc, 0xc0, 0xe5, 0x78, 0x82, 0x5a, 0xd0, 0x7d, 0xcc, 0xff, 0x72, 0x21,
+        0xb8, 0x08, 0x46, 0x74, 0xf7, 0x43, 0x24, 0x8e, 0xe0, 0x35, 0x90, 0xe6, 0x81, 0x3a, 0x26, 0x4c,
+        0x3c, 0x28, 0x52, 0xbb, 0x91, 0xc3, 0x00, 0xcb, 0x88, 0xd0, 0x65, 0x8b, 0x1b, 0x53, 0x2e, 0xa3,
+        0x71, 0x64, 0x48, 0x97, 0xa2, 0x0d, 0xf9, 0x4e, 0x38, 0x19, 0xef, 0x46, 0xa9, 0xde, 0xac, 0xd8,
+        0xa8, 0xfa, 0x76, 0x3f, 0xe3, 0x9c, 0x34, 0x3f, 0xf9, 0xdc, 0xbb, 0xc7, 0xc7, 0x0b, 0x4f, 0x1d,
+        0x8a, 0x51, 0xe0, 0x4b, 0xcd, 0xb4, 0x59, 0x31, 0xc8, 0x9f, 0x7e, 0xc9, 0xd9, 0x78, 0x73, 0x64,
+        0xea, 0xc5, 0xac, 0x83, 0x34, 0xd3, 0xeb, 0xc3, 0xc5, 0x81, 0xa0, 0xff, 0xfa, 0x13, 0x63, 0xeb,
+        0x17, 0x0d, 0xdd, 0x51, 0xb7, 0xf0, 0xda, 0x49, 0xd3, 0x16, 0x55, 0x26, 0x29, 0xd4, 0x68, 0x9e,
+        0x2b, 0x16, 0xbe, 0x58, 0x7d, 0x47, 0xa1, 0xfc, 0x8f, 0xf8, 0xb8, 0xd1, 0x7a, 0xd0, 0x31, 0xce,
+        0x45, 0xcb, 0x3a, 0x8f, 0x95, 0x16, 0x04, 0x28, 0xaf, 0xd7, 0xfb, 0xca, 0xbb, 0x4b, 0x40, 0x7e,
+};
+
+static const uint64_t INITIAL_ACCUMULATORS[8] = {
+        PRIME32_3, PRIME64_1, PRIME64_2, PRIME64_3, PRIME64_4, PRIME32_2, PRIME64_5, PRIME32_1
+};
+
+static inline uint64_t Read64(const uint8_t *bytes) {
+    return LoadValue<uint64_t>(bytes, ByteOrder::LITTLE);
+}
+
+static inline uint32_t Read32(const uint8_t *bytes) {
+    return LoadValue<uint32_t>(bytes, ByteOrder::LITTLE);
+}
+
+static inline uint64_t SwapBytes64(uint64_t value) {
+    uint8_t bytes[sizeof(uint64_t)];
+    StoreValue(bytes, value, ByteOrder::LITTLE);
+    return LoadValue<uint64_t>(bytes, ByteOrder::BIG);
+}
+
+static inline uint64_t RotateLeft(uint64_t value, int shift) {
+    return (value << shift) | (value >> (64 - shift));
+}
+
+// The xor of the high and the low half of the 128-bit product
+static inline uint64_t Multiply128Fold64(uint64_t left, uint64_t right) {
+#ifdef __SIZEOF_INT128__
+    unsigned __int128 product = static_cast<unsigned __int128>(left) * right;
+    return static_cast<uint64_t>(product) ^ static_cast<uint64_t>(product >> 64);
+#else
+    uint64_t lowLow = (left & 0xFFFFFFFF) * (right & 0xFFFFFFFF);
+    uint64_t highLow = (left >> 32) * (right & 0xFFFFFFFF);
+    uint64_t lowHigh = (left & 0xFFFFFFFF) * (right >> 32);
+    uint64_t highHigh = (left >> 32) * (right >> 32);
+    uint64_t cross = (lowLow >> 32) + (highLow & 0xFFFFFFFF) + lowHigh;
+    uint64_t high = (highLow >> 32) + (cross >> 32) + highHigh;
+    uint64_t low = (cross << 32) | (lowLow & 0xFFFFFFFF);
+    return low ^ high;
+#endif
+}
+
+static inline uint64_t Avalanche(uint64_t hash) {
+    hash ^= hash >> 37;
+    hash *= 0x165667919E3779F9ULL;
+    return hash ^ (hash >> 32);
+}
+
+static inline uint64_t Xxh64Avalanche(uint64_t hash) {
+    hash ^= hash >> 33;
+    hash *= PRIME64_2;
+    hash ^= hash >> 29;
+    hash *= PRIME64_3;
+    return hash ^ (hash >> 32);
+}
+
+static inline uint64_t StrongAvalanche(uint64_t hash, uint64_t length) {
+    hash ^= RotateLeft(hash, 49) ^ RotateLeft(hash, 24);
+    hash *= 0x9FB21C651E98DF25ULL;
+    hash ^= (hash >> 35) + length;
+    hash *= 0x9FB21C651E98DF25ULL;
+    return hash ^ (hash >> 28);
+}
+
+static inline uint64_t Mix16Bytes(const uint8_t *input, const uint8_t *secret) {
+    return Multiply128Fold64(Read64(input) ^ Read64(secret), Read64(input + 8) ^ Read64(secret + 8));
+}
+
+static uint64_t HashLength0To16(const uint8_t *input, size_t length) {
+    if (length > 8) {
+        uint64_t low = Read64(input) ^ (Read64(SECRET + 24) ^ Read64(SECRET + 32));
+        uint64_t high = Read64(input + length - 8) ^ (Read64(SECRET + 40) ^ Read64(SECRET + 48));
+        uint64_t accumulator = length + SwapBytes64(low) + high + Multiply128Fold64(low, high);
+        return Avalanche(accumulator);
+    }
+    if (length >= 4) {
+        uint64_t first = Read32(input);
+        uint64_t last = Read32(input + length - 4);
+        uint64_t keyed = (last + (first << 32)) ^ (Read64(SECRET + 8) ^ Read64(SECRET + 16));
+        return StrongAvalanche(keyed, length);
+    }
+    if (length > 0) {
+        uint32_t combined = static_cast<uint32_t>(input[0]) << 16 | static_cast<uint32_t>(input[length >> 1]) << 24 |
+                            static_cast<uint32_t>(input[length - 1]) | static_cast<uint32_t>(length) << 8;
+        return Xxh64Avalanche(combined ^ static_cast<uint64_t>(Read32(SECRET) ^ Read32(SECRET + 4)));
+    }
+    return Xxh64Avalanche(Read64(SECRET + 56) ^ Read64(SECRET + 64));
+}
+
+static uint64_t HashLength17To128(const uint8_t *input, size_t length) {
+    uint64_t accumulator = length * PRIME64_1;
+    if (length > 32) {
+        if (length > 64) {
+            if (length > 96) {
+                accumulator += Mix16Bytes(input + 48, SECRET + 96);
+                accumulator += Mix16Bytes(input + length - 64, SECRET + 112);
+            }
+            accumulator += Mix16Bytes(input + 32, SECRET + 64);
+            accumulator += Mix16Bytes(input + length - 48, SECRET + 80);
+        }
+        accumulator += Mix16Bytes(input + 16, SECRET + 32);
+        accumulator += Mix16Bytes(input + length - 32, SECRET + 48);
+    }
+    accumulator += Mix16Bytes(input, SECRET);
+    accumulator += Mix16Bytes(input + length - 16, SECRET + 16);
+    return Avalanche(accumulator);
+}
+
+static uint64_t HashLength129To240(const uint8_t *input, size_t length) {
+    uint64_t accumulator = length * PRIME64_1;
+    size_t nRounds = length / 16;
+    for (size_t i = 0; i < 8; i++) {
+        accumulator += Mix16Bytes(input + 16 * i, SECRET + 16 * i);
+    }
+    accumulator = Avalanche(accumulator);
+    for (size_t i = 8; i < nRounds; i++) {
+        accumulator += Mix16Bytes(input + 16 * i, SECRET + 16 * (i - 8) + 3);
+    }
+    accumulator += Mix16Bytes(input + length - 16, SECRET + SECRET_SIZE_MIN - 17);
+    return Avalanche(accumulator);
+}
+
+static inline void Accumulate512(uint64_t *accumulators, const uint8_t *stripe, const uint8_t *secret) {
+    for (size_t i = 0; i < 8; i++) {
+        uint64_t value = Read64(stripe + 8 * i);
+        uint64_t keyed = value ^ Read64(secret + 8 * i);
+        accumulators[i ^ 1] += value;
+        accumulators[i] += (keyed & 0xFFFFFFFF) * (keyed >> 32);
+    }
+}
+
+static inline void ScrambleAccumulators(uint64_t *accumulators, const uint8_t *secret) {
+    for (size_t i = 0; i < 8; i++) {
+        uint64_t accumulator = accumulators[i];
+        accumulator ^= accumulator >> 47;
+        accumulator ^= Read64(secret + 8 * i);
+        accumulators[i] = accumulator * PRIME32_1;
+    }
+}
+
+static void AccumulateStripes(uint64_t *accumulators, const uint8_t *input, const uint8_t *secret, size_t nStripes) {
+    for (size_t i = 0; i < nStripes; i++) {
+        Accumulate512(accumulators, input + i * XXH3_STRIPE_LENGTH, secret + i * SECRET_CONSUME_RATE);
+    }
+}
+
+static uint64_t MergeAccumulators(const uint64_t *accumulators, const uint8_t *secret, uint64_t start) {
+    uint64_t result = start;
+    for (size_t i = 0; i < 4; i++) {
+        result += Multiply128Fold64(accumulators[2 * i] ^ Read64(secret + 16 * i),
+                                    accumulators[2 * i + 1] ^ Read64(secret + 16 * i + 8));
+    }
+    return Avalanche(result);
+}
+
+static uint64_t HashLong(const uint8_t *input, size_t length) {
+    alignas(XXH3_STRIPE_LENGTH) uint64_t accumulators[8];
+    memcpy(accumulators, INITIAL_ACCUMULATORS, sizeof(accumulators));
+
+    const size_t blockLength = XXH3_STRIPE_LENGTH * STRIPES_PER_BLOCK;
+    size_t nBlocks = (length - 1) / blockLength;
+    for (size_t i = 0; i < nBlocks; i++) {
+        AccumulateStripes(accumulators, input + i * blockLength, SECRET, STRIPES_PER_BLOCK);
+        ScrambleAccumulators(accumulators, SECRET + SECRET_SIZE - XXH3_STRIPE_LENGTH);
+    }
+    size_t nStripes = ((length - 1) - blockLength * nBlocks) / XXH3_STRIPE_LENGTH;
+    AccumulateStripes(accumulators, input + nBlocks * blockLength, SECRET, nStripes);
+    Accumulate512(accumulators, input + length - XXH3_STRIPE_LENGTH,
+                  SECRET + SECRET_SIZE - XXH3_STRIPE_LENGTH - SECRET_LASTACC_START);
+    return MergeAccumulators(accumulators, SECRET + SECRET_MERGEACCS_START, length * PRIME64_1);
+}
+
+// Accumulates stripes continuing at the stripe of the current block the previous call stopped at
+static size_t ConsumeStripes(uint64_t *accumulators, size_t nStripesAccumulated, const uint8_t *input,
+                             size_t nStripes) {
+    if (STRIPES_PER_BLOCK - nStripesAccumulated <= nStripes) {
+        size_t nStripesToEnd = STRIPES_PER_BLOCK - nStripesAccumulated;
+        size_t nStripesAfterEnd = nStripes - nStripesToEnd;
+        AccumulateStripes(accumulators, input, SECRET + nStripesAccumulated * SECRET_CONSUME_RATE, nStripesToEnd);
+        ScrambleAccumulators(accumulators, SECRET + SECRET_SIZE - XXH3_STRIPE_LENGTH);
+        AccumulateStripes(accumulators, input + nStripesToEnd * XXH3_STRIPE_LENGTH, SECRET, nStripesAfterEnd);
+        return nStripesAfterEnd;
+    }
+    AccumulateStripes(accumulators, input, SECRET + nStripesAccumulated * SECRET_CONSUME_RATE, nStripes);
+    return nStripesAccumulated + nStripes;
+}
+
+Xxh3::Xxh3() {
+    reset();
+}
+
+void Xxh3::reset() {
+    memcpy(accumulators, INITIAL_ACCUMULATORS, sizeof(accumulators));
+    bufferedSize = 0;
+    nStripesAccumulated = 0;
+    totalLength = 0;
+}
+
+void Xxh3::update(const uint8_t *data, size_t length) {
+    totalLength += length;
+    if (bufferedSize + length <= XXH3_BUFFER_SIZE) {
+        memcpy(buffer + bufferedSize, data, length);
+        bufferedSize += length;
+        return;
+    }
+
+    const size_t bufferStripes = XXH3_BUFFER_SIZE / XXH3_STRIPE_LENGTH;
+    if (bufferedSize > 0) {
+        size_t fillLength = XXH3_BUFFER_SIZE - bufferedSize;
+        memcpy(buffer + bufferedSize, data, fillLength);
+        data += fillLength;
+        length -= fillLength;
+        nStripesAccumulated = ConsumeStripes(accumulators, nStripesAccumulated, buffer, bufferStripes);
+        bufferedSize = 0;
+    }
+    // At least one byte is always kept buffered, as the last stripe is treated differently by digest
+    if (length > XXH3_BUFFER_SIZE) {
+        do {
+            nStripesAccumulated = ConsumeStripes(accumulators, nStripesAccumulated, data, bufferStripes);
+            data += XXH3_BUFFER_SIZE;
+            length -= XXH3_BUFFER_SIZE;
+        } while (length > XXH3_BUFFER_SIZE);
+        // digest may need the end of the last stripe consumed
+        memcpy(buffer + XXH3_BUFFER_SIZE - XXH3_STRIPE_LENGTH, data - XXH3_STRIPE_LENGTH, XXH3_STRIPE_LENGTH);
+    }
+    memcpy(buffer, data, length);
+    bufferedSize = length;
+}
+
+uint64_t Xxh3::digest() const {
+    if (totalLength <= MID_SIZE_MAX) {
+        return Hash(buffer, totalLength);
+    }
+    alignas(XXH3_STRIPE_LENGTH) uint64_t digestAccumulators[8];
+    memcpy(digestAccumulators, accumulators, sizeof(digestAccumulators));
+    const uint8_t *lastAccumulationSecret = SECRET + SECRET_SIZE - XXH3_STRIPE_LENGTH - SECRET_LASTACC_START;
+    if (bufferedSize >= XXH3_STRIPE_LENGTH) {
+        size_t nStripes = (bufferedSize - 1) / XXH3_STRIPE_LENGTH;
+        ConsumeStripes(digestAccumulators, nStripesAccumulated, buffer, nStripes);
+        Accumulate512(digestAccumulators, buffer + bufferedSize - XXH3_STRIPE_LENGTH, lastAccumulationSecret);
+    } else {
+        // The last stripe begins in the data consumed before
+        uint8_t lastStripe[XXH3_STRIPE_LENGTH];
+        size_t catchupSize = XXH3_STRIPE_LENGTH - bufferedSize;
+        memcpy(lastStripe, buffer + XXH3_BUFFER_SIZE - catchupSize, catchupSize);
+        memcpy(lastStripe + catchupSize, buffer, bufferedSize);
+        Accumulate512(digestAccumulators, lastStripe, lastAccumulationSecret);
+    }
+    return MergeAccumulators(digestAccumulators, SECRET + SECRET_MERGEACCS_START, totalLength * PRIME64_1);
+}
+
+uint64_t Xxh3::Hash(const uint8_t *data, size_t length) {
+    if (length <= 16) {
+        return HashLength0To16(data, length);
+    }
+    if (length <= 128) {
+        return HashLength17To128(data, length);
+    }
+    if (length <= MID_SIZE_MAX) {
+        return HashLength129To240(data, length);
+    }
+    return HashLong(data, length);
+}
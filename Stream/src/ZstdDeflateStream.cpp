@@ -4,12 +4,21 @@
 #include <utility>
 
 #define CHECK_POSITION(neededCapacity) \
-if (size != -1 && position + (neededCapacity) > size)  \
+if (size != -1 && (neededCapacity) > size - position)  \
 RAISE_EXCEPTION(StreamOverflowException, "Tried to write to an exhausted stream")
 
+// Largest window zstd decompresses without the decompressor explicitly raising ZSTD_d_windowLogMax
+#define ZSTD_DEFAULT_MAX_WINDOW_LOG 27
+
 Stream::ZstdDeflateStream::ZstdDeflateStream(std::shared_ptr<AbstractDataWriteStream> sink) :
+        ZstdDeflateStream(std::move(sink), {}) {
+}
+
+Stream::ZstdDeflateStream::ZstdDeflateStream(std::shared_ptr<AbstractDataWriteStream> sink,
+                                             std::vector<uint8_t> prefix) :
         AbstractDataWriteStream(-1, 0),
-        sink(std::move(sink)) {
+        sink(std::move(sink)),
+        prefix(std::move(prefix)) {
     auto cCtx = ZSTD_createCCtx();
     if (cCtx == nullptr) {
         RAISE_EXCEPTION(errorhandling::IllegalStateException,
@@ -18,6 +27,24 @@ Stream::ZstdDeflateStream::ZstdDeflateStream(std::shared_ptr<AbstractDataWriteSt
     ZSTD_CCtx_setParameter(cCtx, ZSTD_c_compressionLevel, 0);
     ZSTD_CCtx_setParameter(cCtx, ZSTD_c_checksumFlag, 1);
 
+    if (!this->prefix.empty()) {
+        // The window has to span the prefix for matches into it to be found.
+        // It is capped, so that any ZstdInflateStream can decompress the frame with default parameters.
+        int windowLog = 10;
+        while (windowLog < ZSTD_DEFAULT_MAX_WINDOW_LOG && (static_cast<uint64_t>(1) << windowLog) < this->prefix.size()) {
+            windowLog++;
+        }
+        ZSTD_CCtx_setParameter(cCtx, ZSTD_c_windowLog, windowLog);
+        // Like zstd --patch-from, long distance matching finds the long runs shared with the prefix
+        ZSTD_CCtx_setParameter(cCtx, ZSTD_c_enableLongDistanceMatching, 1);
+        size_t result = ZSTD_CCtx_refPrefix(cCtx, this->prefix.data(), this->prefix.size());
+        if (ZSTD_isError(result)) {
+            ZSTD_freeCCtx(cCtx);
+            RAISE_EXCEPTION(errorhandling::IllegalStateException,
+                            "Failed to create ZstdDeflateStream: ZSTD_CCtx_refPrefix returned error");
+        }
+    }
+
     this->cCtx = cCtx;
     inputBufferCapacity = ZSTD_DStreamInSize();
     inputBuffer = new uint8_t[inputBufferCapacity];
@@ -56,7 +83,7 @@ std::pair<size_t, size_t> Stream::ZstdDeflateStream::writeStreamContents(const s
     size_t bytesWrittenTotal = 0;
     while (stream->hasRemaining()) {
         size_t readBytesInChunk = stream->read(inputBuffer, static_cast<std::streamsize>(inputBufferCapacity));
-        bool lastChunk = readBytesInChunk < inputBufferCapacity;
+        bool lastChunk = readBytesInChunk < inputBufferCapacity || !stream->hasRemaining();
         ZSTD_EndDirective mode = lastChunk ? ZSTD_e_end : ZSTD_e_continue;
         ZSTD_inBuffer input = {inputBuffer, readBytesInChunk, 0};
         bool finished;
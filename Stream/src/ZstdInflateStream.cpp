@@ -1,22 +1,39 @@
 #include <Stream/ZstdInflateStream.hpp>
 #include <ErrorHandling/IllegalStateException.hpp>
+#include <algorithm>
+#include <cstring>
 #include <utility>
 #include <zstd.h>
 
 namespace Stream {
 
     ZstdInflateStream::ZstdInflateStream(std::shared_ptr<AbstractDataReadStream> source)
-            : AbstractDataReadStream(-1, 0), source(std::move(source)) {
+            : ZstdInflateStream(std::move(source), -1) {
+    }
+
+    ZstdInflateStream::ZstdInflateStream(std::shared_ptr<AbstractDataReadStream> source, uint64_t uncompressedSize,
+                                         std::vector<uint8_t> prefix)
+            : AbstractDataReadStream(uncompressedSize, 0), source(std::move(source)), prefix(std::move(prefix)) {
         dCtx = ZSTD_createDCtx();
         if (dCtx == nullptr) {
             RAISE_EXCEPTION(errorhandling::IllegalStateException,
                             "Failed to create ZstdInflateStream: ZSTD_createDCtx returned null");
         }
+        if (!this->prefix.empty()) {
+            size_t result = ZSTD_DCtx_refPrefix(reinterpret_cast<ZSTD_DCtx *>(dCtx), this->prefix.data(),
+                                                this->prefix.size());
+            if (ZSTD_isError(result)) {
+                ZSTD_freeDCtx(reinterpret_cast<ZSTD_DCtx *>(dCtx));
+                RAISE_EXCEPTION(errorhandling::IllegalStateException,
+                                "Failed to create ZstdInflateStream: ZSTD_DCtx_refPrefix returned error");
+            }
+        }
         inputBufferCapacity = READ_BUFFER_SIZE;
         inputBuffer = new uint8_t[inputBufferCapacity];
 
         outputBufferCapacity = READ_BUFFER_SIZE;
         outputBuffer = new uint8_t[outputBufferCapacity];
+        STREAM_STATISTICS_REGISTER("ZstdInflateStream");
     }
 
     // This method uses two buffers and accommodating variables:
@@ -28,6 +45,9 @@ namespace Stream {
     // The capacity variable of the respective buffer is the amount of memory allocated for the buffer,
     // while the length is the amount of data of that buffer, which is meaningfully populated.
     uint8_t ZstdInflateStream::readUint8() {
+        if (size != -1 && (position - startPosition) >= size) {
+            RAISE_EXCEPTION(StreamUnderflowException, "Tried to read from an exhausted stream");
+        }
         // This checks whether the input buffer is empty, or all the compressed data from the outputBuffer
         // has been read and passed to the user that is streaming this stream.
         // Whenever this is the case, we need to read new compressed data from the source stream,
@@ -43,6 +63,8 @@ namespace Stream {
         if (outputBufferReadIndex == 0) {
             ZSTD_inBuffer input;
             if (inputBufferReadIndex == 0) {
+                STREAM_STATISTICS_ADD(refills, 1);
+                STREAM_STATISTICS_TIME(sourceNanoseconds);
                 auto read = source->read(inputBuffer, inputBufferCapacity);
                 if (read == 0) {
                     RAISE_EXCEPTION(errorhandling::IllegalStateException,
@@ -52,6 +74,7 @@ namespace Stream {
             }
             input = {inputBuffer, inputBufferLength, inputBufferReadIndex};
             ZSTD_outBuffer output = {outputBuffer, outputBufferCapacity, 0};
+            STREAM_STATISTICS_TIME(decompressionNanoseconds);
             while (input.pos < input.size) {
                 size_t ret = ZSTD_decompressStream(reinterpret_cast<ZSTD_DCtx *>(dCtx), &output, &input);
                 if (output.pos == output.size && input.pos < input.size) {
@@ -84,9 +107,32 @@ namespace Stream {
         auto currentOutputBufferReadIndex = outputBufferReadIndex;
         outputBufferReadIndex++;
         position++;
+        STREAM_STATISTICS_BYTES(1);
         return outputBuffer[currentOutputBufferReadIndex];
     }
 
+    size_t ZstdInflateStream::read(uint8_t *buffer, size_t bufferLength) {
+        size_t nRead = 0;
+        while (nRead < bufferLength && hasRemaining()) {
+            if (inputBufferLength == 0 || outputBufferReadIndex >= outputBufferLength) {
+                // readUint8 decompresses the next block into the output buffer
+                buffer[nRead++] = readUint8();
+                continue;
+            }
+            // Copy as much of the decompressed block as possible at once
+            size_t nCopy = std::min(bufferLength - nRead, outputBufferLength - outputBufferReadIndex);
+            if (size != -1) {
+                nCopy = std::min<uint64_t>(nCopy, size - (position - startPosition));
+            }
+            memcpy(buffer + nRead, outputBuffer + outputBufferReadIndex, nCopy);
+            outputBufferReadIndex += nCopy;
+            position += nCopy;
+            STREAM_STATISTICS_BYTES(nCopy);
+            nRead += nCopy;
+        }
+        return nRead;
+    }
+
     void ZstdInflateStream::seek(uint64_t position) {
         RAISE_EXCEPTION(errorhandling::IllegalStateException,
                         "Failed to seek in ZstdInflateStream: seek is not supported"
@@ -106,6 +152,9 @@ namespace Stream {
     }
 
     bool ZstdInflateStream::hasRemaining() const {
+        if (size != -1 && (position - startPosition) >= size) {
+            return false;
+        }
         return source->hasRemaining() || outputBufferReadIndex < outputBufferLength;
     }
 }
\ No newline at end of file
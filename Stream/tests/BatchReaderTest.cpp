@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+#include <Stream/BatchReader.hpp>
+#include <Stream/FileDataWriteStream.hpp>
+#ifdef __linux__
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+static std::vector<uint8_t> WriteContent(const std::string &filePath, size_t size) {
+    std::vector<uint8_t> content(size);
+    for (size_t i = 0; i < size; i++) {
+        content[i] = static_cast<uint8_t>(i * 13 + i / 251);
+    }
+    auto stream = Stream::FileDataWriteStream::Open(filePath);
+    stream->writeBuffer(content.data(), content.size());
+    stream->close();
+    return content;
+}
+
+static void ExpectBatchRead(Stream::BatchReader &reader, const std::vector<uint8_t> &content) {
+    // More ranges than fit into a single submission, of different sizes and in no particular order
+    std::vector<std::vector<uint8_t>> buffers;
+    std::vector<Stream::ReadRequest> requests;
+    for (size_t i = 0; i < 1000; i++) {
+        buffers.emplace_back(1 + (i * 104729) % 4000);
+    }
+    for (size_t i = 0; i < buffers.size(); i++) {
+        requests.push_back({(i * 7919) % (content.size() / 2), buffers[i].size(), buffers[i].data()});
+    }
+    reader.read(requests);
+    for (size_t i = 0; i < requests.size(); i++) {
+        ASSERT_TRUE(std::equal(buffers[i].begin(), buffers[i].end(), content.begin() + requests[i].offset));
+    }
+
+    // Reading past the end of the file
+    std::vector<uint8_t> buffer(100);
+    EXPECT_THROW(reader.read({{content.size() - 10, buffer.size(), buffer.data()}}),
+                 Stream::BatchReadFailedException);
+}
+
+TEST(BatchReader, Pread) {
+    auto content = WriteContent("BatchReaderTest.bin", 1 << 20);
+    auto reader = Stream::BatchReader::Open("BatchReaderTest.bin", Stream::BatchReaderBackend::PREAD);
+    EXPECT_EQ(Stream::BatchReaderBackend::PREAD, reader->getBackend());
+    ExpectBatchRead(*reader, content);
+}
+
+TEST(BatchReader, IoUring) {
+    auto content = WriteContent("BatchReaderTest.bin", 1 << 20);
+    std::unique_ptr<Stream::BatchReader> reader;
+    try {
+        reader = Stream::BatchReader::Open("BatchReaderTest.bin", Stream::BatchReaderBackend::IO_URING);
+    } catch (const Stream::BatchReaderOpenFailedException &exception) {
+        GTEST_SKIP() << "io_uring is not available on this platform or kernel: " << exception.what();
+    }
+    EXPECT_EQ(Stream::BatchReaderBackend::IO_URING, reader->getBackend());
+    ExpectBatchRead(*reader, content);
+}
+
+TEST(BatchReader, OpenMissingFile) {
+    EXPECT_THROW(Stream::BatchReader::Open("BatchReaderTest_missing.bin"), Stream::BatchReaderOpenFailedException);
+}
+
+#ifdef __linux__
+
+// The descriptors of all io_uring instances of the process
+static std::vector<int> FindRingFileDescriptors() {
+    std::vector<int> fileDescriptors;
+    DIR *directory = opendir("/proc/self/fd");
+    if (directory == nullptr) {
+        return fileDescriptors;
+    }
+    while (dirent *entry = readdir(directory)) {
+        char target[64]{};
+        std::string path = std::string("/proc/self/fd/") + entry->d_name;
+        if (readlink(path.c_str(), target, sizeof(target) - 1) > 0 && std::string(target) == "anon_inode:[io_uring]") {
+            fileDescriptors.push_back(std::stoi(entry->d_name));
+        }
+    }
+    closedir(directory);
+    return fileDescriptors;
+}
+
+TEST(BatchReader, IoUringEnterFailure) {
+    auto content = WriteContent("BatchReaderTest.bin", 1 << 20);
+    std::unique_ptr<Stream::BatchReader> reader;
+    try {
+        reader = Stream::BatchReader::Open("BatchReaderTest.bin", Stream::BatchReaderBackend::IO_URING);
+    } catch (const Stream::BatchReaderOpenFailedException &exception) {
+        GTEST_SKIP() << "io_uring is not available on this platform or kernel: " << exception.what();
+    }
+    auto ringFileDescriptors = FindRingFileDescriptors();
+    if (ringFileDescriptors.size() != 1) {
+        GTEST_SKIP() << "The ring of the reader can not be told apart from other rings of the process";
+    }
+
+    // Make io_uring_enter fail by replacing the ring with a file, which is not a ring
+    int ringFileDescriptor = ringFileDescriptors[0];
+    int savedRing = dup(ringFileDescriptor);
+    int notARing = open("/dev/null", O_RDONLY | O_CLOEXEC);
+    ASSERT_GE(savedRing, 0);
+    ASSERT_GE(notARing, 0);
+    ASSERT_EQ(ringFileDescriptor, dup2(notARing, ringFileDescriptor));
+    {
+        std::vector<std::vector<uint8_t>> buffers(10, std::vector<uint8_t>(100));
+        std::vector<Stream::ReadRequest> requests;
+        for (auto &buffer: buffers) {
+            requests.push_back({0, buffer.size(), buffer.data()});
+        }
+        EXPECT_THROW(reader->read(requests), Stream::BatchReadFailedException);
+    }
+
+    // The entries of the failed call must not be submitted with the next one, their ranges are gone
+    ASSERT_EQ(ringFileDescriptor, dup2(savedRing, ringFileDescriptor));
+    close(savedRing);
+    close(notARing);
+    ExpectBatchRead(*reader, content);
+}
+
+#endif
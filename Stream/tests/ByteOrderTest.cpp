@@ -0,0 +1,37 @@
+#include <gtest/gtest.h>
+#include <Stream/MemoryDataStream.hpp>
+
+TEST(ByteOrder, DefaultsToBigEndian) {
+    auto writeStream = Stream::MemoryWriteStream::Growable();
+    EXPECT_EQ(Stream::ByteOrder::BIG, writeStream->getByteOrder());
+    writeStream->writeUint32(0x01020304);
+    std::vector<uint8_t> buffer = writeStream->releaseBuffer();
+    EXPECT_EQ((std::vector<uint8_t>{1, 2, 3, 4}), buffer);
+}
+
+TEST(ByteOrder, WritesLittleEndian) {
+    auto writeStream = Stream::MemoryWriteStream::Growable();
+    writeStream->setByteOrder(Stream::ByteOrder::LITTLE);
+    writeStream->writeUint16(0x0102);
+    writeStream->writeUint64(0x0102030405060708);
+    std::vector<uint8_t> buffer = writeStream->releaseBuffer();
+    EXPECT_EQ((std::vector<uint8_t>{2, 1, 8, 7, 6, 5, 4, 3, 2, 1}), buffer);
+}
+
+TEST(ByteOrder, RoundTripsBothOrders) {
+    std::vector<float> values = {1.5f, -2.25f, 1e-20f};
+    for (auto byteOrder: {Stream::ByteOrder::BIG, Stream::ByteOrder::LITTLE}) {
+        auto writeStream = Stream::MemoryWriteStream::Growable();
+        writeStream->setByteOrder(byteOrder);
+        writeStream->writeInt32(-7);
+        writeStream->writeFloat32Array(values.data(), values.size());
+        std::vector<uint8_t> buffer = writeStream->releaseBuffer();
+
+        auto readStream = Stream::MemoryReadStream::CopyOf(buffer.data(), buffer.size());
+        readStream->setByteOrder(byteOrder);
+        EXPECT_EQ(-7, readStream->readInt32());
+        std::vector<float> readValues(values.size());
+        readStream->readFloat32Array(readValues.data(), readValues.size());
+        EXPECT_EQ(values, readValues);
+    }
+}
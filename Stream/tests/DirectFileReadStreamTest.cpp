@@ -0,0 +1,53 @@
+#include <gtest/gtest.h>
+#include <Stream/DirectFileReadStream.hpp>
+#include <Stream/FileDataWriteStream.hpp>
+#include <Stream/StreamExcept.hpp>
+#include <cstring>
+
+static std::vector<uint8_t> WriteContent(const std::string &filePath, size_t size) {
+    std::vector<uint8_t> content(size);
+    for (size_t i = 0; i < size; i++) {
+        content[i] = static_cast<uint8_t>(i * 13 + i / 251);
+    }
+    auto stream = Stream::FileDataWriteStream::Open(filePath);
+    stream->writeBuffer(content.data(), content.size());
+    stream->close();
+    return content;
+}
+
+TEST(DirectFileReadStream, ReadWholeFile) {
+    // Not a multiple of the alignment, and more than one buffer
+    auto content = WriteContent("DirectFileReadStreamTest.bin", 2 * DIRECT_READ_BUFFER_SIZE + 12345);
+    auto stream = Stream::DirectFileReadStream::Open("DirectFileReadStreamTest.bin");
+    EXPECT_EQ(content.size(), stream->getLength());
+
+    std::vector<uint8_t> read(content.size() + 100);
+    EXPECT_EQ(content.size(), stream->read(read.data(), read.size()));
+    read.resize(content.size());
+    EXPECT_EQ(content, read);
+    EXPECT_FALSE(stream->hasRemaining());
+    EXPECT_THROW(stream->readUint8(), Stream::StreamUnderflowException);
+}
+
+TEST(DirectFileReadStream, ReadUnalignedRange) {
+    auto content = WriteContent("DirectFileReadStreamTest.bin", 3 * DIRECT_READ_ALIGNMENT);
+    uint64_t offset = DIRECT_READ_ALIGNMENT - 3;
+    Stream::DirectFileReadStream stream("DirectFileReadStreamTest.bin", offset, DIRECT_READ_ALIGNMENT + 7);
+
+    EXPECT_EQ(content[offset], stream.readUint8());
+    stream.setByteOrder(Stream::ByteOrder::LITTLE);
+    uint32_t expected;
+    memcpy(&expected, content.data() + offset + 1, sizeof(expected));
+    EXPECT_EQ(expected, stream.readUint32());
+
+    std::vector<uint8_t> rest(DIRECT_READ_ALIGNMENT);
+    EXPECT_EQ(rest.size(), stream.read(rest.data(), rest.size()));
+    EXPECT_TRUE(std::equal(rest.begin(), rest.end(), content.begin() + offset + 5));
+
+    // Seeking back reads from the buffer again
+    stream.seek(offset + 1);
+    EXPECT_EQ(content[offset + 1], stream.readUint8());
+    stream.skip(2);
+    EXPECT_EQ(content[offset + 4], stream.readUint8());
+    EXPECT_THROW(stream.seek(offset + DIRECT_READ_ALIGNMENT + 8), Stream::StreamSeekException);
+}
@@ -0,0 +1,50 @@
+#include <gtest/gtest.h>
+#include <Stream/FileDataWriteStream.hpp>
+#include <Stream/FileDataReadStream.hpp>
+#include <Stream/MemoryDataStream.hpp>
+
+TEST(FileDataWriteStream, WriteAndReadBack) {
+    // Larger than the write buffer, so that it is flushed while writing
+    std::vector<uint8_t> content(WRITE_BUFFER_SIZE * 2 + 123);
+    for (size_t i = 0; i < content.size(); i++) {
+        content[i] = static_cast<uint8_t>(i * 7);
+    }
+    {
+        auto stream = Stream::FileDataWriteStream::Open("FileDataWriteStreamTest.bin");
+        stream->writeUint32(0);
+        stream->writeString("Hello");
+        stream->writeBuffer(content.data(), 100);
+        stream->writeBuffer(content.data() + 100, content.size() - 100);
+        for (uint8_t byte: content) {
+            stream->writeUint8(byte);
+        }
+        std::shared_ptr<Stream::DataReadStream> memoryStream = Stream::MemoryReadStream::CopyOf(content.data(),
+                                                                                               content.size());
+        stream->writeStreamContents(memoryStream);
+        // Seeking flushes the buffered data before overwriting the start of the file
+        stream->seek(0);
+        stream->writeUint32(42);
+        stream->close();
+    }
+
+    auto stream = Stream::FileDataReadStream::Open("FileDataWriteStreamTest.bin");
+    ASSERT_EQ(4 + 8 + 5 + content.size() * 3, stream->getLength());
+    EXPECT_EQ(42, stream->readUint32());
+    EXPECT_EQ("Hello", stream->readString());
+    std::vector<uint8_t> readContent(content.size());
+    for (int i = 0; i < 3; i++) {
+        ASSERT_EQ(content.size(), stream->read(readContent.data(), readContent.size()));
+        EXPECT_EQ(content, readContent);
+    }
+    EXPECT_FALSE(stream->hasRemaining());
+}
+
+TEST(FileDataWriteStream, FlushOnDestruction) {
+    {
+        std::unique_ptr<Stream::DataWriteStream> stream = Stream::FileDataWriteStream::Open(
+                "FileDataWriteStreamTest.bin");
+        stream->writeUint64(1234);
+    }
+    auto stream = Stream::FileDataReadStream::Open("FileDataWriteStreamTest.bin");
+    EXPECT_EQ(1234, stream->readUint64());
+}
@@ -0,0 +1,72 @@
+#include <gtest/gtest.h>
+#include <Stream/MemoryDataStream.hpp>
+
+TEST(MemoryWriteStream, WriteAndReadBack) {
+    auto stream = Stream::MemoryWriteStream::Growable();
+    stream->writeUint8(10);
+    stream->writeUint16(0x1234);
+    stream->writeUint32(0xDEADBEEF);
+    stream->writeUint64(0x0123456789ABCDEF);
+    stream->writeFloat32(1.5f);
+    stream->writeString("Hello");
+    stream->writeFixedString("World", 8);
+    ASSERT_EQ(1 + 2 + 4 + 8 + 4 + 8 + 5 + 8, stream->getLength());
+
+    std::vector<uint8_t> buffer = stream->releaseBuffer();
+    ASSERT_EQ(0, stream->getLength());
+
+    auto readStream = Stream::MemoryReadStream::CopyOf(buffer.data(), buffer.size());
+    EXPECT_EQ(10, readStream->readUint8());
+    EXPECT_EQ(0x1234, readStream->readUint16());
+    EXPECT_EQ(0xDEADBEEF, readStream->readUint32());
+    EXPECT_EQ(0x0123456789ABCDEF, readStream->readUint64());
+    EXPECT_EQ(1.5f, readStream->readFloat32());
+    EXPECT_EQ("Hello", readStream->readString());
+    EXPECT_EQ("World", readStream->readFixedString(8));
+    EXPECT_FALSE(readStream->hasRemaining());
+}
+
+TEST(MemoryWriteStream, Grow) {
+    auto stream = Stream::MemoryWriteStream::Growable(1);
+    std::vector<uint8_t> content(100000);
+    for (size_t i = 0; i < content.size(); i++) {
+        content[i] = static_cast<uint8_t>(i * 31);
+    }
+    stream->writeBuffer(content.data(), 10);
+    stream->writeBuffer(content.data() + 10, content.size() - 10);
+    EXPECT_EQ(content, stream->releaseBuffer());
+}
+
+TEST(MemoryWriteStream, SeekBack) {
+    auto stream = Stream::MemoryWriteStream::Growable();
+    stream->writeUint32(0);
+    stream->writeUint32(42);
+    stream->seek(0);
+    stream->writeUint32(7);
+    ASSERT_EQ(8, stream->getLength());
+
+    std::vector<uint8_t> buffer = stream->releaseBuffer();
+    EXPECT_EQ((std::vector<uint8_t>{0, 0, 0, 7, 0, 0, 0, 42}), buffer);
+}
+
+TEST(MemoryWriteStream, WriteStreamContents) {
+    std::vector<uint8_t> content(200000, 3);
+    std::shared_ptr<Stream::DataReadStream> readStream = Stream::MemoryReadStream::CopyOf(content.data(),
+                                                                                         content.size());
+    auto stream = Stream::MemoryWriteStream::Growable();
+    auto [nRead, nWritten] = stream->writeStreamContents(readStream);
+    EXPECT_EQ(content.size(), nRead);
+    EXPECT_EQ(content.size(), nWritten);
+    EXPECT_EQ(content, stream->releaseBuffer());
+}
+
+TEST(MemoryWriteStream, Wrap) {
+    uint8_t memory[6]{};
+    auto stream = Stream::MemoryWriteStream::Wrap(memory, sizeof(memory));
+    stream->writeUint32(0x01020304);
+    stream->writeUint16(0x0506);
+    EXPECT_EQ(0, memcmp(memory, "\x01\x02\x03\x04\x05\x06", sizeof(memory)));
+
+    EXPECT_ANY_THROW(stream->writeUint8(7));
+    EXPECT_ANY_THROW(stream->releaseBuffer());
+}
@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+#include <Stream/PrefetchingReadStream.hpp>
+#include <Stream/MemoryDataStream.hpp>
+#include <Stream/ZstdDeflateStream.hpp>
+#include <Stream/ZstdInflateStream.hpp>
+
+static std::vector<uint8_t> MakeContent(size_t size) {
+    std::vector<uint8_t> content(size);
+    for (size_t i = 0; i < size; i++) {
+        content[i] = static_cast<uint8_t>(i * 31 + i / 7);
+    }
+    return content;
+}
+
+// Small chunks and depth, so that reads span chunks and the prefetching thread has to wait for free chunks
+static std::unique_ptr<Stream::PrefetchingReadStream> PrefetchContent(const std::vector<uint8_t> &content) {
+    return std::make_unique<Stream::PrefetchingReadStream>(
+            Stream::MemoryReadStream::CopyOf(content.data(), content.size()), 3, 7);
+}
+
+TEST(PrefetchingReadStream, ReadsSourceInOrder) {
+    auto content = MakeContent(1000);
+    auto stream = PrefetchContent(content);
+    std::vector<uint8_t> readContent;
+    readContent.push_back(stream->readUint8());
+    std::vector<uint8_t> chunk(100);
+    ASSERT_EQ(chunk.size(), stream->read(chunk.data(), chunk.size()));
+    readContent.insert(readContent.end(), chunk.begin(), chunk.end());
+    while (stream->hasRemaining()) {
+        readContent.push_back(stream->readUint8());
+    }
+    EXPECT_EQ(content, readContent);
+    EXPECT_EQ(content.size(), stream->getPosition());
+    EXPECT_EQ(0, stream->read(chunk.data(), chunk.size()));
+    EXPECT_THROW(stream->readUint8(), Stream::StreamUnderflowException);
+}
+
+TEST(PrefetchingReadStream, Seek) {
+    auto content = MakeContent(1000);
+    auto stream = PrefetchContent(content);
+    stream->skip(10);
+    EXPECT_EQ(content[10], stream->readUint8());
+    stream->seek(500);
+    std::vector<uint8_t> readContent(500);
+    ASSERT_EQ(readContent.size(), stream->read(readContent.data(), readContent.size()));
+    EXPECT_TRUE(std::equal(readContent.begin(), readContent.end(), content.begin() + 500));
+    EXPECT_FALSE(stream->hasRemaining());
+}
+
+TEST(PrefetchingReadStream, DestroyWhilePrefetching) {
+    auto content = MakeContent(1 << 20);
+    for (int i = 0; i < 100; i++) {
+        auto stream = PrefetchContent(content);
+        stream->readUint8();
+    }
+}
+
+TEST(PrefetchingReadStream, DecompressPrefetchedSource) {
+    auto content = MakeContent(1 << 20);
+    auto compressedStream = std::shared_ptr<Stream::MemoryWriteStream>(Stream::MemoryWriteStream::Growable());
+    {
+        Stream::ZstdDeflateStream deflateStream(compressedStream);
+        std::shared_ptr<Stream::DataReadStream> contentStream = Stream::MemoryReadStream::CopyOf(content.data(),
+                                                                                                content.size());
+        deflateStream.writeStreamContents(contentStream);
+    }
+    auto compressed = compressedStream->releaseBuffer();
+
+    Stream::ZstdInflateStream inflateStream(
+            std::make_shared<Stream::PrefetchingReadStream>(
+                    Stream::MemoryReadStream::CopyOf(compressed.data(), compressed.size()), 2, 4096),
+            content.size()
+    );
+    std::vector<uint8_t> readContent(content.size());
+    ASSERT_EQ(content.size(), inflateStream.read(readContent.data(), readContent.size()));
+    EXPECT_EQ(content, readContent);
+}
+
+class FailingReadStream : public Stream::MemoryReadStream {
+
+    static constexpr uint8_t byte = 0;
+
+public:
+    FailingReadStream() : Stream::MemoryReadStream(&byte, 1, false) {
+    }
+
+    size_t read(uint8_t *buffer, size_t bufferLength) override {
+        RAISE_EXCEPTION(Stream::StreamUnderflowException, "Source failed");
+    }
+};
+
+TEST(PrefetchingReadStream, RethrowsSourceExceptions) {
+    Stream::PrefetchingReadStream stream(std::make_shared<FailingReadStream>());
+    EXPECT_THROW(stream.readUint8(), Stream::StreamUnderflowException);
+}
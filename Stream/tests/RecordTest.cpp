@@ -0,0 +1,60 @@
+#include <gtest/gtest.h>
+#include <Stream/Record.hpp>
+#include <Stream/MemoryDataStream.hpp>
+
+static std::vector<uint8_t> WriteRecord(Stream::ByteOrder byteOrder) {
+    auto writeStream = Stream::MemoryWriteStream::Growable();
+    writeStream->setByteOrder(byteOrder);
+    writeStream->writeInt64(-5);
+    writeStream->writeInt8(3);
+    writeStream->writeFloat32(2.5f);
+    writeStream->writeUint16(0xABCD);
+    return writeStream->releaseBuffer();
+}
+
+TEST(Record, ReadRecordMatchesSingleValues) {
+    static_assert(Stream::RecordSize<int64_t, int8_t, float, uint16_t>() == 15);
+    for (auto byteOrder: {Stream::ByteOrder::BIG, Stream::ByteOrder::LITTLE}) {
+        auto buffer = WriteRecord(byteOrder);
+        auto readStream = Stream::MemoryReadStream::CopyOf(buffer.data(), buffer.size());
+        readStream->setByteOrder(byteOrder);
+        auto [a, b, c, d] = Stream::ReadRecord<int64_t, int8_t, float, uint16_t>(*readStream);
+        EXPECT_EQ(-5, a);
+        EXPECT_EQ(3, b);
+        EXPECT_EQ(2.5f, c);
+        EXPECT_EQ(0xABCD, d);
+        EXPECT_FALSE(readStream->hasRemaining());
+    }
+}
+
+TEST(Record, TryReadRecordOnExhaustedStream) {
+    auto buffer = WriteRecord(Stream::ByteOrder::BIG);
+    auto readStream = Stream::MemoryReadStream::CopyOf(buffer.data(), buffer.size());
+    EXPECT_FALSE((Stream::TryReadRecord<int64_t, int64_t>(*readStream).has_value()));
+
+    readStream->seek(0);
+    EXPECT_THROW((Stream::ReadRecord<int64_t, int64_t>(*readStream)), Stream::StreamUnderflowException);
+}
+
+TEST(Record, TryReadValues) {
+    auto buffer = WriteRecord(Stream::ByteOrder::BIG);
+    auto readStream = Stream::MemoryReadStream::CopyOf(buffer.data(), buffer.size());
+    int64_t int64 = 0;
+    int8_t int8 = 0;
+    float f32 = 0;
+    uint16_t uint16 = 0;
+    uint32_t uint32 = 7;
+    ASSERT_TRUE(readStream->tryReadInt64(int64));
+    ASSERT_TRUE(readStream->tryReadInt8(int8));
+    ASSERT_TRUE(readStream->tryReadFloat32(f32));
+    EXPECT_EQ(-5, int64);
+    EXPECT_EQ(3, int8);
+    EXPECT_EQ(2.5f, f32);
+
+    // Only 2 bytes remain, which is not enough for a 32-bit value
+    EXPECT_FALSE(readStream->tryReadUint32(uint32));
+    EXPECT_EQ(7, uint32);
+    ASSERT_TRUE(readStream->tryReadUint16(uint16));
+    EXPECT_EQ(0xABCD, uint16);
+    EXPECT_FALSE(readStream->tryReadUint16(uint16));
+}
@@ -0,0 +1,80 @@
+#include <gtest/gtest.h>
+#include <Stream/CountingReadStream.hpp>
+#include <Stream/CountingWriteStream.hpp>
+#include <Stream/HashingDataStream.hpp>
+#include <Stream/MemoryDataStream.hpp>
+#include <Stream/TeeWriteStream.hpp>
+#include <Stream/ZstdInflateStream.hpp>
+#include <ErrorHandling/IllegalStateException.hpp>
+
+static std::vector<uint8_t> MakeContent() {
+    std::vector<uint8_t> content(3000);
+    for (size_t i = 0; i < content.size(); i++) {
+        content[i] = static_cast<uint8_t>(i * 31 + 7);
+    }
+    return content;
+}
+
+TEST(StreamDecorators, HashingReadStream) {
+    auto content = MakeContent();
+    Stream::HashingReadStream stream(Stream::MemoryReadStream::CopyOf(content.data(), content.size()));
+    stream.readUint8();
+    stream.readUint32();
+    std::vector<uint8_t> rest(content.size());
+    EXPECT_EQ(content.size() - 5, stream.read(rest.data(), rest.size()));
+    EXPECT_FALSE(stream.hasRemaining());
+    EXPECT_EQ(Stream::Xxh3::Hash(content.data(), content.size()), stream.getHash());
+    EXPECT_THROW(stream.seek(0), errorhandling::IllegalStateException);
+}
+
+TEST(StreamDecorators, CountingReadStream) {
+    auto content = MakeContent();
+    Stream::CountingReadStream stream(Stream::MemoryReadStream::CopyOf(content.data(), content.size()));
+    stream.readUint8();
+    stream.readUint32();
+    std::vector<uint8_t> buffer(100);
+    EXPECT_EQ(buffer.size(), stream.read(buffer.data(), buffer.size()));
+    EXPECT_EQ(105u, stream.getBytesRead());
+    EXPECT_EQ(105u, stream.getPosition());
+
+    // Seeking moves the position, not the count
+    stream.seek(content.size() - 10);
+    EXPECT_EQ(10u, stream.read(buffer.data(), buffer.size()));
+    EXPECT_FALSE(stream.hasRemaining());
+    EXPECT_EQ(115u, stream.getBytesRead());
+}
+
+TEST(StreamDecorators, TeeToHashingAndCountingWriteStreams) {
+    auto content = MakeContent();
+    std::shared_ptr<Stream::MemoryWriteStream> memoryStream = Stream::MemoryWriteStream::Growable();
+    auto hashingStream = std::make_shared<Stream::HashingWriteStream>(memoryStream);
+    auto countingStream = std::make_shared<Stream::CountingWriteStream>();
+    Stream::TeeWriteStream teeStream(hashingStream, countingStream);
+
+    teeStream.writeUint8(content[0]);
+    teeStream.writeBuffer(content.data() + 1, 999);
+    auto nWrittenAndRead = teeStream.writeStreamContents(
+            Stream::MemoryReadStream::CopyOf(content.data() + 1000, content.size() - 1000));
+    EXPECT_EQ(content.size() - 1000, nWrittenAndRead.first);
+
+    EXPECT_EQ(content.size(), countingStream->getBytesWritten());
+    EXPECT_EQ(content.size(), teeStream.getPosition());
+    EXPECT_EQ(Stream::Xxh3::Hash(content.data(), content.size()), hashingStream->getHash());
+    EXPECT_EQ(content, memoryStream->releaseBuffer());
+}
+
+TEST(StreamDecorators, TryReadFromCorruptSource) {
+    std::vector<uint8_t> corrupt(64, 0xAB);
+    auto makeStream = [&corrupt]() {
+        return Stream::ZstdInflateStream(std::shared_ptr<Stream::AbstractDataReadStream>(
+                Stream::MemoryReadStream::Wrap(corrupt.data(), corrupt.size())));
+    };
+    auto stream = makeStream();
+    EXPECT_THROW(stream.readUint32(), errorhandling::Exception);
+
+    // The non-throwing reads report the failure of the source instead
+    auto tryStream = makeStream();
+    uint32_t value = 42;
+    EXPECT_FALSE(tryStream.tryReadUint32(value));
+    EXPECT_EQ(42u, value);
+}
@@ -0,0 +1,80 @@
+#include <gtest/gtest.h>
+#include <Stream/MemoryDataStream.hpp>
+#include <Stream/StatisticsReadStream.hpp>
+#include <algorithm>
+#include <sstream>
+
+TEST(StreamStatistics, CountsOperationsAndBytes) {
+    Stream::StreamStatisticsRegistry::Reset();
+
+    auto writeStream = Stream::MemoryWriteStream::Growable();
+    writeStream->writeUint32(42);
+    writeStream->writeString("Material");
+    writeStream->writeUint8(7);
+    writeStream->writeInt8(-1);
+    writeStream->writeUint16(1);
+    writeStream->writeUint16(2);
+    auto buffer = writeStream->releaseBuffer();
+
+    Stream::StatisticsReadStream stream(Stream::MemoryReadStream::CopyOf(buffer.data(), buffer.size()), "Test");
+    EXPECT_EQ(42, stream.readUint32());
+    EXPECT_EQ("Material", stream.readString());
+    uint8_t uint8;
+    EXPECT_TRUE(stream.tryReadUint8(uint8));
+    EXPECT_EQ(-1, stream.readInt8());
+    uint16_t values[2];
+    stream.readUint16Array(values, 2);
+    EXPECT_FALSE(stream.tryReadUint8(uint8));
+    stream.seek(0);
+
+    const auto &statistics = *stream.getStatistics();
+    EXPECT_EQ("Test", statistics.name);
+    EXPECT_EQ(buffer.size(), statistics.bytesRead.load());
+    EXPECT_EQ(1, statistics.calls[static_cast<size_t>(Stream::StreamOperation::UINT32)].load());
+    EXPECT_EQ(1, statistics.calls[static_cast<size_t>(Stream::StreamOperation::STRING)].load());
+    EXPECT_EQ(2, statistics.calls[static_cast<size_t>(Stream::StreamOperation::UINT8)].load());
+    EXPECT_EQ(1, statistics.calls[static_cast<size_t>(Stream::StreamOperation::INT8)].load());
+    EXPECT_EQ(1, statistics.calls[static_cast<size_t>(Stream::StreamOperation::ARRAY)].load());
+    EXPECT_EQ(1, statistics.seeks.load());
+}
+
+TEST(StreamStatistics, InstrumentedStreamsCountSingleBytesOnce) {
+    Stream::StreamStatisticsRegistry::Reset();
+
+    const uint8_t content[2]{1, 0xFF};
+    auto stream = Stream::MemoryReadStream::CopyOf(content, sizeof(content));
+    EXPECT_EQ(1, stream->readUint8());
+    EXPECT_EQ(-1, stream->readInt8());
+    if (stream->getStatistics() == nullptr) {
+        GTEST_SKIP() << "Streams are only instrumented with DYNGINE_STREAM_STATISTICS";
+    }
+    const auto &statistics = *stream->getStatistics();
+    // readInt8 is counted by the readUint8 it reads through
+    EXPECT_EQ(2, statistics.calls[static_cast<size_t>(Stream::StreamOperation::UINT8)].load());
+    EXPECT_EQ(0, statistics.calls[static_cast<size_t>(Stream::StreamOperation::INT8)].load());
+    EXPECT_EQ(2, statistics.bytesRead.load());
+}
+
+TEST(StreamStatistics, DumpGroupsByName) {
+    Stream::StreamStatisticsRegistry::Reset();
+
+    const uint8_t content[16]{};
+    for (int i = 0; i < 2; i++) {
+        Stream::StatisticsReadStream stream(Stream::MemoryReadStream::CopyOf(content, sizeof(content)), "Grouped");
+        uint8_t buffer[16];
+        EXPECT_EQ(sizeof(buffer), stream.read(buffer, sizeof(buffer)));
+    }
+    // Destroyed streams only remain in the totals of their name
+    auto all = Stream::StreamStatisticsRegistry::GetAll();
+    EXPECT_EQ(0, std::count_if(all.begin(), all.end(), [](const auto &statistics) {
+        return statistics->name == "Grouped";
+    }));
+
+    std::ostringstream out;
+    Stream::StreamStatisticsRegistry::Dump(out);
+    EXPECT_NE(std::string::npos, out.str().find("Grouped (2 streams): 32 bytes read"));
+    EXPECT_NE(std::string::npos, out.str().find("read=2"));
+
+    Stream::StreamStatisticsRegistry::Reset();
+    EXPECT_TRUE(Stream::StreamStatisticsRegistry::GetAll().empty());
+}
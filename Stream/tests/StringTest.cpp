@@ -0,0 +1,42 @@
+#include <gtest/gtest.h>
+#include <Stream/MemoryDataStream.hpp>
+
+TEST(String, ReadString) {
+    std::string withNul("name\0suffix", 11);
+    auto writeStream = Stream::MemoryWriteStream::Growable();
+    writeStream->writeString("");
+    writeStream->writeString("Material");
+    writeStream->writeString(withNul);
+    writeStream->writeFixedString("fixed", 16);
+    writeStream->writeFixedString("exactly 16 chars", 16);
+    auto buffer = writeStream->releaseBuffer();
+
+    auto readStream = Stream::MemoryReadStream::CopyOf(buffer.data(), buffer.size());
+    EXPECT_EQ("", readStream->readString());
+    EXPECT_EQ("Material", readStream->readString());
+    EXPECT_EQ(withNul, readStream->readString());
+    EXPECT_EQ("fixed", readStream->readFixedString(16));
+    EXPECT_EQ("exactly 16 chars", readStream->readFixedString(16));
+    EXPECT_FALSE(readStream->hasRemaining());
+}
+
+TEST(String, ReadStringLongerThanStream) {
+    auto writeStream = Stream::MemoryWriteStream::Growable();
+    writeStream->writeUint64(1000);
+    writeStream->writeBuffer(reinterpret_cast<const uint8_t *>("short"), 5);
+    auto buffer = writeStream->releaseBuffer();
+
+    auto readStream = Stream::MemoryReadStream::CopyOf(buffer.data(), buffer.size());
+    EXPECT_THROW(readStream->readString(), Stream::StreamUnderflowException);
+}
+
+TEST(String, ReadStringWithWrappingLength) {
+    auto writeStream = Stream::MemoryWriteStream::Growable();
+    // Position + length wraps around to a value below the stream size
+    writeStream->writeUint64(UINT64_MAX - 7);
+    writeStream->writeBuffer(reinterpret_cast<const uint8_t *>("short"), 5);
+    auto buffer = writeStream->releaseBuffer();
+
+    auto readStream = Stream::MemoryReadStream::CopyOf(buffer.data(), buffer.size());
+    EXPECT_THROW(readStream->readString(), Stream::StreamUnderflowException);
+}
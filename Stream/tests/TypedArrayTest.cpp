@@ -0,0 +1,67 @@
+#include <gtest/gtest.h>
+#include <Stream/MemoryDataStream.hpp>
+
+// Odd counts, so that the values don't fill the vector registers evenly
+static const size_t nValues = 1037;
+
+TEST(TypedArray, Uint16ArrayMatchesSingleValues) {
+    std::vector<uint16_t> values(nValues);
+    for (size_t i = 0; i < nValues; i++) {
+        values[i] = static_cast<uint16_t>(i * 4099);
+    }
+    auto writeStream = Stream::MemoryWriteStream::Growable();
+    writeStream->writeUint16Array(values.data(), values.size());
+    std::vector<uint8_t> buffer = writeStream->releaseBuffer();
+    ASSERT_EQ(nValues * sizeof(uint16_t), buffer.size());
+
+    auto readStream = Stream::MemoryReadStream::CopyOf(buffer.data(), buffer.size());
+    for (size_t i = 0; i < nValues; i++) {
+        ASSERT_EQ(values[i], readStream->readUint16());
+    }
+
+    std::vector<uint16_t> readValues(nValues);
+    readStream->seek(0);
+    readStream->readUint16Array(readValues.data(), readValues.size());
+    EXPECT_EQ(values, readValues);
+}
+
+TEST(TypedArray, Uint32ArrayMatchesSingleValues) {
+    std::vector<uint32_t> values(nValues);
+    for (size_t i = 0; i < nValues; i++) {
+        values[i] = static_cast<uint32_t>(i * 2654435761u);
+    }
+    auto writeStream = Stream::MemoryWriteStream::Growable();
+    for (uint32_t value: values) {
+        writeStream->writeUint32(value);
+    }
+    std::vector<uint8_t> buffer = writeStream->releaseBuffer();
+
+    auto readStream = Stream::MemoryReadStream::CopyOf(buffer.data(), buffer.size());
+    std::vector<uint32_t> readValues(nValues);
+    readStream->readUint32Array(readValues.data(), readValues.size());
+    EXPECT_EQ(values, readValues);
+    EXPECT_FALSE(readStream->hasRemaining());
+}
+
+TEST(TypedArray, Float32ArrayRoundTrip) {
+    std::vector<float> values(nValues);
+    for (size_t i = 0; i < nValues; i++) {
+        values[i] = static_cast<float>(i) * 0.25f - 100.0f;
+    }
+    auto writeStream = Stream::MemoryWriteStream::Growable();
+    writeStream->writeFloat32Array(values.data(), values.size());
+    std::vector<uint8_t> buffer = writeStream->releaseBuffer();
+
+    auto readStream = Stream::MemoryReadStream::CopyOf(buffer.data(), buffer.size());
+    EXPECT_EQ(values[0], readStream->readFloat32());
+    std::vector<float> readValues(nValues - 1);
+    readStream->readFloat32Array(readValues.data(), readValues.size());
+    EXPECT_EQ(std::vector<float>(values.begin() + 1, values.end()), readValues);
+}
+
+TEST(TypedArray, ReadPastEnd) {
+    const uint8_t memory[6]{};
+    auto readStream = Stream::MemoryReadStream::CopyOf(memory, sizeof(memory));
+    uint32_t values[2];
+    EXPECT_THROW(readStream->readUint32Array(values, 2), Stream::StreamUnderflowException);
+}
@@ -0,0 +1,36 @@
+#include <gtest/gtest.h>
+#include <Stream/Xxh3.hpp>
+#include <vector>
+
+// Expected values computed with xxHash's XXH3_64bits
+TEST(Xxh3, MatchesReferenceHashes) {
+    EXPECT_EQ(0x2d06800538d394c2ULL, Stream::Xxh3::Hash(nullptr, 0));
+    EXPECT_EQ(0xd0ba7f069b52c4daULL, Stream::Xxh3::Hash(reinterpret_cast<const uint8_t *>("Dyngine"), 7));
+
+    std::vector<uint8_t> data(10000);
+    for (size_t i = 0; i < data.size(); i++) {
+        data[i] = static_cast<uint8_t>(i * 7 % 251);
+    }
+    // One length per code path: up to 128, up to 240, and the long hash with and without a full block
+    EXPECT_EQ(0x1023ae92e631eac5ULL, Stream::Xxh3::Hash(data.data(), 100));
+    EXPECT_EQ(0xd12016b53c9565baULL, Stream::Xxh3::Hash(data.data(), 200));
+    EXPECT_EQ(0xd1eb8367bf3294e7ULL, Stream::Xxh3::Hash(data.data(), 1000));
+    EXPECT_EQ(0x436bab56c0b548eaULL, Stream::Xxh3::Hash(data.data(), 10000));
+}
+
+TEST(Xxh3, UpdateInPiecesMatchesHash) {
+    std::vector<uint8_t> data(5000);
+    for (size_t i = 0; i < data.size(); i++) {
+        data[i] = static_cast<uint8_t>(i * 2654435761U >> 13);
+    }
+    for (size_t length: {0, 3, 16, 128, 240, 241, 256, 257, 1024, 1025, 5000}) {
+        for (size_t pieceSize: {1, 63, 64, 255, 256, 257, 1000}) {
+            Stream::Xxh3 hash;
+            for (size_t offset = 0; offset < length; offset += pieceSize) {
+                hash.update(data.data() + offset, std::min(pieceSize, length - offset));
+            }
+            EXPECT_EQ(Stream::Xxh3::Hash(data.data(), length), hash.digest())
+                                << "length " << length << ", pieces of " << pieceSize;
+        }
+    }
+}
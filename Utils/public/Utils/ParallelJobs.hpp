@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+
+namespace ParallelJobs {
+
+    /**
+     * Runs independent jobs on all cores and returns once all of them are done.
+     * Workers take the next job until all are taken, so a few long jobs don't hold up the rest.
+     * The calling thread is one of the workers, the others are a pool created on first use and shared by all calls.
+     * May be called from several threads at once and from within jobs.
+     * @param job called once with each index from 0 to nJobs - 1
+     * @throws the first exception a job raised, after all jobs are done
+     */
+    void Run(size_t nJobs, const std::function<void(size_t)> &job);
+
+}
@@ -0,0 +1,134 @@
+#include <Utils/ParallelJobs.hpp>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// The jobs of one call of Run, shared by the caller and the workers helping with it
+struct JobBatch {
+    size_t nJobs;
+    const std::function<void(size_t)> &job;
+    std::atomic<size_t> nextJob{0};
+    std::atomic<size_t> nFinishedJobs{0};
+    std::exception_ptr exception;
+    std::mutex mutex;
+    std::condition_variable finished;
+
+    JobBatch(size_t nJobs, const std::function<void(size_t)> &job) : nJobs(nJobs), job(job) {
+    }
+
+    [[nodiscard]] bool isExhausted() const {
+        return nextJob.load() >= nJobs;
+    }
+
+    // Takes jobs until all are taken. Workers may still hold the batch after Run returned, but never call the job then.
+    void work() {
+        for (size_t i = nextJob++; i < nJobs; i = nextJob++) {
+            try {
+                job(i);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (!exception) {
+                    exception = std::current_exception();
+                }
+            }
+            if (++nFinishedJobs == nJobs) {
+                std::lock_guard<std::mutex> lock(mutex);
+                finished.notify_all();
+            }
+        }
+    }
+
+    void waitUntilFinished() {
+        std::unique_lock<std::mutex> lock(mutex);
+        finished.wait(lock, [this]() { return nFinishedJobs.load() == nJobs; });
+    }
+};
+
+// Workers live as long as the process, so that calls of Run don't pay for creating threads.
+// Batches are queued, so that Run may be called from several threads and from within jobs.
+class JobPool {
+
+private:
+    std::mutex mutex;
+    std::condition_variable batchQueued;
+    std::deque<std::shared_ptr<JobBatch>> batches;
+    std::vector<std::thread> workers;
+    bool stopping = false;
+
+    // Returns the oldest batch with jobs left, or nullptr once the pool is stopped
+    std::shared_ptr<JobBatch> takeBatch() {
+        std::unique_lock<std::mutex> lock(mutex);
+        batchQueued.wait(lock, [this]() {
+            while (!batches.empty() && batches.front()->isExhausted()) {
+                batches.pop_front();
+            }
+            return stopping || !batches.empty();
+        });
+        return stopping ? nullptr : batches.front();
+    }
+
+    void runWorker() {
+        while (auto batch = takeBatch()) {
+            batch->work();
+        }
+    }
+
+public:
+    explicit JobPool(size_t nWorkers) {
+        for (size_t i = 0; i < nWorkers; i++) {
+            workers.emplace_back(&JobPool::runWorker, this);
+        }
+    }
+
+    ~JobPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        batchQueued.notify_all();
+        for (auto &worker: workers) {
+            worker.join();
+        }
+    }
+
+    [[nodiscard]] size_t getWorkerCount() const {
+        return workers.size();
+    }
+
+    void queue(const std::shared_ptr<JobBatch> &batch) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            batches.push_back(batch);
+        }
+        batchQueued.notify_all();
+    }
+
+    static JobPool &Get() {
+        // The calling thread is a worker as well
+        static JobPool pool(std::max(std::thread::hardware_concurrency(), 1u) - 1);
+        return pool;
+    }
+};
+
+void ParallelJobs::Run(size_t nJobs, const std::function<void(size_t)> &job) {
+    if (nJobs == 0) {
+        return;
+    }
+    auto batch = std::make_shared<JobBatch>(nJobs, job);
+    auto &pool = JobPool::Get();
+    if (nJobs > 1 && pool.getWorkerCount() > 0) {
+        pool.queue(batch);
+    }
+    // The caller takes jobs as well, so jobs which call Run themselves never wait for a busy pool
+    batch->work();
+    batch->waitUntilFinished();
+    if (batch->exception) {
+        std::rethrow_exception(batch->exception);
+    }
+}
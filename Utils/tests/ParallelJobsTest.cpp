@@ -0,0 +1,62 @@
+#include <gtest/gtest.h>
+#include <Utils/ParallelJobs.hpp>
+#include <ErrorHandling/IllegalStateException.hpp>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+TEST(ParallelJobs, EachJobRunsOnce) {
+    std::vector<std::atomic<int>> runs(1000);
+    ParallelJobs::Run(runs.size(), [&](size_t i) {
+        runs[i]++;
+    });
+    for (auto &run: runs) {
+        EXPECT_EQ(1, run.load());
+    }
+    ParallelJobs::Run(0, [](size_t) {
+        FAIL();
+    });
+}
+
+TEST(ParallelJobs, ExceptionsAreRaisedAfterAllJobs) {
+    std::atomic<int> finishedJobs{0};
+    EXPECT_THROW(ParallelJobs::Run(100, [&](size_t i) {
+        if (i == 3) {
+            RAISE_EXCEPTION(errorhandling::IllegalStateException, "Job failed");
+        }
+        finishedJobs++;
+    }), errorhandling::IllegalStateException);
+    EXPECT_EQ(99, finishedJobs.load());
+}
+
+TEST(ParallelJobs, JobsMayRunJobs) {
+    std::vector<std::atomic<int>> runs(64 * 64);
+    ParallelJobs::Run(64, [&](size_t i) {
+        ParallelJobs::Run(64, [&](size_t j) {
+            runs[i * 64 + j]++;
+        });
+    });
+    for (auto &run: runs) {
+        EXPECT_EQ(1, run.load());
+    }
+}
+
+TEST(ParallelJobs, RunsFromSeveralThreads) {
+    std::vector<std::atomic<int>> runs(4 * 1000);
+    std::vector<std::thread> callers;
+    for (size_t caller = 0; caller < 4; caller++) {
+        callers.emplace_back([&runs, caller]() {
+            for (size_t repetition = 0; repetition < 10; repetition++) {
+                ParallelJobs::Run(1000, [&runs, caller](size_t i) {
+                    runs[caller * 1000 + i]++;
+                });
+            }
+        });
+    }
+    for (auto &caller: callers) {
+        caller.join();
+    }
+    for (auto &run: runs) {
+        EXPECT_EQ(10, run.load());
+    }
+}